@@ -43,15 +43,32 @@ WHY SINGLE FILE?
 #include <ctime>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
 #include <queue>
+#include <deque>
 #include <set>
 #include <algorithm>
+#include <numeric>
 #include <fstream>
 #include <sstream>
 #include <regex>
 #include <stdexcept>
 #include <memory>
+#include <functional>
 #include <random>
+#include <tuple>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <filesystem>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
@@ -76,6 +93,7 @@ void feedbackMenu();
 void algorithmDemoMenu();
 void runSystemDemo();
 void displayCompleteSystemData();
+void benchmarkMenu();
 
 enum class ErrorCode {
     SUCCESS = 0,
@@ -197,6 +215,40 @@ inline string orderStateToString(OrderState state) {
     }
 }
 
+enum class MembershipTierLevel : uint8_t { BRONZE, SILVER, GOLD, PLATINUM };
+
+// Tier rules indexed by MembershipTierLevel: points needed and checkout discount
+struct TierRule {
+    int minPoints;
+    double discount;
+    const char* name;
+};
+
+constexpr TierRule TIER_TABLE[] = {
+    {0,    0.05, "Bronze"},
+    {1000, 0.10, "Silver"},
+    {3000, 0.15, "Gold"},
+    {5000, 0.20, "Platinum"}
+};
+
+// Highest tier whose threshold is met; a sum of comparisons, so no branches
+constexpr uint8_t tierIndexForPoints(int points) {
+    return static_cast<uint8_t>((points >= TIER_TABLE[1].minPoints) +
+                                (points >= TIER_TABLE[2].minPoints) +
+                                (points >= TIER_TABLE[3].minPoints));
+}
+
+inline string tierToString(MembershipTierLevel tier) {
+    return TIER_TABLE[static_cast<int>(tier)].name;
+}
+
+inline MembershipTierLevel tierFromString(const string& name) {
+    for (int i = 0; i < 4; i++) {
+        if (name == TIER_TABLE[i].name) return static_cast<MembershipTierLevel>(i);
+    }
+    return MembershipTierLevel::BRONZE;
+}
+
 struct Customer
 {
     int id;
@@ -204,7 +256,7 @@ struct Customer
     string phone;
     string email;
     int loyaltyPoints;
-    string membershipTier; // Bronze, Silver, Gold, Platinum
+    MembershipTierLevel membershipTier;
 };
 
 struct MenuItem
@@ -238,7 +290,7 @@ struct Order
 namespace DataStructures {
 
 // Caching System
-template <typename Key, typename Value>
+template <typename Key, typename Value, typename Hash = hash<Key>>
 class LRUCache {
 private:
     struct Node {
@@ -248,28 +300,51 @@ private:
         Node* next;
         Node(Key k, Value v) : key(k), value(v), prev(nullptr), next(nullptr) {}
     };
-    map<Key, Node*> cacheMap;
+    unordered_map<Key, Node*, Hash> cacheMap;
     Node* head;
     Node* tail;
     int capacity;
 public:
-    LRUCache(int cap) : capacity(cap) {
+    LRUCache(int cap) : capacity(max(1, cap)) {
         head = new Node(Key(), Value());
         tail = new Node(Key(), Value());
         head->next = tail;
         tail->prev = head;
     }
+
+    // Owns raw nodes: copying would double-free them
+    LRUCache(const LRUCache&) = delete;
+    LRUCache& operator=(const LRUCache&) = delete;
+
+    ~LRUCache() {
+        // Cleanup all nodes
+        Node* curr = head->next;
+        while (curr != tail) {
+            Node* tmp = curr;
+            curr = curr->next;
+            delete tmp;
+        }
+        delete head;
+        delete tail;
+    }
+
     // PUT FUNCTION: Inserts or updates a key-value pair in the LRU cache
     // HOW IT WORKS:
-    // 1. If key already exists, remove the old node (to refresh position)
+    // 1. If key already exists, overwrite its value and move it to the head
     // 2. If cache is at capacity, evict the least recently used item (tail->prev)
     // 3. Create new node and add to head (most recently used position)
     // 4. Update map to point to the new node
-    // Time Complexity: O(1)
-    void put(Key key, Value value) {
-        if (cacheMap.count(key)) {
-            removeNode(cacheMap[key]);
-        } else if (cacheMap.size() >= capacity) {
+    // Time Complexity: O(1) average
+    void put(const Key& key, const Value& value) {
+        auto it = cacheMap.find(key);
+        if (it != cacheMap.end()) {
+            it->second->value = value;
+            unlink(it->second);
+            addToHead(it->second);
+            return;
+        }
+        if (static_cast<int>(cacheMap.size()) >= capacity) {
+            evictions++;
             removeNode(tail->prev);
         }
         Node* newNode = new Node(key, value);
@@ -279,1102 +354,6725 @@ public:
     // GET FUNCTION: Retrieves a value from cache and marks it as recently used
     // HOW IT WORKS:
     // 1. Check if key exists in cache map
-    // 2. If found, move it to head (most recently used position)
+    // 2. If found, move it to head (most recently used position); the node
+    //    is only relinked, never freed, so the value stays valid
     // 3. Return the value
     // 4. If not found, return false
-    // Time Complexity: O(1)
-    bool get(Key key, Value& value) {
-        if (!cacheMap.count(key)) return false;
-        Node* node = cacheMap[key];
-        removeNode(node);
+    // Time Complexity: O(1) average
+    bool get(const Key& key, Value& value) {
+        auto it = cacheMap.find(key);
+        if (it == cacheMap.end()) return false;
+        Node* node = it->second;
+        unlink(node);
         addToHead(node);
         value = node->value;
         return true;
     }
+
+    bool erase(const Key& key) {
+        auto it = cacheMap.find(key);
+        if (it == cacheMap.end()) return false;
+        removeNode(it->second);
+        return true;
+    }
+
+    void clear() {
+        while (head->next != tail) removeNode(head->next);
+    }
+
+    int size() const { return static_cast<int>(cacheMap.size()); }
+    int maxSize() const { return capacity; }
+    long long evictionCount() const { return evictions; }
+
 private:
+    long long evictions = 0;
+
     void addToHead(Node* node) {
         node->next = head->next;
         node->prev = head;
         head->next->prev = node;
         head->next = node;
     }
-    void removeNode(Node* node) {
-        if (!node) return;
-        // 1. Unlink from DLL
+    void unlink(Node* node) {
         node->prev->next = node->next;
         node->next->prev = node->prev;
-        
+    }
+    void removeNode(Node* node) {
+        if (!node || node == head || node == tail) return;
+        // 1. Unlink from DLL
+        unlink(node);
+
         // 2. CRITICAL: Remove from map first to prevent dangling pointer!
         cacheMap.erase(node->key);
-        
+
         // 3. Free memory
         delete node;
     }
-    
-    ~LRUCache() {
-        // Cleanup all nodes
-        Node* curr = head->next;
-        while (curr != tail) {
-            Node* tmp = curr;
-            curr = curr->next;
-            delete tmp;
-        }
-        delete head;
-        delete tail;
-        cacheMap.clear();
-    }
 };
 
-} // namespace DataStructures
+// Compressed Radix Trie for prefix autocomplete
+// Each edge carries a multi-character label (single-child chains are merged),
+// and every node caches the best score found anywhere in its subtree so that
+// top-k completions can be produced best-first without visiting every match.
+class RadixTrie {
+private:
+    struct Entry {
+        int id;
+        int score;
+    };
+    struct Node {
+        string label;          // edge label leading into this node
+        vector<int> children;  // child node indices
+        vector<Entry> entries; // ids whose key terminates here
+        int bestScore;         // max score in this subtree
+        int parent;
+    };
+    vector<Node> nodes;
+    unordered_map<int, int> idToNode;
 
-// =============================================================
-// NAMESPACE: ALGORITHMS (Standalone algorithm library)
-// Missing algorithms added for completeness
-// =============================================================
-namespace Algorithms {
+    static string normalize(const string& key) {
+        string out = key;
+        for (char& c : out) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+        return out;
+    }
 
-// ---------- Binary Search (iterative) ----------
-// Returns index of target in sorted vector, else -1
-// BINARY SEARCH FUNCTION: Finds element in sorted array using divide-and-conquer
-// HOW IT WORKS:
-// 1. Initialize left=0, right=size-1
-// 2. While left <= right:
-//    a. Calculate mid point
-//    b. If arr[mid] == target: found, return index
-//    c. If arr[mid] < target: search right half (left = mid + 1)
-//    d. If arr[mid] > target: search left half (right = mid - 1)
-// 3. If not found, return -1
-// ALGORITHM: Binary Search (requires sorted array)
-// TIME COMPLEXITY: O(log n) - halves search space each iteration
-// CONSTRAINTS: Input array must be sorted
-// USE CASE: Find menu item ID, order ID, or customer ID in sorted lists
-int binarySearch(const vector<int>& arr, int target) {
-    int l = 0, r = static_cast<int>(arr.size()) - 1;
-    while (l <= r) {
-        int mid = l + (r - l) / 2;
-        if (arr[mid] == target) return mid;
-        if (arr[mid] < target) l = mid + 1; else r = mid - 1;
+    int newNode(const string& label, int parent) {
+        nodes.push_back({label, {}, {}, numeric_limits<int>::min(), parent});
+        return static_cast<int>(nodes.size()) - 1;
     }
-    return -1;
-}
 
-// ---------- Merge Sort (stable) ----------
-void merge(vector<int>& a, int l, int m, int r) {
-    vector<int> left(a.begin() + l, a.begin() + m + 1);
-    vector<int> right(a.begin() + m + 1, a.begin() + r + 1);
-    int i = 0, j = 0, k = l;
-    while (i < static_cast<int>(left.size()) && j < static_cast<int>(right.size())) {
-        if (left[i] <= right[j]) a[k++] = left[i++]; else a[k++] = right[j++];
+    int findChild(int node, char c) const {
+        for (int child : nodes[node].children) {
+            if (nodes[child].label[0] == c) return child;
+        }
+        return -1;
     }
-    while (i < static_cast<int>(left.size())) a[k++] = left[i++];
-    while (j < static_cast<int>(right.size())) a[k++] = right[j++];
-}
 
-void mergeSortRec(vector<int>& a, int l, int r) {
-    if (l >= r) return;
-    int m = l + (r - l) / 2;
-    mergeSortRec(a, l, m);
-    mergeSortRec(a, m + 1, r);
-    merge(a, l, m, r);
-}
+    void recomputeBest(int node) {
+        while (node != -1) {
+            int best = numeric_limits<int>::min();
+            for (const Entry& e : nodes[node].entries) best = max(best, e.score);
+            for (int child : nodes[node].children) best = max(best, nodes[child].bestScore);
+            if (best == nodes[node].bestScore) return;
+            nodes[node].bestScore = best;
+            node = nodes[node].parent;
+        }
+    }
 
-// MERGE SORT FUNCTION: Stable sorting algorithm that divides array and merges
-// HOW IT WORKS:
-// 1. Divide: Recursively split array into halves until size = 1
-// 2. Conquer: Merge pairs of sorted subarrays:
-//    - Create left and right subarrays
-//    - Compare elements from both and place smaller one in main array
-//    - Copy remaining elements from left/right
-// 3. Result: Sorted array with stable ordering
-// ALGORITHM: Divide-and-Conquer sorting
-// TIME COMPLEXITY: O(n log n) - guaranteed for all cases
-// SPACE COMPLEXITY: O(n) - requires temporary arrays
-// USE CASE: Sorting menu items, orders, or customer lists when stability matters
-void mergeSort(vector<int>& a) {
-    if (!a.empty()) mergeSortRec(a, 0, static_cast<int>(a.size()) - 1);
-}
+public:
+    struct Completion {
+        int id;
+        int score;
+    };
 
-// ---------- Quick Sort (in-place, Lomuto) ----------
-int partition(vector<int>& a, int l, int r) {
-    int pivot = a[r];
-    int i = l;
-    for (int j = l; j < r; ++j) {
-        if (a[j] <= pivot) {
-            swap(a[i], a[j]);
-            ++i;
+    RadixTrie() { clear(); }
+
+    void clear() {
+        nodes.clear();
+        idToNode.clear();
+        newNode("", -1);
+    }
+
+    int size() const { return static_cast<int>(idToNode.size()); }
+
+    // INSERT FUNCTION: Adds a key with an id and ranking score
+    // HOW IT WORKS:
+    // 1. Walk edges matching the longest common prefix of the remaining key
+    // 2. If the key diverges inside an edge label, split that edge in two
+    // 3. Append the remaining suffix as a new leaf (or stop at an existing node)
+    // 4. Record the entry and push the new score up the parent chain
+    // TIME COMPLEXITY: O(L * alphabet) where L is key length
+    void insert(const string& rawKey, int id, int score) {
+        if (idToNode.count(id)) {
+            updateScore(id, score);
+            return;
+        }
+        string key = normalize(rawKey);
+        int node = 0;
+        size_t pos = 0;
+        while (pos < key.size()) {
+            int child = findChild(node, key[pos]);
+            if (child == -1) {
+                int leaf = newNode(key.substr(pos), node);
+                nodes[node].children.push_back(leaf);
+                node = leaf;
+                pos = key.size();
+                break;
+            }
+            const string& label = nodes[child].label;
+            size_t common = 0;
+            while (common < label.size() && pos + common < key.size() && label[common] == key[pos + common]) {
+                common++;
+            }
+            if (common < label.size()) {
+                // Split: node -> mid(label[0..common)) -> child(label[common..])
+                int mid = newNode(label.substr(0, common), node);
+                Node& c = nodes[child];
+                c.label = c.label.substr(common);
+                c.parent = mid;
+                nodes[mid].children.push_back(child);
+                nodes[mid].bestScore = c.bestScore;
+                replace(nodes[node].children.begin(), nodes[node].children.end(), child, mid);
+                child = mid;
+            }
+            pos += common;
+            node = child;
+        }
+        nodes[node].entries.push_back({id, score});
+        idToNode[id] = node;
+        for (int n = node; n != -1 && nodes[n].bestScore < score; n = nodes[n].parent) {
+            nodes[n].bestScore = score;
         }
     }
-    swap(a[i], a[r]);
-    return i;
-}
 
-void quickSortRec(vector<int>& a, int l, int r) {
-    if (l < r) {
-        int p = partition(a, l, r);
-        quickSortRec(a, l, p - 1);
-        quickSortRec(a, p + 1, r);
+    // UPDATE SCORE FUNCTION: Re-ranks an existing id (e.g. new loyalty points)
+    // TIME COMPLEXITY: O(depth * fanout) - only the path to the root is touched
+    void updateScore(int id, int score) {
+        auto it = idToNode.find(id);
+        if (it == idToNode.end()) return;
+        for (Entry& e : nodes[it->second].entries) {
+            if (e.id == id) e.score = score;
+        }
+        recomputeBest(it->second);
     }
-}
 
-// QUICK SORT FUNCTION: Fast in-place sorting using pivot partitioning
-// HOW IT WORKS:
-// 1. Choose pivot (rightmost element)
-// 2. Partition: Place all elements < pivot left, >= pivot right
-// 3. Recursively sort left and right partitions
-// 4. Result: Sorted array with elements in correct positions
-// ALGORITHM: Divide-and-Conquer with Lomuto partitioning
-// TIME COMPLEXITY: O(n log n) average, O(n²) worst case
-// SPACE COMPLEXITY: O(log n) - recursion stack
-// USE CASE: Sorting orders by price, customers by points, menu by price
-void quickSort(vector<int>& a) {
-    if (!a.empty()) quickSortRec(a, 0, static_cast<int>(a.size()) - 1);
-}
+    // TOP-K COMPLETIONS FUNCTION: Returns best-scoring ids whose key starts with prefix
+    // HOW IT WORKS:
+    // 1. Descend to the node covering the prefix (prefix may end mid-label)
+    // 2. Best-first search with a max-heap keyed by subtree bestScore:
+    //    - Popping a node pushes its entries and children
+    //    - Popping an entry emits it (entries come out in exact score order)
+    // 3. Stop after k results or after nodeBudget expansions (latency cap)
+    // ALGORITHM: Best-first branch-and-bound over a radix trie
+    // TIME COMPLEXITY: O(|prefix| + (k + budget) log(k + budget)) - independent of match count
+    // USE CASE: POS autocomplete for customer and dish names
+    vector<Completion> topK(const string& rawPrefix, int k, int nodeBudget = 256) const {
+        vector<Completion> results;
+        string prefix = normalize(rawPrefix);
+        int node = 0;
+        size_t pos = 0;
+        while (pos < prefix.size()) {
+            int child = findChild(node, prefix[pos]);
+            if (child == -1) return results;
+            const string& label = nodes[child].label;
+            size_t n = min(label.size(), prefix.size() - pos);
+            if (label.compare(0, n, prefix, pos, n) != 0) return results;
+            pos += n;
+            node = child;
+        }
 
-// ---------- Heap Sort (in-place) ----------
-void heapify(vector<int>& a, int n, int i) {
-    int largest = i;
-    int l = 2 * i + 1;
-    int r = 2 * i + 2;
-    if (l < n && a[l] > a[largest]) largest = l;
-    if (r < n && a[r] > a[largest]) largest = r;
-    if (largest != i) {
-        swap(a[i], a[largest]);
-        heapify(a, n, largest);
+        // (score, isEntry, index) - entries win ties so equal scores emit early
+        priority_queue<tuple<int, int, int>> frontier;
+        frontier.push(make_tuple(nodes[node].bestScore, 0, node));
+        int expanded = 0;
+        while (!frontier.empty() && static_cast<int>(results.size()) < k) {
+            auto [score, isEntry, idx] = frontier.top();
+            frontier.pop();
+            if (isEntry) {
+                results.push_back({idx, score});
+                continue;
+            }
+            if (expanded++ >= nodeBudget) break;
+            for (const Entry& e : nodes[idx].entries) frontier.push(make_tuple(e.score, 1, e.id));
+            for (int child : nodes[idx].children) frontier.push(make_tuple(nodes[child].bestScore, 0, child));
+        }
+        return results;
     }
-}
+};
 
-// HEAP SORT FUNCTION: Builds max-heap then repeatedly extracts max element
-// HOW IT WORKS:
-// 1. Build max-heap: Heapify from bottom-up starting at parent of last element
-// 2. For i from n-1 down to 1:
-//    a. Swap root (max) with element at position i
-//    b. Reduce heap size and heapify from root to maintain heap property
-// 3. Result: Sorted array with largest elements at end
-// ALGORITHM: Heap construction + extraction using heapify operations
-// TIME COMPLEXITY: O(n log n) - guaranteed for all cases
-// SPACE COMPLEXITY: O(1) - in-place sorting
-// USE CASE: Sorting when guaranteed O(n log n) performance critical
-void heapSort(vector<int>& a) {
-    int n = static_cast<int>(a.size());
-    for (int i = n / 2 - 1; i >= 0; --i) heapify(a, n, i);
-    for (int i = n - 1; i > 0; --i) {
-        swap(a[0], a[i]);
-        heapify(a, i, 0);
+// FM-Index (suffix array + Burrows-Wheeler transform) for substring search
+// Text is stored only as its BWT with sampled rank checkpoints and a sampled
+// suffix array, so memory stays close to the corpus size while count()
+// runs in O(pattern length) regardless of how large the corpus grows.
+class FMIndex {
+private:
+    static const int OCC_BLOCK = 64;   // rank checkpoint spacing
+    static const int SA_SAMPLE = 32;   // suffix array sampling rate
+    vector<uint8_t> bwt;               // BWT over dense alphabet codes
+    vector<uint32_t> occ;              // occ[block * sigma + c]
+    vector<int> charCode;              // byte -> dense code (-1 if absent)
+    vector<uint32_t> cumulative;       // C[c]: symbols smaller than c
+    vector<uint64_t> sampledBits;      // rows whose SA value is sampled
+    vector<uint32_t> sampledRank;      // popcount prefix per 64-bit word
+    vector<int> sampledSA;
+    int sigma = 0;
+    int n = 0;
+
+    // Prefix-doubling suffix sort of cyclic shifts (text ends in a unique 0 sentinel)
+    static vector<int> buildSuffixArray(const vector<int>& s, int alphabet) {
+        int len = static_cast<int>(s.size());
+        vector<int> sa(len), cls(len), cnt(max(alphabet, len), 0);
+        for (int i = 0; i < len; i++) cnt[s[i]]++;
+        for (int i = 1; i < alphabet; i++) cnt[i] += cnt[i - 1];
+        for (int i = 0; i < len; i++) sa[--cnt[s[i]]] = i;
+        cls[sa[0]] = 0;
+        int classes = 1;
+        for (int i = 1; i < len; i++) {
+            if (s[sa[i]] != s[sa[i - 1]]) classes++;
+            cls[sa[i]] = classes - 1;
+        }
+        vector<int> pn(len), cn(len);
+        for (int h = 0; (1 << h) < len && classes < len; h++) {
+            for (int i = 0; i < len; i++) {
+                pn[i] = sa[i] - (1 << h);
+                if (pn[i] < 0) pn[i] += len;
+            }
+            fill(cnt.begin(), cnt.begin() + classes, 0);
+            for (int i = 0; i < len; i++) cnt[cls[pn[i]]]++;
+            for (int i = 1; i < classes; i++) cnt[i] += cnt[i - 1];
+            for (int i = len - 1; i >= 0; i--) sa[--cnt[cls[pn[i]]]] = pn[i];
+            cn[sa[0]] = 0;
+            classes = 1;
+            for (int i = 1; i < len; i++) {
+                int a = sa[i], b = sa[i - 1];
+                if (cls[a] != cls[b] || cls[(a + (1 << h)) % len] != cls[(b + (1 << h)) % len]) classes++;
+                cn[sa[i]] = classes - 1;
+            }
+            cls.swap(cn);
+        }
+        return sa;
     }
-}
 
-// ---------- KMP String Search ----------
-// KMP PREFIX TABLE FUNCTION: Builds lookup table for pattern failures
-// HOW IT WORKS:
-// 1. lps[i] = length of longest proper prefix that is also suffix of pattern[0..i]
-// 2. For each position, compare pattern[i] with pattern[len]:
-//    - If match: increment len and set lps[i] = len
-//    - If mismatch: use previous lps values to jump back (no redundant checks)
-// 3. Result: Table enabling O(n) pattern search without backtracking
-// ALGORITHM: KMP (Knuth-Morris-Pratt) preprocessing
-// TIME COMPLEXITY: O(m) where m is pattern length
-// USE CASE: Build efficiency table for fast string searching
-vector<int> kmpPrefix(const string& pat) {
-    vector<int> lps(pat.size(), 0);
-    for (size_t i = 1, len = 0; i < pat.size(); ) {
-        if (pat[i] == pat[len]) lps[i++] = static_cast<int>(++len);
-        else if (len) len = lps[len - 1];
-        else lps[i++] = 0;
+    uint32_t rank(int c, int row) const {
+        int block = row / OCC_BLOCK;
+        uint32_t r = occ[static_cast<size_t>(block) * sigma + c];
+        for (int i = block * OCC_BLOCK; i < row; i++) r += (bwt[i] == c);
+        return r;
     }
-    return lps;
-}
 
-// KMP STRING SEARCH FUNCTION: Finds all occurrences of pattern in text efficiently
-// HOW IT WORKS:
-// 1. Build prefix table using kmpPrefix (knows where failures occur)
-// 2. Compare text and pattern character by character:
-//    - If match: advance both pointers
-//    - When pattern complete: record position and use prefix table to continue searching
-//    - If mismatch: use prefix table to avoid redundant comparisons
-// 3. Result: List of all starting positions where pattern found
-// ALGORITHM: KMP (Knuth-Morris-Pratt) string matching
-// TIME COMPLEXITY: O(n + m) - linear with no backtracking
-// USE CASE: Search for menu item names, customer names in large text
-vector<int> kmpSearch(const string& text, const string& pat) {
-    vector<int> res;
-    if (pat.empty()) return res;
-    auto lps = kmpPrefix(pat);
-    for (size_t i = 0, j = 0; i < text.size(); ) {
-        if (text[i] == pat[j]) { ++i; ++j; }
-        if (j == pat.size()) { res.push_back(static_cast<int>(i - j)); j = lps[j - 1]; }
-        else if (i < text.size() && text[i] != pat[j]) {
-            if (j) j = lps[j - 1]; else ++i;
-        }
+    bool isSampled(int row) const {
+        return (sampledBits[row >> 6] >> (row & 63)) & 1;
     }
-    return res;
-}
+
+    int sampledIndex(int row) const {
+        uint64_t mask = (row & 63) ? (sampledBits[row >> 6] & ((uint64_t(1) << (row & 63)) - 1)) : 0;
+        return static_cast<int>(sampledRank[row >> 6] + __builtin_popcountll(mask));
+    }
+
+    // Narrows [lo, hi) to the rows whose suffixes start with pattern
+    bool backwardSearch(const string& pattern, int& lo, int& hi) const {
+        lo = 0;
+        hi = n;
+        if (n == 0) return false;
+        for (int i = static_cast<int>(pattern.size()) - 1; i >= 0 && lo < hi; i--) {
+            int c = charCode[static_cast<unsigned char>(pattern[i])];
+            if (c <= 0) return false;
+            lo = static_cast<int>(cumulative[c] + rank(c, lo));
+            hi = static_cast<int>(cumulative[c] + rank(c, hi));
+        }
+        return lo < hi;
+    }
+
+public:
+    // BUILD FUNCTION: Constructs the index over text (must not contain '\0')
+    // HOW IT WORKS:
+    // 1. Map bytes to a dense alphabet; append a unique sentinel (code 0)
+    // 2. Suffix array by prefix doubling with counting sorts
+    // 3. BWT[i] = text[SA[i] - 1]; record rank checkpoints every 64 rows
+    // 4. Keep SA values only for text positions divisible by 32
+    // TIME COMPLEXITY: O(n log n) build, O(n) space
+    void build(const string& text) {
+        charCode.assign(256, -1);
+        vector<bool> present(256, false);
+        for (unsigned char c : text) present[c] = true;
+        sigma = 1;
+        for (int c = 1; c < 256; c++) {
+            if (present[c]) charCode[c] = sigma++;
+        }
+        n = static_cast<int>(text.size()) + 1;
+        vector<int> s(n);
+        for (int i = 0; i + 1 < n; i++) s[i] = charCode[static_cast<unsigned char>(text[i])];
+        s[n - 1] = 0;
+        vector<int> sa = buildSuffixArray(s, sigma);
+
+        bwt.resize(n);
+        for (int i = 0; i < n; i++) bwt[i] = static_cast<uint8_t>(s[(sa[i] + n - 1) % n]);
+
+        int blocks = n / OCC_BLOCK + 1;
+        occ.assign(static_cast<size_t>(blocks) * sigma, 0);
+        vector<uint32_t> running(sigma, 0);
+        cumulative.assign(sigma + 1, 0);
+        for (int i = 0; i < n; i++) {
+            if (i % OCC_BLOCK == 0) copy(running.begin(), running.end(), occ.begin() + static_cast<size_t>(i / OCC_BLOCK) * sigma);
+            running[bwt[i]]++;
+        }
+        if (n % OCC_BLOCK == 0) copy(running.begin(), running.end(), occ.begin() + static_cast<size_t>(n / OCC_BLOCK) * sigma);
+        for (int c = 0; c < sigma; c++) cumulative[c + 1] = cumulative[c] + running[c];
+
+        sampledBits.assign(n / 64 + 1, 0);
+        sampledSA.clear();
+        for (int i = 0; i < n; i++) {
+            if (sa[i] % SA_SAMPLE == 0) {
+                sampledBits[i >> 6] |= uint64_t(1) << (i & 63);
+                sampledSA.push_back(sa[i]);
+            }
+        }
+        sampledRank.assign(sampledBits.size(), 0);
+        for (size_t w = 1; w < sampledBits.size(); w++) {
+            sampledRank[w] = sampledRank[w - 1] + __builtin_popcountll(sampledBits[w - 1]);
+        }
+    }
+
+    // COUNT FUNCTION: Number of occurrences of pattern
+    // ALGORITHM: FM-index backward search
+    // TIME COMPLEXITY: O(m) rank queries - independent of corpus size
+    int count(const string& pattern) const {
+        int lo, hi;
+        return backwardSearch(pattern, lo, hi) ? hi - lo : 0;
+    }
+
+    // LOCATE FUNCTION: Text offsets of up to limit occurrences
+    // HOW IT WORKS: Walk LF-mapping from each matching row until a sampled
+    // suffix array entry is reached (at most SA_SAMPLE steps per hit)
+    // TIME COMPLEXITY: O(m + occ * SA_SAMPLE)
+    vector<int> locate(const string& pattern, int limit) const {
+        vector<int> positions;
+        int lo, hi;
+        if (!backwardSearch(pattern, lo, hi)) return positions;
+        for (int row = lo; row < hi && static_cast<int>(positions.size()) < limit; row++) {
+            int r = row, steps = 0;
+            while (!isSampled(r)) {
+                int c = bwt[r];
+                r = static_cast<int>(cumulative[c] + rank(c, r));
+                steps++;
+            }
+            positions.push_back(sampledSA[sampledIndex(r)] + steps);
+        }
+        return positions;
+    }
+
+    size_t memoryBytes() const {
+        return bwt.size() + occ.size() * 4 + sampledBits.size() * 8 + sampledRank.size() * 4 + sampledSA.size() * 4;
+    }
+};
+
+// Exact streaming Top-K under score updates
+// Keeps every key's current score, a bounded min-heap of the K best with a
+// key -> heap position index, and a reserve of up to K runners-up below the
+// cutoff. Keys in neither are covered by an upper bound on their scores.
+// When a heap member drops, the best runner-up takes its place; the heap is
+// only rebuilt from the score table (on the next query) if an untracked key
+// might now beat it, i.e. after more drops than the reserve could absorb.
+template <typename Key, typename Score>
+class TopKTracker {
+private:
+    int capacity;
+    unordered_map<Key, Score> scores;
+    vector<pair<Score, Key>> heap; // min-heap on score
+    unordered_map<Key, int> heapPos;
+    vector<pair<Score, Key>> reserve; // runners-up, ascending by score
+    bool untracked = false;           // some key is in neither heap nor reserve
+    Score untrackedMax = Score();     // upper bound on those keys' scores
+    bool stale = false;
+    long long rebuildCount = 0;
+
+    void place(int i) { heapPos[heap[i].second] = i; }
+
+    void siftUp(int i) {
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (!(heap[i].first < heap[parent].first)) break;
+            swap(heap[i], heap[parent]);
+            place(i);
+            i = parent;
+        }
+        place(i);
+    }
+
+    void siftDown(int i) {
+        int n = static_cast<int>(heap.size());
+        while (true) {
+            int smallest = i, l = 2 * i + 1, r = l + 1;
+            if (l < n && heap[l].first < heap[smallest].first) smallest = l;
+            if (r < n && heap[r].first < heap[smallest].first) smallest = r;
+            if (smallest == i) break;
+            swap(heap[i], heap[smallest]);
+            place(i);
+            i = smallest;
+        }
+        place(i);
+    }
+
+    void dropUntracked(Score score) {
+        untrackedMax = untracked ? max(untrackedMax, score) : score;
+        untracked = true;
+    }
+
+    // Files an outsider in the reserve, pushing the weakest runner-up out
+    // to the untracked bound when it is full
+    void keepInReserve(const pair<Score, Key>& entry) {
+        if (static_cast<int>(reserve.size()) >= capacity) {
+            if (!(reserve.front().first < entry.first)) {
+                dropUntracked(entry.first);
+                return;
+            }
+            dropUntracked(reserve.front().first);
+            reserve.erase(reserve.begin());
+        }
+        auto at = upper_bound(reserve.begin(), reserve.end(), entry,
+                              [](const pair<Score, Key>& a, const pair<Score, Key>& b) { return a.first < b.first; });
+        reserve.insert(at, entry);
+    }
+
+    // Moves the heap minimum to the reserve and `entry` in at the root
+    void replaceMin(const pair<Score, Key>& entry) {
+        heapPos.erase(heap[0].second);
+        pair<Score, Key> evicted = heap[0];
+        heap[0] = entry;
+        siftDown(0);
+        keepInReserve(evicted);
+    }
+
+    void rebuild() {
+        heap.clear();
+        heapPos.clear();
+        reserve.clear();
+        untracked = false;
+        // Best 2K keys in a min-heap; everything pushed out is untracked
+        vector<pair<Score, Key>> best;
+        auto lower = [](const pair<Score, Key>& a, const pair<Score, Key>& b) { return b.first < a.first; };
+        for (const auto& e : scores) {
+            if (static_cast<int>(best.size()) < 2 * capacity) {
+                best.push_back({e.second, e.first});
+                push_heap(best.begin(), best.end(), lower);
+            } else if (best.front().first < e.second) {
+                pop_heap(best.begin(), best.end(), lower);
+                dropUntracked(best.back().first);
+                best.back() = {e.second, e.first};
+                push_heap(best.begin(), best.end(), lower);
+            } else {
+                dropUntracked(e.second);
+            }
+        }
+        sort(best.begin(), best.end(), [](const pair<Score, Key>& a, const pair<Score, Key>& b) { return a.first < b.first; });
+        int split = max(0, static_cast<int>(best.size()) - capacity);
+        reserve.assign(best.begin(), best.begin() + split);
+        for (int i = split; i < static_cast<int>(best.size()); i++) {
+            heap.push_back(best[i]);
+            siftUp(static_cast<int>(heap.size()) - 1);
+        }
+        stale = false;
+        rebuildCount++;
+    }
+
+public:
+    explicit TopKTracker(int k) : capacity(k) {}
+
+    // UPDATE FUNCTION: Sets a key's score and maintains the top-K heap
+    // HOW IT WORKS:
+    // 1. Heap member: re-sift it; if it dropped below the best runner-up,
+    //    swap the heap minimum with it, and mark the heap stale only if the
+    //    untracked bound is higher still
+    // 2. Outsider: enter the heap if it now beats the minimum, otherwise
+    //    take its place in the reserve
+    // TIME COMPLEXITY: O(log K + K) (the reserve is a sorted array of <= K)
+    void update(const Key& key, Score score) {
+        auto old = scores.find(key);
+        bool decreased = old != scores.end() && score < old->second;
+        scores[key] = score;
+        auto it = heapPos.find(key);
+        if (it != heapPos.end()) {
+            int i = it->second;
+            heap[i].first = score;
+            if (!decreased) {
+                siftDown(i);
+                return;
+            }
+            siftUp(i);
+            bool fromReserve = !reserve.empty() && (!untracked || !(reserve.back().first < untrackedMax));
+            if (fromReserve && heap[0].first < reserve.back().first) {
+                pair<Score, Key> runnerUp = reserve.back();
+                reserve.pop_back();
+                replaceMin(runnerUp);
+            } else if (untracked && heap[0].first < untrackedMax) {
+                stale = true; // an untracked key may now beat this one
+            }
+            return;
+        }
+        for (size_t r = 0; r < reserve.size(); r++) {
+            if (reserve[r].second == key) {
+                reserve.erase(reserve.begin() + r);
+                break;
+            }
+        }
+        if (static_cast<int>(heap.size()) < capacity) {
+            heap.push_back({score, key});
+            siftUp(static_cast<int>(heap.size()) - 1);
+        } else if (heap[0].first < score) {
+            replaceMin({score, key});
+        } else {
+            keepInReserve({score, key});
+        }
+    }
+
+    void add(const Key& key, Score delta) {
+        auto it = scores.find(key);
+        update(key, (it == scores.end() ? Score() : it->second) + delta);
+    }
+
+    void clear() {
+        scores.clear();
+        heap.clear();
+        heapPos.clear();
+        reserve.clear();
+        untracked = false;
+        stale = false;
+    }
+
+    // TOP FUNCTION: Best-first list of up to K (key, score) pairs
+    // TIME COMPLEXITY: O(K log K), or O(N log K) once drops outran the reserve
+    vector<pair<Key, Score>> top(int k) {
+        if (stale) rebuild();
+        vector<pair<Score, Key>> sorted = heap;
+        sort(sorted.begin(), sorted.end(), [](const pair<Score, Key>& a, const pair<Score, Key>& b) {
+            return b.first < a.first;
+        });
+        vector<pair<Key, Score>> result;
+        for (int i = 0; i < static_cast<int>(sorted.size()) && i < k; i++) {
+            result.push_back({sorted[i].second, sorted[i].first});
+        }
+        return result;
+    }
+
+    long long rebuilds() const { return rebuildCount; }
+};
+
+// Space-Saving sketch for approximate heavy hitters
+// Tracks at most m counters; an unseen key evicts the minimum counter and
+// inherits its count as overestimation error. Any key with true frequency
+// above N/m is guaranteed to be present, and count - error <= true <= count.
+template <typename Key>
+class SpaceSavingSketch {
+private:
+    struct Counter {
+        Key key;
+        long long count;
+        long long error;
+    };
+    int capacity;
+    vector<Counter> heap; // min-heap on count
+    unordered_map<Key, int> heapPos;
+
+    void place(int i) { heapPos[heap[i].key] = i; }
+
+    void siftDown(int i) {
+        int n = static_cast<int>(heap.size());
+        while (true) {
+            int smallest = i, l = 2 * i + 1, r = l + 1;
+            if (l < n && heap[l].count < heap[smallest].count) smallest = l;
+            if (r < n && heap[r].count < heap[smallest].count) smallest = r;
+            if (smallest == i) break;
+            swap(heap[i], heap[smallest]);
+            place(i);
+            i = smallest;
+        }
+        place(i);
+    }
+
+    void siftUp(int i) {
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (heap[parent].count <= heap[i].count) break;
+            swap(heap[i], heap[parent]);
+            place(i);
+            i = parent;
+        }
+        place(i);
+    }
+
+public:
+    struct Estimate {
+        Key key;
+        long long count;
+        long long error;
+    };
+
+    explicit SpaceSavingSketch(int m) : capacity(m) {}
+
+    // OFFER FUNCTION: Counts one stream event of weight w
+    // TIME COMPLEXITY: O(log m)
+    void offer(const Key& key, long long w = 1) {
+        auto it = heapPos.find(key);
+        if (it != heapPos.end()) {
+            heap[it->second].count += w;
+            siftDown(it->second);
+        } else if (static_cast<int>(heap.size()) < capacity) {
+            heap.push_back({key, w, 0});
+            siftUp(static_cast<int>(heap.size()) - 1);
+        } else {
+            heapPos.erase(heap[0].key);
+            long long floor = heap[0].count;
+            heap[0] = {key, floor + w, floor};
+            siftDown(0);
+        }
+    }
+
+    vector<Estimate> top(int k) const {
+        vector<Estimate> result;
+        for (const Counter& c : heap) result.push_back({c.key, c.count, c.error});
+        sort(result.begin(), result.end(), [](const Estimate& a, const Estimate& b) { return a.count > b.count; });
+        if (static_cast<int>(result.size()) > k) result.resize(k);
+        return result;
+    }
+};
+
+// Compressed Sparse Row graph for large road networks
+// Node u's outgoing arcs are arcs[offsets[u] .. offsets[u+1]), stored
+// contiguously and sorted by destination, so a traversal streams through
+// memory instead of chasing one heap node per edge.
+class CSRGraph {
+public:
+    struct Arc {
+        int to;
+        int weight;
+    };
+
+    CSRGraph() : offsets(1, 0) {}
+    // knownFingerprint: the value fingerprint() would compute, when the caller
+    // already has it (e.g. from a cache file header); 0 if unknown
+    CSRGraph(vector<int>&& rowOffsets, vector<Arc>&& arcList, uint64_t knownFingerprint = 0)
+        : offsets(move(rowOffsets)), arcs(move(arcList)), fingerprintMemo(knownFingerprint) {}
+
+    int nodeCount() const { return static_cast<int>(offsets.size()) - 1; }
+    long long arcCount() const { return static_cast<long long>(arcs.size()); }
+    int degree(int u) const { return offsets[u + 1] - offsets[u]; }
+    const Arc* arcsBegin(int u) const { return arcs.data() + offsets[u]; }
+    const Arc* arcsEnd(int u) const { return arcs.data() + offsets[u + 1]; }
+    const vector<int>& rowOffsets() const { return offsets; }
+    const vector<Arc>& arcList() const { return arcs; }
+
+    // FNV-1a hash of the topology and weights; identifies the graph that a
+    // saved preprocessing file (e.g. a contraction hierarchy) belongs to.
+    // Memoised until setArcWeight changes a weight, which clears the memo.
+    uint64_t fingerprint() const {
+        if (fingerprintMemo) return fingerprintMemo;
+        uint64_t h = 1469598103934665603ULL;
+        auto mix = [&h](uint32_t x) {
+            for (int i = 0; i < 4; i++) {
+                h ^= (x >> (8 * i)) & 0xFF;
+                h *= 1099511628211ULL;
+            }
+        };
+        for (int o : offsets) mix(static_cast<uint32_t>(o));
+        for (const Arc& a : arcs) {
+            mix(static_cast<uint32_t>(a.to));
+            mix(static_cast<uint32_t>(a.weight));
+        }
+        fingerprintMemo = h;
+        return h;
+    }
+
+    // Weight of arc u -> v, or -1 if absent. O(log degree) via binary search.
+    int arcWeight(int u, int v) const {
+        const Arc* first = arcsBegin(u);
+        const Arc* last = arcsEnd(u);
+        const Arc* it = lower_bound(first, last, v, [](const Arc& a, int dest) { return a.to < dest; });
+        return (it != last && it->to == v) ? it->weight : -1;
+    }
+
+    // Changes the weight of an existing arc in place (the layout stays the
+    // same); false if there is no arc u -> v. O(log degree).
+    bool setArcWeight(int u, int v, int w) {
+        Arc* first = arcs.data() + offsets[u];
+        Arc* last = arcs.data() + offsets[u + 1];
+        Arc* it = lower_bound(first, last, v, [](const Arc& a, int dest) { return a.to < dest; });
+        if (it == last || it->to != v) return false;
+        it->weight = w;
+        fingerprintMemo = 0;
+        return true;
+    }
+
+private:
+    vector<int> offsets;
+    vector<Arc> arcs;
+    mutable uint64_t fingerprintMemo = 0;
+};
+
+// Collects arcs in any order and builds a CSRGraph
+// HOW IT WORKS:
+// 1. Count arcs per source node and prefix-sum the counts into row offsets
+// 2. Scatter every arc into its source row (counting sort, O(E))
+// 3. Sort each row by destination and keep one arc per destination: the
+//    cheapest of any parallel edges, or with KEEP_LATEST the one added last
+//    (for a network whose roads are re-added to change their weight);
+//    self-loops and out-of-range endpoints are dropped
+// 4. Compact the rows into the final contiguous arc array
+// TIME COMPLEXITY: O(V + E + sum(deg * log deg))
+class CSRGraphBuilder {
+public:
+    enum DuplicatePolicy { KEEP_CHEAPEST, KEEP_LATEST };
+
+private:
+    struct RawArc {
+        int from;
+        int to;
+        int weight;
+    };
+    int n;
+    DuplicatePolicy duplicates;
+    vector<RawArc> pending;
+
+public:
+    explicit CSRGraphBuilder(int nodes = 0, DuplicatePolicy policy = KEEP_CHEAPEST) : n(nodes), duplicates(policy) {}
+
+    void setDuplicatePolicy(DuplicatePolicy policy) { duplicates = policy; }
+
+    void reset(int nodes) {
+        n = nodes;
+        pending.clear();
+    }
+
+    void reserve(size_t arcs) { pending.reserve(arcs); }
+    int nodeCount() const { return n; }
+
+    void addArc(int u, int v, int w) {
+        if (u < 0 || v < 0 || u >= n || v >= n || u == v) return;
+        pending.push_back({u, v, w});
+    }
+
+    void addEdge(int u, int v, int w) {
+        addArc(u, v, w);
+        addArc(v, u, w);
+    }
+
+    CSRGraph build() const {
+        vector<int> offsets(n + 1, 0);
+        for (const RawArc& a : pending) offsets[a.from + 1]++;
+        for (int u = 0; u < n; u++) offsets[u + 1] += offsets[u];
+
+        vector<CSRGraph::Arc> scattered(pending.size());
+        vector<int> cursor(offsets.begin(), offsets.end() - 1);
+        for (const RawArc& a : pending) scattered[cursor[a.from]++] = {a.to, a.weight};
+
+        vector<int> compactOffsets(n + 1, 0);
+        int out = 0;
+        for (int u = 0; u < n; u++) {
+            auto first = scattered.begin() + offsets[u];
+            auto last = scattered.begin() + offsets[u + 1];
+            compactOffsets[u] = out;
+            if (duplicates == KEEP_LATEST) {
+                // The scatter kept insertion order; a stable sort keeps it per destination
+                stable_sort(first, last, [](const CSRGraph::Arc& a, const CSRGraph::Arc& b) { return a.to < b.to; });
+                for (auto it = first; it != last; ++it) {
+                    if (it + 1 != last && (it + 1)->to == it->to) continue;
+                    scattered[out++] = *it;
+                }
+                continue;
+            }
+            sort(first, last, [](const CSRGraph::Arc& a, const CSRGraph::Arc& b) {
+                return a.to != b.to ? a.to < b.to : a.weight < b.weight;
+            });
+            for (auto it = first; it != last; ++it) {
+                if (out > compactOffsets[u] && scattered[out - 1].to == it->to) continue;
+                scattered[out++] = *it;
+            }
+        }
+        compactOffsets[n] = out;
+        scattered.resize(out);
+        scattered.shrink_to_fit();
+        return CSRGraph(move(compactOffsets), move(scattered));
+    }
+};
+
+// Disjoint sets (union-find) over dense ids 0..n-1
+// HOW IT WORKS:
+// 1. Every set is a tree of parent links; its root names the set
+// 2. find() walks to the root, then points every node on the path straight
+//    at it (path compression) so later finds are one or two hops
+// 3. unite() hangs the shallower tree under the deeper one (union by rank),
+//    keeping trees O(log n) deep even before compression
+// TIME COMPLEXITY: O(alpha(n)) amortized per operation (effectively constant)
+class DisjointSets {
+private:
+    vector<int> parent;
+    vector<unsigned char> rank; // tree height bound, < 32 for any int-sized set
+    int sets = 0;
+
+public:
+    explicit DisjointSets(int n = 0) { reset(n); }
+
+    void reset(int n) {
+        parent.resize(n);
+        iota(parent.begin(), parent.end(), 0);
+        rank.assign(n, 0);
+        sets = n;
+    }
+
+    int find(int x) {
+        int root = x;
+        while (parent[root] != root) root = parent[root];
+        while (parent[x] != root) {
+            int next = parent[x];
+            parent[x] = root;
+            x = next;
+        }
+        return root;
+    }
+
+    // Returns false when a and b were already in the same set
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (rank[a] < rank[b]) swap(a, b);
+        parent[b] = a;
+        if (rank[a] == rank[b]) rank[a]++;
+        sets--;
+        return true;
+    }
+
+    bool same(int a, int b) { return find(a) == find(b); }
+    int setCount() const { return sets; }
+    int size() const { return static_cast<int>(parent.size()); }
+};
+
+// Planar position of a location or rider (grid units, or projected
+// coordinates from a road file)
+struct GeoPoint {
+    double x = 0;
+    double y = 0;
+};
+
+inline double squaredDistance(const GeoPoint& a, const GeoPoint& b) {
+    double dx = a.x - b.x, dy = a.y - b.y;
+    return dx * dx + dy * dy;
+}
+
+// Static 2-d tree over a fixed point set (road nodes)
+// HOW IT WORKS:
+// 1. Build: the median point along the wider axis of the range becomes the
+//    node (nth_element, O(n) per level), left half below, right half above;
+//    the tree is implicit in the array, node = middle slot of its range
+// 2. k-nearest: descend toward the query first, keep the k best in a
+//    max-heap, and visit the far side of a split only when the splitting
+//    line is closer than the current k-th best
+// 3. Radius: same descent, pruning sides the circle does not cross
+// TIME COMPLEXITY: O(n log n) build; O(log n + k log k) expected kNN
+class KDTree {
+private:
+    struct Item {
+        GeoPoint p;
+        int id;
+    };
+    vector<Item> items;
+    vector<unsigned char> splitY; // per slot: 1 when the node splits on y
+
+    static double coord(const GeoPoint& p, bool y) { return y ? p.y : p.x; }
+
+    void build(int lo, int hi) {
+        if (hi - lo <= 1) return;
+        double minX = items[lo].p.x, maxX = minX, minY = items[lo].p.y, maxY = minY;
+        for (int i = lo + 1; i < hi; i++) {
+            minX = min(minX, items[i].p.x);
+            maxX = max(maxX, items[i].p.x);
+            minY = min(minY, items[i].p.y);
+            maxY = max(maxY, items[i].p.y);
+        }
+        bool y = maxY - minY > maxX - minX;
+        int mid = lo + (hi - lo) / 2;
+        nth_element(items.begin() + lo, items.begin() + mid, items.begin() + hi,
+                    [y](const Item& a, const Item& b) { return coord(a.p, y) < coord(b.p, y); });
+        splitY[mid] = y;
+        build(lo, mid);
+        build(mid + 1, hi);
+    }
+
+    void nearest(int lo, int hi, const GeoPoint& q, size_t k, vector<pair<double, int>>& best) const {
+        if (lo >= hi) return;
+        int mid = lo + (hi - lo) / 2;
+        double d = squaredDistance(q, items[mid].p);
+        if (best.size() < k) {
+            best.push_back({d, items[mid].id});
+            push_heap(best.begin(), best.end());
+        } else if (d < best.front().first) {
+            pop_heap(best.begin(), best.end());
+            best.back() = {d, items[mid].id};
+            push_heap(best.begin(), best.end());
+        }
+        double diff = coord(q, splitY[mid]) - coord(items[mid].p, splitY[mid]);
+        if (diff < 0) {
+            nearest(lo, mid, q, k, best);
+            if (best.size() < k || diff * diff < best.front().first) nearest(mid + 1, hi, q, k, best);
+        } else {
+            nearest(mid + 1, hi, q, k, best);
+            if (best.size() < k || diff * diff < best.front().first) nearest(lo, mid, q, k, best);
+        }
+    }
+
+    void within(int lo, int hi, const GeoPoint& q, double r2, vector<int>& out) const {
+        if (lo >= hi) return;
+        int mid = lo + (hi - lo) / 2;
+        if (squaredDistance(q, items[mid].p) <= r2) out.push_back(items[mid].id);
+        double diff = coord(q, splitY[mid]) - coord(items[mid].p, splitY[mid]);
+        if (diff <= 0 || diff * diff <= r2) within(lo, mid, q, r2, out);
+        if (diff >= 0 || diff * diff <= r2) within(mid + 1, hi, q, r2, out);
+    }
+
+public:
+    // Point i gets id i
+    void build(const vector<GeoPoint>& points) {
+        items.resize(points.size());
+        for (size_t i = 0; i < points.size(); i++) items[i] = {points[i], static_cast<int>(i)};
+        splitY.assign(points.size(), 0);
+        build(0, static_cast<int>(items.size()));
+    }
+
+    // (id, distance) of the k closest points, closest first
+    vector<pair<int, double>> nearest(const GeoPoint& q, int k) const {
+        vector<pair<double, int>> best;
+        if (k <= 0) return {};
+        best.reserve(k + 1);
+        nearest(0, static_cast<int>(items.size()), q, static_cast<size_t>(k), best);
+        sort_heap(best.begin(), best.end());
+        vector<pair<int, double>> result;
+        for (const auto& b : best) result.push_back({b.second, sqrt(b.first)});
+        return result;
+    }
+
+    // Ids of all points within radius of q (unordered)
+    vector<int> within(const GeoPoint& q, double radius) const {
+        vector<int> out;
+        if (radius >= 0) within(0, static_cast<int>(items.size()), q, radius * radius, out);
+        return out;
+    }
+
+    int size() const { return static_cast<int>(items.size()); }
+};
+
+// Uniform grid over moving points (riders)
+// HOW IT WORKS:
+// 1. The covered area is cut into square cells; each cell lists the ids
+//    inside it, and each id remembers its cell and slot, so a move is an
+//    O(1) swap-remove plus append (points outside the area clamp to the
+//    border cells)
+// 2. A position update that stays inside its cell only rewrites the
+//    coordinates, which is the common case for a location feed
+// 3. k-nearest: scan rings of cells around the query's cell, stopping once
+//    k points are known and the next ring cannot hold anything closer
+// 4. Radius: scan only the cells overlapping the circle's bounding box
+// TIME COMPLEXITY: O(1) per update; queries O(cells scanned + points in them)
+class UniformGrid {
+public:
+    struct Update {
+        int id;
+        GeoPoint p;
+    };
+
+private:
+    struct Slot {
+        GeoPoint p;
+        int cell;
+        int index; // position inside the cell's list
+    };
+    double originX = 0, originY = 0, cellSize = 1;
+    int cols = 1, rows = 1;
+    vector<vector<int>> cells;
+    unordered_map<int, Slot> slots;
+
+    int cellOf(const GeoPoint& p) const {
+        int cx = static_cast<int>(floor((p.x - originX) / cellSize));
+        int cy = static_cast<int>(floor((p.y - originY) / cellSize));
+        cx = min(max(cx, 0), cols - 1);
+        cy = min(max(cy, 0), rows - 1);
+        return cy * cols + cx;
+    }
+
+    void detach(Slot& s) {
+        vector<int>& list = cells[s.cell];
+        int moved = list.back();
+        list[s.index] = moved;
+        slots[moved].index = s.index;
+        list.pop_back();
+    }
+
+    void scanCell(int cx, int cy, const GeoPoint& q, size_t k, vector<pair<double, int>>& best) const {
+        for (int id : cells[cy * cols + cx]) {
+            double d = squaredDistance(q, slots.at(id).p);
+            if (best.size() < k) {
+                best.push_back({d, id});
+                push_heap(best.begin(), best.end());
+            } else if (d < best.front().first) {
+                pop_heap(best.begin(), best.end());
+                best.back() = {d, id};
+                push_heap(best.begin(), best.end());
+            }
+        }
+    }
+
+public:
+    // Covers [minX, maxX] x [minY, maxY]; drops every point
+    void reset(double minX, double minY, double maxX, double maxY, double cell) {
+        originX = minX;
+        originY = minY;
+        cellSize = cell > 0 ? cell : 1;
+        cols = max(1, static_cast<int>(ceil((maxX - minX) / cellSize)) + 1);
+        rows = max(1, static_cast<int>(ceil((maxY - minY) / cellSize)) + 1);
+        cells.assign(static_cast<size_t>(cols) * rows, {});
+        slots.clear();
+    }
+
+    void upsert(int id, const GeoPoint& p) {
+        int c = cellOf(p);
+        auto it = slots.find(id);
+        if (it != slots.end()) {
+            it->second.p = p;
+            if (it->second.cell == c) return;
+            detach(it->second);
+            it->second.cell = c;
+            it->second.index = static_cast<int>(cells[c].size());
+            cells[c].push_back(id);
+            return;
+        }
+        slots[id] = {p, c, static_cast<int>(cells[c].size())};
+        cells[c].push_back(id);
+    }
+
+    // Applies a feed batch in arrival order (the last position of an id wins)
+    void apply(const vector<Update>& batch) {
+        for (const Update& u : batch) upsert(u.id, u.p);
+    }
+
+    bool remove(int id) {
+        auto it = slots.find(id);
+        if (it == slots.end()) return false;
+        detach(it->second);
+        slots.erase(it);
+        return true;
+    }
+
+    bool position(int id, GeoPoint& p) const {
+        auto it = slots.find(id);
+        if (it == slots.end()) return false;
+        p = it->second.p;
+        return true;
+    }
+
+    // (id, distance) of the k closest points, closest first
+    vector<pair<int, double>> nearest(const GeoPoint& q, int k) const {
+        vector<pair<double, int>> best;
+        if (k <= 0 || slots.empty()) return {};
+        int home = cellOf(q), hx = home % cols, hy = home / cols;
+        // Distance from q to the home cell's edges: ring r is at least r - 1
+        // cells plus this margin away
+        double margin = min(min(q.x - (originX + hx * cellSize), originX + (hx + 1) * cellSize - q.x),
+                            min(q.y - (originY + hy * cellSize), originY + (hy + 1) * cellSize - q.y));
+        margin = max(0.0, margin);
+        int maxRing = max(cols, rows);
+        for (int r = 0; r <= maxRing; r++) {
+            if (best.size() >= static_cast<size_t>(k) && r > 0) {
+                double reach = (r - 1) * cellSize + margin;
+                if (reach * reach >= best.front().first) break;
+            }
+            for (int cy = hy - r; cy <= hy + r; cy++) {
+                if (cy < 0 || cy >= rows) continue;
+                bool edgeRow = cy == hy - r || cy == hy + r;
+                for (int cx = hx - r; cx <= hx + r; cx += edgeRow ? 1 : 2 * r) {
+                    if (cx >= 0 && cx < cols) scanCell(cx, cy, q, static_cast<size_t>(k), best);
+                    if (r == 0) break;
+                }
+            }
+        }
+        sort_heap(best.begin(), best.end());
+        vector<pair<int, double>> result;
+        for (const auto& b : best) result.push_back({b.second, sqrt(b.first)});
+        return result;
+    }
+
+    // Ids of all points within radius of q (unordered)
+    vector<int> within(const GeoPoint& q, double radius) const {
+        vector<int> out;
+        if (radius < 0) return out;
+        int x0 = cellOf({q.x - radius, q.y - radius}), x1 = cellOf({q.x + radius, q.y + radius});
+        double r2 = radius * radius;
+        for (int cy = x0 / cols; cy <= x1 / cols; cy++)
+            for (int cx = x0 % cols; cx <= x1 % cols; cx++)
+                for (int id : cells[cy * cols + cx])
+                    if (squaredDistance(q, slots.at(id).p) <= r2) out.push_back(id);
+        return out;
+    }
+
+    int size() const { return static_cast<int>(slots.size()); }
+};
+
+// Indexed 4-ary min-heap with decrease-key, keyed by dense node ids
+// A wider node halves the tree height compared with a binary heap and keeps
+// the four children of a slot in one cache line, which pays off for
+// Dijkstra's many decrease-key operations.
+class IndexedDaryHeap {
+private:
+    static const int ARITY = 4;
+    vector<pair<int, int>> heap; // (key, node)
+    vector<int> pos;             // node -> heap slot, -1 if absent
+
+    void moveTo(int i, const pair<int, int>& e) {
+        heap[i] = e;
+        pos[e.second] = i;
+    }
+
+    void siftUp(int i) {
+        pair<int, int> e = heap[i];
+        while (i > 0) {
+            int parent = (i - 1) / ARITY;
+            if (heap[parent].first <= e.first) break;
+            moveTo(i, heap[parent]);
+            i = parent;
+        }
+        moveTo(i, e);
+    }
+
+    void siftDown(int i) {
+        pair<int, int> e = heap[i];
+        int n = static_cast<int>(heap.size());
+        while (true) {
+            int first = i * ARITY + 1;
+            if (first >= n) break;
+            int best = first;
+            int last = min(first + ARITY, n);
+            for (int c = first + 1; c < last; c++) {
+                if (heap[c].first < heap[best].first) best = c;
+            }
+            if (heap[best].first >= e.first) break;
+            moveTo(i, heap[best]);
+            i = best;
+        }
+        moveTo(i, e);
+    }
+
+public:
+    void resize(int nodes) {
+        heap.clear();
+        pos.assign(nodes, -1);
+    }
+
+    bool empty() const { return heap.empty(); }
+
+    // Inserts node, or lowers its key if it is already queued
+    void push(int key, int node) {
+        int i = pos[node];
+        if (i == -1) {
+            heap.push_back({key, node});
+            siftUp(static_cast<int>(heap.size()) - 1);
+        } else if (key < heap[i].first) {
+            heap[i].first = key;
+            siftUp(i);
+        }
+    }
+
+    pair<int, int> pop() {
+        pair<int, int> top = heap[0];
+        pos[top.second] = -1;
+        pair<int, int> last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            heap[0] = last;
+            siftDown(0);
+        }
+        return top;
+    }
+
+    void clear() {
+        for (const auto& e : heap) pos[e.second] = -1;
+        heap.clear();
+    }
+};
+
+// Radix heap for monotone non-negative integer keys (Dijkstra pops never
+// decrease). Bucket i holds keys whose highest bit differing from the last
+// popped key is bit i-1, so each element is redistributed at most ~32
+// times in total and push is O(1). Stale duplicates are skipped by the caller.
+class RadixHeap {
+private:
+    static const int BUCKETS = 33;
+    vector<pair<int, int>> buckets[BUCKETS];
+    int last = 0;
+    size_t count = 0;
+
+    static int bucketOf(int key, int base) {
+        unsigned diff = static_cast<unsigned>(key) ^ static_cast<unsigned>(base);
+        return diff == 0 ? 0 : 32 - __builtin_clz(diff);
+    }
+
+public:
+    bool empty() const { return count == 0; }
+
+    void push(int key, int node) {
+        buckets[bucketOf(key, last)].push_back({key, node});
+        count++;
+    }
+
+    pair<int, int> pop() {
+        if (buckets[0].empty()) {
+            int i = 1;
+            while (buckets[i].empty()) i++;
+            int newLast = buckets[i][0].first;
+            for (const auto& e : buckets[i]) newLast = min(newLast, e.first);
+            last = newLast;
+            for (const auto& e : buckets[i]) buckets[bucketOf(e.first, last)].push_back(e);
+            buckets[i].clear();
+        }
+        pair<int, int> top = buckets[0].back();
+        buckets[0].pop_back();
+        count--;
+        return top;
+    }
+
+    void clear() {
+        for (auto& b : buckets) b.clear();
+        last = 0;
+        count = 0;
+    }
+};
+
+// Dial's bucket queue for small integer weights (max arc weight C)
+// Live keys always lie in [current, current + C], so a ring of C+1 buckets
+// indexed by key mod (C+1) orders them; pop scans forward to the next
+// non-empty bucket. O(1) push, O(1) amortized pop plus O(max distance) scan.
+class DialBuckets {
+private:
+    vector<vector<int>> ring;
+    int current = 0;
+    size_t count = 0;
+
+public:
+    void resize(int maxWeight) {
+        ring.assign(maxWeight + 1, {});
+        current = 0;
+        count = 0;
+    }
+
+    bool empty() const { return count == 0; }
+
+    void push(int key, int node) {
+        ring[key % ring.size()].push_back(node);
+        count++;
+    }
+
+    pair<int, int> pop() {
+        while (ring[current % ring.size()].empty()) current++;
+        auto& bucket = ring[current % ring.size()];
+        int node = bucket.back();
+        bucket.pop_back();
+        count--;
+        return {current, node};
+    }
+
+    void clear() {
+        for (auto& b : ring) b.clear();
+        current = 0;
+        count = 0;
+    }
+};
+
+// Dense n x n distance table for all-pairs results
+// Cells are 16-bit while every finite distance fits (half the memory and
+// cache traffic of 32-bit), widening to 32-bit on the first value that does
+// not; the all-ones cell marks "unreachable". Each row carries a valid flag
+// so an edge change can drop just the rows it affects.
+class DistanceMatrix {
+private:
+    static constexpr uint16_t NONE16 = 0xFFFF;
+    static constexpr uint32_t NONE32 = 0xFFFFFFFF;
+
+    int n = 0;
+    int infinity = numeric_limits<int>::max();
+    bool narrow = false;
+    vector<uint16_t> cells16;
+    vector<uint32_t> cells32;
+    vector<char> rowValid;
+
+    size_t cell(int i, int j) const { return static_cast<size_t>(i) * n + j; }
+
+public:
+    // Sizes the table for `nodes` nodes in 32-bit cells, all rows stale;
+    // get() returns `unreachable` for missing distances
+    void reset(int nodes, int unreachable) {
+        n = nodes;
+        infinity = unreachable;
+        narrow = false;
+        vector<uint16_t>().swap(cells16);
+        cells32.assign(static_cast<size_t>(n) * n, NONE32);
+        rowValid.assign(n, 0);
+    }
+
+    int size() const { return n; }
+    bool isNarrow() const { return narrow; }
+    size_t bytes() const { return cells16.size() * sizeof(uint16_t) + cells32.size() * sizeof(uint32_t); }
+
+    int get(int i, int j) const {
+        if (narrow) {
+            uint16_t c = cells16[cell(i, j)];
+            return c == NONE16 ? infinity : c;
+        }
+        uint32_t c = cells32[cell(i, j)];
+        return c == NONE32 ? infinity : static_cast<int>(c);
+    }
+
+    // Stores d (or `unreachable`), widening first if d does not fit. Threads
+    // may fill distinct rows concurrently as long as nothing widens meanwhile.
+    void set(int i, int j, int d) {
+        if (narrow && d != infinity && d >= NONE16) widen();
+        if (narrow) cells16[cell(i, j)] = d == infinity ? NONE16 : static_cast<uint16_t>(d);
+        else cells32[cell(i, j)] = d == infinity ? NONE32 : static_cast<uint32_t>(d);
+    }
+
+    // Switches to 16-bit cells if every finite distance fits; returns narrow
+    bool compact() {
+        if (narrow) return true;
+        for (uint32_t c : cells32)
+            if (c != NONE32 && c >= NONE16) return false;
+        cells16.resize(cells32.size());
+        for (size_t k = 0; k < cells32.size(); k++)
+            cells16[k] = cells32[k] == NONE32 ? NONE16 : static_cast<uint16_t>(cells32[k]);
+        vector<uint32_t>().swap(cells32);
+        narrow = true;
+        return true;
+    }
+
+    void widen() {
+        if (!narrow) return;
+        cells32.resize(cells16.size());
+        for (size_t k = 0; k < cells16.size(); k++)
+            cells32[k] = cells16[k] == NONE16 ? NONE32 : cells16[k];
+        vector<uint16_t>().swap(cells16);
+        narrow = false;
+    }
+
+    bool rowReady(int i) const { return rowValid[i] != 0; }
+    void markRow(int i, bool valid) { rowValid[i] = valid ? 1 : 0; }
+    void invalidateAll() { fill(rowValid.begin(), rowValid.end(), 0); }
+
+    vector<int> staleRows() const {
+        vector<int> rows;
+        for (int i = 0; i < n; i++)
+            if (!rowValid[i]) rows.push_back(i);
+        return rows;
+    }
+};
+
+} // namespace DataStructures
+
+// =============================================================
+// NAMESPACE: ALGORITHMS (Standalone algorithm library)
+// Missing algorithms added for completeness
+// =============================================================
+namespace Algorithms {
+
+// ---------- Binary Search (iterative) ----------
+// Returns index of target in sorted vector, else -1
+// BINARY SEARCH FUNCTION: Finds element in sorted array using divide-and-conquer
+// HOW IT WORKS:
+// 1. Initialize left=0, right=size-1
+// 2. While left <= right:
+//    a. Calculate mid point
+//    b. If arr[mid] == target: found, return index
+//    c. If arr[mid] < target: search right half (left = mid + 1)
+//    d. If arr[mid] > target: search left half (right = mid - 1)
+// 3. If not found, return -1
+// ALGORITHM: Binary Search (requires sorted array)
+// TIME COMPLEXITY: O(log n) - halves search space each iteration
+// CONSTRAINTS: Input array must be sorted
+// USE CASE: Find menu item ID, order ID, or customer ID in sorted lists
+int binarySearch(const vector<int>& arr, int target) {
+    int l = 0, r = static_cast<int>(arr.size()) - 1;
+    while (l <= r) {
+        int mid = l + (r - l) / 2;
+        if (arr[mid] == target) return mid;
+        if (arr[mid] < target) l = mid + 1; else r = mid - 1;
+    }
+    return -1;
+}
+
+// ---------- Merge Sort (stable) ----------
+void merge(vector<int>& a, int l, int m, int r) {
+    vector<int> left(a.begin() + l, a.begin() + m + 1);
+    vector<int> right(a.begin() + m + 1, a.begin() + r + 1);
+    int i = 0, j = 0, k = l;
+    while (i < static_cast<int>(left.size()) && j < static_cast<int>(right.size())) {
+        if (left[i] <= right[j]) a[k++] = left[i++]; else a[k++] = right[j++];
+    }
+    while (i < static_cast<int>(left.size())) a[k++] = left[i++];
+    while (j < static_cast<int>(right.size())) a[k++] = right[j++];
+}
+
+void mergeSortRec(vector<int>& a, int l, int r) {
+    if (l >= r) return;
+    int m = l + (r - l) / 2;
+    mergeSortRec(a, l, m);
+    mergeSortRec(a, m + 1, r);
+    merge(a, l, m, r);
+}
+
+// MERGE SORT FUNCTION: Stable sorting algorithm that divides array and merges
+// HOW IT WORKS:
+// 1. Divide: Recursively split array into halves until size = 1
+// 2. Conquer: Merge pairs of sorted subarrays:
+//    - Create left and right subarrays
+//    - Compare elements from both and place smaller one in main array
+//    - Copy remaining elements from left/right
+// 3. Result: Sorted array with stable ordering
+// ALGORITHM: Divide-and-Conquer sorting
+// TIME COMPLEXITY: O(n log n) - guaranteed for all cases
+// SPACE COMPLEXITY: O(n) - requires temporary arrays
+// USE CASE: Sorting menu items, orders, or customer lists when stability matters
+void mergeSort(vector<int>& a) {
+    if (!a.empty()) mergeSortRec(a, 0, static_cast<int>(a.size()) - 1);
+}
+
+// ---------- Quick Sort (in-place, Lomuto) ----------
+int partition(vector<int>& a, int l, int r) {
+    int pivot = a[r];
+    int i = l;
+    for (int j = l; j < r; ++j) {
+        if (a[j] <= pivot) {
+            swap(a[i], a[j]);
+            ++i;
+        }
+    }
+    swap(a[i], a[r]);
+    return i;
+}
+
+void quickSortRec(vector<int>& a, int l, int r) {
+    if (l < r) {
+        int p = partition(a, l, r);
+        quickSortRec(a, l, p - 1);
+        quickSortRec(a, p + 1, r);
+    }
+}
+
+// QUICK SORT FUNCTION: Fast in-place sorting using pivot partitioning
+// HOW IT WORKS:
+// 1. Choose pivot (rightmost element)
+// 2. Partition: Place all elements < pivot left, >= pivot right
+// 3. Recursively sort left and right partitions
+// 4. Result: Sorted array with elements in correct positions
+// ALGORITHM: Divide-and-Conquer with Lomuto partitioning
+// TIME COMPLEXITY: O(n log n) average, O(n²) worst case
+// SPACE COMPLEXITY: O(log n) - recursion stack
+// USE CASE: Sorting orders by price, customers by points, menu by price
+void quickSort(vector<int>& a) {
+    if (!a.empty()) quickSortRec(a, 0, static_cast<int>(a.size()) - 1);
+}
+
+// ---------- Heap Sort (in-place) ----------
+void heapify(vector<int>& a, int n, int i) {
+    int largest = i;
+    int l = 2 * i + 1;
+    int r = 2 * i + 2;
+    if (l < n && a[l] > a[largest]) largest = l;
+    if (r < n && a[r] > a[largest]) largest = r;
+    if (largest != i) {
+        swap(a[i], a[largest]);
+        heapify(a, n, largest);
+    }
+}
+
+// HEAP SORT FUNCTION: Builds max-heap then repeatedly extracts max element
+// HOW IT WORKS:
+// 1. Build max-heap: Heapify from bottom-up starting at parent of last element
+// 2. For i from n-1 down to 1:
+//    a. Swap root (max) with element at position i
+//    b. Reduce heap size and heapify from root to maintain heap property
+// 3. Result: Sorted array with largest elements at end
+// ALGORITHM: Heap construction + extraction using heapify operations
+// TIME COMPLEXITY: O(n log n) - guaranteed for all cases
+// SPACE COMPLEXITY: O(1) - in-place sorting
+// USE CASE: Sorting when guaranteed O(n log n) performance critical
+void heapSort(vector<int>& a) {
+    int n = static_cast<int>(a.size());
+    for (int i = n / 2 - 1; i >= 0; --i) heapify(a, n, i);
+    for (int i = n - 1; i > 0; --i) {
+        swap(a[0], a[i]);
+        heapify(a, i, 0);
+    }
+}
+
+// ---------- KMP String Search ----------
+// KMP PREFIX TABLE FUNCTION: Builds lookup table for pattern failures
+// HOW IT WORKS:
+// 1. lps[i] = length of longest proper prefix that is also suffix of pattern[0..i]
+// 2. For each position, compare pattern[i] with pattern[len]:
+//    - If match: increment len and set lps[i] = len
+//    - If mismatch: use previous lps values to jump back (no redundant checks)
+// 3. Result: Table enabling O(n) pattern search without backtracking
+// ALGORITHM: KMP (Knuth-Morris-Pratt) preprocessing
+// TIME COMPLEXITY: O(m) where m is pattern length
+// USE CASE: Build efficiency table for fast string searching
+vector<int> kmpPrefix(const string& pat) {
+    vector<int> lps(pat.size(), 0);
+    for (size_t i = 1, len = 0; i < pat.size(); ) {
+        if (pat[i] == pat[len]) lps[i++] = static_cast<int>(++len);
+        else if (len) len = lps[len - 1];
+        else lps[i++] = 0;
+    }
+    return lps;
+}
+
+// KMP STRING SEARCH FUNCTION: Finds all occurrences of pattern in text efficiently
+// HOW IT WORKS:
+// 1. Build prefix table using kmpPrefix (knows where failures occur)
+// 2. Compare text and pattern character by character:
+//    - If match: advance both pointers
+//    - When pattern complete: record position and use prefix table to continue searching
+//    - If mismatch: use prefix table to avoid redundant comparisons
+// 3. Result: List of all starting positions where pattern found
+// ALGORITHM: KMP (Knuth-Morris-Pratt) string matching
+// TIME COMPLEXITY: O(n + m) - linear with no backtracking
+// USE CASE: Search for menu item names, customer names in large text
+vector<int> kmpSearch(const string& text, const string& pat) {
+    vector<int> res;
+    if (pat.empty()) return res;
+    auto lps = kmpPrefix(pat);
+    for (size_t i = 0, j = 0; i < text.size(); ) {
+        if (text[i] == pat[j]) { ++i; ++j; }
+        if (j == pat.size()) { res.push_back(static_cast<int>(i - j)); j = lps[j - 1]; }
+        else if (i < text.size() && text[i] != pat[j]) {
+            if (j) j = lps[j - 1]; else ++i;
+        }
+    }
+    return res;
+}
 
 // ---------- Rabin-Karp String Search (rolling hash) ----------
 // RABIN-KARP ROLLING HASH SEARCH: Uses hash values for fast pattern matching
 // HOW IT WORKS:
-// 1. Calculate hash of pattern and first window of text
-// 2. For each position in text:
-//    a. Compare pattern hash with window hash
-//    b. If hashes match, verify actual characters (hash collision check)
-//    c. If match found, record position
-//    d. Slide window: Remove leftmost char, add new rightmost char using rolling hash formula
-//    e. Rolling hash formula avoids recalculating entire hash each time
-// 3. Result: All pattern occurrences found
-// ALGORITHM: Rabin-Karp algorithm with rolling hash
-// TIME COMPLEXITY: O(n + m) average, O((n-m)m) worst case (multiple collisions)
-// USE CASE: Fast pattern search especially when multiple patterns searched
-vector<int> rabinKarpSearch(const string& text, const string& pat, int base, int mod) {
-    vector<int> res;
-    int n = static_cast<int>(text.size());
-    int m = static_cast<int>(pat.size());
-    if (m == 0 || m > n) return res;
-    int h = 1;
-    for (int i = 0; i < m - 1; ++i) h = (h * base) % mod;
-    int p = 0, t = 0;
-    for (int i = 0; i < m; ++i) {
-        p = (base * p + pat[i]) % mod;
-        t = (base * t + text[i]) % mod;
+// 1. Calculate hash of pattern and first window of text
+// 2. For each position in text:
+//    a. Compare pattern hash with window hash
+//    b. If hashes match, verify actual characters (hash collision check)
+//    c. If match found, record position
+//    d. Slide window: Remove leftmost char, add new rightmost char using rolling hash formula
+//    e. Rolling hash formula avoids recalculating entire hash each time
+// 3. Result: All pattern occurrences found
+// ALGORITHM: Rabin-Karp algorithm with rolling hash
+// TIME COMPLEXITY: O(n + m) average, O((n-m)m) worst case (multiple collisions)
+// USE CASE: Fast pattern search especially when multiple patterns searched
+vector<int> rabinKarpSearch(const string& text, const string& pat, int base, int mod) {
+    vector<int> res;
+    int n = static_cast<int>(text.size());
+    int m = static_cast<int>(pat.size());
+    if (m == 0 || m > n) return res;
+    int h = 1;
+    for (int i = 0; i < m - 1; ++i) h = (h * base) % mod;
+    int p = 0, t = 0;
+    for (int i = 0; i < m; ++i) {
+        p = (base * p + pat[i]) % mod;
+        t = (base * t + text[i]) % mod;
+    }
+    for (int i = 0; i <= n - m; ++i) {
+        if (p == t) {
+            bool match = true;
+            for (int j = 0; j < m; ++j) if (text[i + j] != pat[j]) { match = false; break; }
+            if (match) res.push_back(i);
+        }
+        if (i < n - m) {
+            t = (base * (t - text[i] * h % mod + mod) + text[i + m]) % mod;
+        }
+    }
+    return res;
+}
+
+// ---------- Greedy Coin Change (canonical systems) ----------
+// Returns counts per denom; assumes denoms sorted descending & canonical
+// GREEDY COIN CHANGE FUNCTION: Gives change using minimum coins (greedy approach)
+// HOW IT WORKS:
+// 1. For each denomination in descending order:
+//    a. Calculate how many coins of this denomination to use
+//    b. Subtract from remaining amount
+// 2. Continue until entire amount distributed
+// 3. Return count for each denomination
+// NOTE: Works correctly ONLY for canonical coin systems (like real currency)
+// ALGORITHM: Greedy selection - pick largest coins first
+// TIME COMPLEXITY: O(m) where m is number of denominations
+// CONSTRAINTS: Fails for non-canonical systems (e.g., coins {1,3,4} amount=6 → greedy gives 3, optimal is 2)
+// USE CASE: Calculate change in currency transactions
+vector<int> greedyChange(int amount, const vector<int>& denoms) {
+    vector<int> take(denoms.size(), 0);
+    for (size_t i = 0; i < denoms.size(); ++i) {
+        take[i] = amount / denoms[i];
+        amount %= denoms[i];
+    }
+    return take; // If amount > 0, greedy failed (non-canonical system)
+}
+
+// ---------- Bit-Parallel Damerau-Levenshtein (Myers/Hyyro) ----------
+// Precomputed pattern bitmasks; build once per query, verify many candidates.
+struct BitParallelPattern {
+    uint64_t peq[256];
+    int length;
+    explicit BitParallelPattern(const string& pat) : length(static_cast<int>(min<size_t>(pat.size(), 64))) {
+        memset(peq, 0, sizeof(peq));
+        for (int i = 0; i < length; ++i) peq[static_cast<unsigned char>(pat[i])] |= (uint64_t(1) << i);
+    }
+};
+
+// BIT-PARALLEL EDIT DISTANCE FUNCTION: Restricted Damerau-Levenshtein (OSA) distance
+// HOW IT WORKS:
+// 1. Encode one DP column as vertical +1/-1 delta bit-vectors (VP, VN)
+// 2. For each text character, derive the diagonal-zero vector D0 from the
+//    pattern match mask (Myers), OR-ing in adjacent transpositions (Hyyro)
+// 3. Horizontal deltas at the last row track the running distance
+// 4. Abort early once the distance cannot come back under maxDist
+// ALGORITHM: Myers' bit-vector algorithm with Hyyro's transposition extension
+// TIME COMPLEXITY: O(n) word operations for patterns up to 64 chars
+// USE CASE: Verifying fuzzy-search candidates (typo-tolerant customer lookup)
+int damerauDistanceBitParallel(const BitParallelPattern& p, const string& text, int maxDist) {
+    int m = p.length;
+    int n = static_cast<int>(text.size());
+    if (m == 0) return n;
+    if (abs(m - n) > maxDist) return maxDist + 1;
+    uint64_t vp = ~uint64_t(0), vn = 0, d0 = 0, pmPrev = 0;
+    uint64_t last = uint64_t(1) << (m - 1);
+    int dist = m;
+    for (int j = 0; j < n; ++j) {
+        uint64_t pm = p.peq[static_cast<unsigned char>(text[j])];
+        uint64_t tr = (((~d0) & pm) << 1) & pmPrev;
+        d0 = (((pm & vp) + vp) ^ vp) | pm | vn | tr;
+        uint64_t hp = vn | ~(d0 | vp);
+        uint64_t hn = d0 & vp;
+        if (hp & last) dist++;
+        else if (hn & last) dist--;
+        hp = (hp << 1) | 1;
+        hn <<= 1;
+        vp = hn | ~(d0 | hp);
+        vn = hp & d0;
+        pmPrev = pm;
+        if (dist - (n - 1 - j) > maxDist) return maxDist + 1;
+    }
+    return dist;
+}
+
+// ---------- Double Metaphone (phonetic encoding) ----------
+// Encoder state shared by the letter rules below.
+class DoubleMetaphoneEncoder {
+private:
+    static const int MAX_KEY = 4;
+    string value;
+    string primary;
+    string alternate;
+    bool slavoGermanic;
+
+    char at(int i) const {
+        return (i >= 0 && i < static_cast<int>(value.size())) ? value[i] : '\0';
+    }
+    bool isVowel(char c) const {
+        return c != '\0' && strchr("AEIOUY", c) != nullptr;
+    }
+    bool contains(int start, int len, initializer_list<const char*> options) const {
+        if (start < 0 || start + len > static_cast<int>(value.size())) return false;
+        for (const char* opt : options) {
+            if (value.compare(start, len, opt) == 0) return true;
+        }
+        return false;
+    }
+    void add(const string& main) { add(main, main); }
+    void add(const string& main, const string& alt) {
+        primary += main;
+        alternate += alt;
+    }
+    bool done() const {
+        return static_cast<int>(primary.size()) >= MAX_KEY && static_cast<int>(alternate.size()) >= MAX_KEY;
+    }
+    int last() const { return static_cast<int>(value.size()) - 1; }
+
+    int handleC(int i) {
+        bool germanicCH = i > 1 && !isVowel(at(i - 2)) && contains(i - 1, 3, {"ACH"}) &&
+                          ((at(i + 2) != 'I' && at(i + 2) != 'E') || contains(i - 2, 6, {"BACHER", "MACHER"}));
+        if (germanicCH) { add("K"); return i + 2; }
+        if (i == 0 && contains(i, 6, {"CAESAR"})) { add("S"); return i + 2; }
+        if (contains(i, 4, {"CHIA"})) { add("K"); return i + 2; }
+        if (contains(i, 2, {"CH"})) {
+            if (i > 0 && contains(i, 4, {"CHAE"})) { add("K", "X"); return i + 2; }
+            if (i == 0 && (contains(i + 1, 5, {"HARAC", "HARIS"}) || contains(i + 1, 3, {"HOR", "HYM", "HIA", "HEM"})) &&
+                !contains(0, 5, {"CHORE"})) {
+                add("K");
+                return i + 2;
+            }
+            if (contains(0, 4, {"VAN ", "VON "}) || contains(0, 3, {"SCH"}) ||
+                contains(i - 2, 6, {"ORCHES", "ARCHIT", "ORCHID"}) || contains(i + 2, 1, {"T", "S"}) ||
+                ((contains(i - 1, 1, {"A", "O", "U", "E"}) || i == 0) &&
+                 (contains(i + 2, 1, {"L", "R", "N", "M", "B", "H", "F", "V", "W", " "}) || i + 1 == last()))) {
+                add("K");
+            } else if (i > 0) {
+                if (contains(0, 2, {"MC"})) add("K");
+                else add("X", "K");
+            } else {
+                add("X");
+            }
+            return i + 2;
+        }
+        if (contains(i, 2, {"CZ"}) && !contains(i - 2, 4, {"WICZ"})) { add("S", "X"); return i + 2; }
+        if (contains(i + 1, 3, {"CIA"})) { add("X"); return i + 3; }
+        if (contains(i, 2, {"CC"}) && !(i == 1 && at(0) == 'M')) {
+            if (contains(i + 2, 1, {"I", "E", "H"}) && !contains(i + 2, 2, {"HU"})) {
+                if ((i == 1 && at(i - 1) == 'A') || contains(i - 1, 5, {"UCCEE", "UCCES"})) add("KS");
+                else add("X");
+                return i + 3;
+            }
+            add("K");
+            return i + 2;
+        }
+        if (contains(i, 2, {"CK", "CG", "CQ"})) { add("K"); return i + 2; }
+        if (contains(i, 2, {"CI", "CE", "CY"})) {
+            if (contains(i, 3, {"CIO", "CIE", "CIA"})) add("S", "X");
+            else add("S");
+            return i + 2;
+        }
+        add("K");
+        if (contains(i + 1, 2, {" C", " Q", " G"})) return i + 3;
+        if (contains(i + 1, 1, {"C", "K", "Q"}) && !contains(i + 1, 2, {"CE", "CI"})) return i + 2;
+        return i + 1;
+    }
+
+    int handleG(int i) {
+        if (at(i + 1) == 'H') {
+            if (i > 0 && !isVowel(at(i - 1))) { add("K"); return i + 2; }
+            if (i == 0) { add(at(i + 2) == 'I' ? "J" : "K"); return i + 2; }
+            if ((i > 1 && contains(i - 2, 1, {"B", "H", "D"})) || (i > 2 && contains(i - 3, 1, {"B", "H", "D"})) ||
+                (i > 3 && contains(i - 4, 1, {"B", "H"}))) {
+                return i + 2;
+            }
+            if (i > 2 && at(i - 1) == 'U' && contains(i - 3, 1, {"C", "G", "L", "R", "T"})) add("F");
+            else if (i > 0 && at(i - 1) != 'I') add("K");
+            return i + 2;
+        }
+        if (at(i + 1) == 'N') {
+            if (i == 1 && isVowel(at(0)) && !slavoGermanic) add("KN", "N");
+            else if (!contains(i + 2, 2, {"EY"}) && at(i + 1) != 'Y' && !slavoGermanic) add("N", "KN");
+            else add("KN");
+            return i + 2;
+        }
+        if (contains(i + 1, 2, {"LI"}) && !slavoGermanic) { add("KL", "L"); return i + 2; }
+        if (i == 0 && (at(i + 1) == 'Y' ||
+                       contains(i + 1, 2, {"ES", "EP", "EB", "EL", "EY", "IB", "IL", "IN", "IE", "EI", "ER"}))) {
+            add("K", "J");
+            return i + 2;
+        }
+        if ((contains(i + 1, 2, {"ER"}) || at(i + 1) == 'Y') && !contains(0, 6, {"DANGER", "RANGER", "MANGER"}) &&
+            !contains(i - 1, 1, {"E", "I"}) && !contains(i - 1, 3, {"RGY", "OGY"})) {
+            add("K", "J");
+            return i + 2;
+        }
+        if (contains(i + 1, 1, {"E", "I", "Y"}) || contains(i - 1, 4, {"AGGI", "OGGI"})) {
+            if (contains(0, 4, {"VAN ", "VON "}) || contains(0, 3, {"SCH"}) || contains(i + 1, 2, {"ET"})) add("K");
+            else if (contains(i + 1, 3, {"IER"})) add("J");
+            else add("J", "K");
+            return i + 2;
+        }
+        add("K");
+        return at(i + 1) == 'G' ? i + 2 : i + 1;
+    }
+
+    int handleJ(int i) {
+        if (contains(i, 4, {"JOSE"}) || contains(0, 4, {"SAN "})) {
+            if ((i == 0 && at(i + 4) == ' ') || value.size() == 4 || contains(0, 4, {"SAN "})) add("H");
+            else add("J", "H");
+            return i + 1;
+        }
+        if (i == 0) add("J", "A");
+        else if (isVowel(at(i - 1)) && !slavoGermanic && (at(i + 1) == 'A' || at(i + 1) == 'O')) add("J", "H");
+        else if (i == last()) add("J", "");
+        else if (!contains(i + 1, 1, {"L", "T", "K", "S", "N", "M", "B", "Z"}) && !contains(i - 1, 1, {"S", "K", "L"})) add("J");
+        return at(i + 1) == 'J' ? i + 2 : i + 1;
+    }
+
+    int handleS(int i) {
+        if (contains(i - 1, 3, {"ISL", "YSL"})) return i + 1;
+        if (i == 0 && contains(i, 5, {"SUGAR"})) { add("X", "S"); return i + 1; }
+        if (contains(i, 2, {"SH"})) {
+            add(contains(i + 1, 4, {"HEIM", "HOEK", "HOLM", "HOLZ"}) ? "S" : "X");
+            return i + 2;
+        }
+        if (contains(i, 3, {"SIO", "SIA"}) || contains(i, 4, {"SIAN"})) {
+            if (slavoGermanic) add("S");
+            else add("S", "X");
+            return i + 3;
+        }
+        if ((i == 0 && contains(i + 1, 1, {"M", "N", "L", "W"})) || contains(i + 1, 1, {"Z"})) {
+            add("S", "X");
+            return contains(i + 1, 1, {"Z"}) ? i + 2 : i + 1;
+        }
+        if (contains(i, 2, {"SC"})) {
+            if (at(i + 2) == 'H') {
+                if (contains(i + 3, 2, {"OO", "ER", "EN", "UY", "ED", "EM"})) {
+                    if (contains(i + 3, 2, {"ER", "EN"})) add("X", "SK");
+                    else add("SK");
+                } else if (i == 0 && !isVowel(at(3)) && at(3) != 'W') {
+                    add("X", "S");
+                } else {
+                    add("X");
+                }
+            } else if (contains(i + 2, 1, {"I", "E", "Y"})) {
+                add("S");
+            } else {
+                add("SK");
+            }
+            return i + 3;
+        }
+        if (i == last() && contains(i - 2, 2, {"AI", "OI"})) add("", "S");
+        else add("S");
+        return contains(i + 1, 1, {"S", "Z"}) ? i + 2 : i + 1;
+    }
+
+    int handleT(int i) {
+        if (contains(i, 4, {"TION"})) { add("X"); return i + 3; }
+        if (contains(i, 3, {"TIA", "TCH"})) { add("X"); return i + 3; }
+        if (contains(i, 2, {"TH"}) || contains(i, 3, {"TTH"})) {
+            if (contains(i + 2, 2, {"OM", "AM"}) || contains(0, 4, {"VAN ", "VON "}) || contains(0, 3, {"SCH"})) add("T");
+            else add("0", "T");
+            return i + 2;
+        }
+        add("T");
+        return contains(i + 1, 1, {"T", "D"}) ? i + 2 : i + 1;
+    }
+
+    int handleW(int i) {
+        if (contains(i, 2, {"WR"})) { add("R"); return i + 2; }
+        if (i == 0 && (isVowel(at(i + 1)) || contains(i, 2, {"WH"}))) {
+            if (isVowel(at(i + 1))) add("A", "F");
+            else add("A");
+            return i + 1;
+        }
+        if ((i == last() && isVowel(at(i - 1))) || contains(i - 1, 5, {"EWSKI", "EWSKY", "OWSKI", "OWSKY"}) ||
+            contains(0, 3, {"SCH"})) {
+            add("", "F");
+            return i + 1;
+        }
+        if (contains(i, 4, {"WICZ", "WITZ"})) { add("TS", "FX"); return i + 4; }
+        return i + 1;
+    }
+
+public:
+    pair<string, string> encode(const string& word) {
+        value.clear();
+        for (char c : word) {
+            if (isalpha(static_cast<unsigned char>(c)) || c == ' ') value += static_cast<char>(toupper(static_cast<unsigned char>(c)));
+        }
+        primary.clear();
+        alternate.clear();
+        if (value.empty()) return {"", ""};
+        slavoGermanic = value.find('W') != string::npos || value.find('K') != string::npos ||
+                        value.find("CZ") != string::npos || value.find("WITZ") != string::npos;
+
+        int i = 0;
+        if (contains(0, 2, {"GN", "KN", "PN", "WR", "PS"})) i = 1;
+        if (at(0) == 'X') { add("S"); i = 1; }
+
+        int n = static_cast<int>(value.size());
+        while (!done() && i < n) {
+            char c = at(i);
+            switch (c) {
+                case 'A': case 'E': case 'I': case 'O': case 'U': case 'Y':
+                    if (i == 0) add("A");
+                    i++;
+                    break;
+                case 'B':
+                    add("P");
+                    i = at(i + 1) == 'B' ? i + 2 : i + 1;
+                    break;
+                case 'C': i = handleC(i); break;
+                case 'D':
+                    if (contains(i, 2, {"DG"})) {
+                        if (contains(i + 2, 1, {"I", "E", "Y"})) { add("J"); i += 3; }
+                        else { add("TK"); i += 2; }
+                    } else if (contains(i, 2, {"DT", "DD"})) {
+                        add("T"); i += 2;
+                    } else {
+                        add("T"); i++;
+                    }
+                    break;
+                case 'F':
+                    add("F");
+                    i = at(i + 1) == 'F' ? i + 2 : i + 1;
+                    break;
+                case 'G': i = handleG(i); break;
+                case 'H':
+                    if ((i == 0 || isVowel(at(i - 1))) && isVowel(at(i + 1))) { add("H"); i += 2; }
+                    else i++;
+                    break;
+                case 'J': i = handleJ(i); break;
+                case 'K':
+                    add("K");
+                    i = at(i + 1) == 'K' ? i + 2 : i + 1;
+                    break;
+                case 'L':
+                    if (at(i + 1) == 'L') {
+                        bool spanishLL = (i == n - 3 && contains(i - 1, 4, {"ILLO", "ILLA", "ALLE"})) ||
+                                         ((contains(n - 2, 2, {"AS", "OS"}) || contains(n - 1, 1, {"A", "O"})) &&
+                                          contains(i - 1, 4, {"ALLE"}));
+                        if (spanishLL) add("L", "");
+                        else add("L");
+                        i += 2;
+                    } else {
+                        add("L"); i++;
+                    }
+                    break;
+                case 'M':
+                    add("M");
+                    i = (at(i + 1) == 'M' || (contains(i - 1, 3, {"UMB"}) && (i + 1 == last() || contains(i + 2, 2, {"ER"}))))
+                            ? i + 2 : i + 1;
+                    break;
+                case 'N':
+                    add("N");
+                    i = at(i + 1) == 'N' ? i + 2 : i + 1;
+                    break;
+                case 'P':
+                    if (at(i + 1) == 'H') { add("F"); i += 2; }
+                    else { add("P"); i = contains(i + 1, 1, {"P", "B"}) ? i + 2 : i + 1; }
+                    break;
+                case 'Q':
+                    add("K");
+                    i = at(i + 1) == 'Q' ? i + 2 : i + 1;
+                    break;
+                case 'R':
+                    if (i == last() && !slavoGermanic && contains(i - 2, 2, {"IE"}) && !contains(i - 4, 2, {"ME", "MA"})) add("", "R");
+                    else add("R");
+                    i = at(i + 1) == 'R' ? i + 2 : i + 1;
+                    break;
+                case 'S': i = handleS(i); break;
+                case 'T': i = handleT(i); break;
+                case 'V':
+                    add("F");
+                    i = at(i + 1) == 'V' ? i + 2 : i + 1;
+                    break;
+                case 'W': i = handleW(i); break;
+                case 'X':
+                    if (i == 0) { add("S"); i++; break; }
+                    if (!(i == last() && (contains(i - 3, 3, {"IAU", "EAU"}) || contains(i - 2, 2, {"AU", "OU"})))) add("KS");
+                    i = contains(i + 1, 1, {"C", "X"}) ? i + 2 : i + 1;
+                    break;
+                case 'Z':
+                    if (at(i + 1) == 'H') { add("J"); i += 2; break; }
+                    if (contains(i + 1, 2, {"ZO", "ZI", "ZA"}) || (slavoGermanic && i > 0 && at(i - 1) != 'T')) add("S", "TS");
+                    else add("S");
+                    i = at(i + 1) == 'Z' ? i + 2 : i + 1;
+                    break;
+                default:
+                    i++;
+                    break;
+            }
+        }
+        return {primary.substr(0, MAX_KEY), alternate.substr(0, MAX_KEY)};
+    }
+};
+
+// DOUBLE METAPHONE FUNCTION: Encodes a word into primary/alternate sound keys
+// HOW IT WORKS:
+// 1. Uppercase and strip non-letters; detect Slavo-Germanic spellings
+// 2. Skip silent leading letters (GN, KN, PN, WR, PS)
+// 3. Scan left to right applying context rules per consonant
+//    (e.g. "PH" -> F, "TH" -> 0/T, "SCH" -> SK/X, "GH" silent or F)
+// 4. Ambiguous spellings emit a different alternate code
+// 5. Truncate both keys to 4 characters
+// ALGORITHM: Lawrence Philips' Double Metaphone
+// TIME COMPLEXITY: O(L) where L is word length
+// USE CASE: Matching names taken over the phone ("Jon Smyth" ~ "John Smith")
+pair<string, string> doubleMetaphone(const string& word) {
+    DoubleMetaphoneEncoder encoder;
+    return encoder.encode(word);
+}
+
+} // namespace Algorithms
+
+// =============================================================
+// NAMESPACE: SERVICES (Business Logic Facades)
+// =============================================================
+namespace Services {
+// Service-layer facades would live here; procedural functions below
+// serve the same role within this single-translation-unit design.
+}
+
+// =============================================================
+// UTILITY FUNCTIONS (Input Validation)
+// =============================================================
+
+int readInt(const string &label, int low, int high)
+{
+    while (true)
+    {
+        cout << label;
+        int x;
+        if (cin >> x)
+        {
+            if (x >= low && x <= high)
+            {
+                return x;
+            }
+            else
+            {
+                cout << "Value out of range. Expected between " << low << " and " << high << "\n";
+            }
+        }
+        else
+        {
+            cout << "Invalid input. Please enter a number.\n";
+            cin.clear();
+        }
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    }
+}
+
+string readLine(const string &label)
+{
+    cout << label;
+    string s;
+    getline(cin >> ws, s);
+    return s;
+}
+
+double readFloat(const string &label, double low, double high)
+{
+    while (true)
+    {
+        cout << label;
+        double x;
+        if (cin >> x)
+        {
+            if (x >= low && x <= high)
+            {
+                return x;
+            }
+            else
+            {
+                cout << "Value out of range. Expected between " << low << " and " << high << "\n";
+            }
+        }
+        else
+        {
+            cout << "Invalid numeric input. Please retry.\n";
+            cin.clear();
+        }
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    }
+}
+
+// =============================================================
+// GLOBAL DATA STORAGE (Managed by Services layer)
+// NOTE: Static arrays used instead of STL containers
+// to meet academic constraints and ensure predictable memory layout.
+// =============================================================
+
+static const int MAX_CUSTOMERS = 500;
+Domain::Customer customerRecords[MAX_CUSTOMERS];
+int customerCount = 0;
+
+static const int MAX_MENU_ITEMS = 200;
+Domain::MenuItem menuItems[MAX_MENU_ITEMS];
+int menuItemCount = 0;
+
+static const int MAX_ORDERS = 300;
+Domain::Order orderHeap[MAX_ORDERS];
+int orderHeapSize = 0;
+
+inline void swapOrder(Domain::Order &a, Domain::Order &b) {
+    swap(a, b);
+}
+
+inline void orderHeapifyUp(int index) {
+    while (index > 0) {
+        int parent = (index - 1) >> 1;
+        if (orderHeap[parent].priority >= orderHeap[index].priority) break;
+        swap(orderHeap[parent], orderHeap[index]);
+        index = parent;
+    }
+}
+
+inline void orderHeapifyDown(int index) {
+    while (true) {
+        int left = (index << 1) + 1;
+        int right = left + 1;
+        int largest = index;
+        if (left < orderHeapSize && orderHeap[left].priority > orderHeap[largest].priority)
+            largest = left;
+        if (right < orderHeapSize && orderHeap[right].priority > orderHeap[largest].priority)
+            largest = right;
+        if (largest == index) break;
+        swap(orderHeap[largest], orderHeap[index]);
+        index = largest;
+    }
+}
+
+// =============================================================
+// Kitchen Management - Linked List Queue
+// NOTE: KitchenOrder uses string status (not FSM enum) because:
+// - Kitchen queue is a transient internal workflow, not a business entity
+// - Domain::Order uses FSM for business-critical state transitions
+// - Kitchen status is informational only ("Queued", "Cooking", "Done")
+// - This separation maintains clean domain boundaries
+// =============================================================
+
+struct KitchenOrder
+{
+    int orderId;
+    string dishName;
+    int tableNumber;
+    int prepTime;
+    string status;  // "Queued", "Cooking", "Done" - transient workflow
+    KitchenOrder *next;
+};
+
+KitchenOrder *kitchenHead = nullptr;
+KitchenOrder *kitchenTail = nullptr;
+int kitchenCounter = 0;
+
+// ENQUEUE KITCHEN FUNCTION: Adds a new order to the end of kitchen queue
+// HOW IT WORKS:
+// 1. Create new KitchenOrder node with order details
+// 2. Initialize status as 'Queued'
+// 3. Set next pointer to nullptr (this is the new tail)
+// 4. If queue is empty, make this node both head and tail
+// 5. Otherwise, append to tail and update tail pointer
+// 6. Increment kitchen counter
+// ALGORITHM: Singly Linked List FIFO (First-In-First-Out) Queue
+// TIME COMPLEXITY: O(1) - constant time insertion at tail
+// USE CASE: Maintain order of dishes to be prepared in kitchen
+void enqueueKitchen(int orderId, const string &dish, int table, int time)
+{
+    KitchenOrder *node = new KitchenOrder();
+    node->orderId = orderId;
+    node->dishName = dish;
+    node->tableNumber = table;
+    node->prepTime = time;
+    node->status = "Queued";
+    node->next = nullptr;
+    if (kitchenTail == nullptr)
+    {
+        kitchenHead = kitchenTail = node;
+    }
+    else
+    {
+        kitchenTail->next = node;
+        kitchenTail = node;
+    }
+    kitchenCounter++;
+}
+
+// PROCESS KITCHEN ORDER FUNCTION: Removes and processes the first order from queue
+// HOW IT WORKS:
+// 1. Check if queue is empty (kitchenHead == nullptr)
+// 2. If empty, print message and return
+// 3. Get the order at front (head) and display its details
+// 4. Move head pointer to next order in queue
+// 5. If queue becomes empty, also set tail to nullptr
+// 6. Decrement kitchen counter
+// 7. Free memory of processed order
+// ALGORITHM: Singly Linked List FIFO Dequeue
+// TIME COMPLEXITY: O(1) - constant time removal from head
+// USE CASE: Process dishes in order they were received by kitchen
+void processKitchenOrder()
+{
+    if (kitchenHead == nullptr)
+    {
+        cout << "No orders in kitchen queue.\n";
+        return;
+    }
+    KitchenOrder *node = kitchenHead;
+    cout << "Processing Order ID: " << node->orderId << " | Dish: " << node->dishName
+         << " | Table: " << node->tableNumber << " | Prep Time: " << node->prepTime << " mins\n";
+    kitchenHead = kitchenHead->next;
+    if (kitchenHead == nullptr)
+    {
+        kitchenTail = nullptr;
+    }
+    kitchenCounter--;
+    delete node;
+}
+
+// DISPLAY KITCHEN QUEUE FUNCTION: Lists all orders currently in kitchen queue
+// HOW IT WORKS:
+// 1. Start from head of linked list
+// 2. Traverse through each order node in the queue
+// 3. For each order, print position, order ID, dish name, table number, and prep time
+// 4. Continue until reaching end of queue (null pointer)
+// ALGORITHM: Linked List traversal
+// TIME COMPLEXITY: O(n) where n is number of orders in queue
+// USE CASE: Kitchen staff view list of pending orders to prepare
+void displayKitchenQueue()
+{
+    cout << "\nKitchen Queue:\n";
+    KitchenOrder *cur = kitchenHead;
+    int pos = 1;
+    while (cur)
+    {
+        cout << pos++ << ". Order#" << cur->orderId << " | " << cur->dishName
+             << " | Table " << cur->tableNumber << " | Time: " << cur->prepTime << " mins\n";
+        cur = cur->next;
+    }
+}
+
+// =============================================================
+// Table Reservation Management
+// =============================================================
+
+struct TableReservation
+{
+    int reservationId;
+    int tableNumber;
+    int customerId;
+    string customerName;
+    string date;
+    string time;
+    int guestCount;
+    string status; // Booked, Confirmed, Cancelled, Completed
+};
+
+static const int MAX_RESERVATIONS = 300;
+TableReservation reservations[MAX_RESERVATIONS];
+int reservationCount = 0;
+
+static const int MAX_TABLES = 50;
+bool tableOccupied[MAX_TABLES];
+int tableCapacity[MAX_TABLES];
+
+void initializeTables()
+{
+    for (int i = 0; i < MAX_TABLES; i++)
+    {
+        tableOccupied[i] = false;
+        tableCapacity[i] = (i % 3 == 0) ? 2 : (i % 3 == 1) ? 4 : 6; // Mix of 2, 4, 6 seaters
+    }
+}
+
+// =============================================================
+// Billing System with Circular Queue
+// =============================================================
+
+struct Bill
+{
+    int billId;
+    int orderId;
+    int customerId;
+    double subtotal;
+    double tax;
+    double discount;
+    double finalAmount;
+    string paymentMethod;
+    string status;
+};
+
+static const int BILL_CAP = 300;
+Bill billQueue[BILL_CAP];
+int billFront = 0;
+int billRear = 0;
+int billSize = 0;
+
+// ENQUEUE BILL FUNCTION: Adds a new bill to circular queue for processing
+// HOW IT WORKS:
+// 1. Check if circular queue is at full capacity
+// 2. If full, print error and return without adding
+// 3. Otherwise, insert bill at rear position
+// 4. Move rear pointer to next position using modulo (wraps around)
+// 5. Increment size counter
+// ALGORITHM: Circular Queue - enqueue operation
+// TIME COMPLEXITY: O(1) - constant time
+// USE CASE: Queue bills for payment processing in FIFO order
+bool billIsFull()
+{
+    return billSize == BILL_CAP;
+}
+
+bool billIsEmpty()
+{
+    return billSize == 0;
+}
+
+// ENQUEUE BILL FUNCTION: Adds a new bill to the circular queue for billing system
+// HOW IT WORKS:
+// 1. Check if queue is full (billSize == BILL_CAP)
+// 2. If full, print error and return without adding
+// 3. Copy bill into billQueue at billRear position
+// 4. Move billRear pointer forward: (billRear + 1) % BILL_CAP (wraps around)
+// 5. Increment billSize counter
+// ALGORITHM: Circular Queue enqueue using modulo arithmetic
+// TIME COMPLEXITY: O(1) - constant time insertion
+// USE CASE: Store bills waiting for payment processing
+void enqueueBill(const Bill &b)
+{
+    if (billIsFull())
+    {
+        cout << "Billing queue full.\n";
+        return;
+    }
+    billQueue[billRear] = b;
+    billRear = (billRear + 1) % BILL_CAP;
+    billSize++;
+}
+
+// DEQUEUE BILL FUNCTION: Removes and returns the oldest bill from circular queue
+// HOW IT WORKS:
+// 1. Get bill at billFront position (oldest bill waiting)
+// 2. Move billFront pointer forward: (billFront + 1) % BILL_CAP (wraps around)
+// 3. Decrement billSize counter
+// 4. Return the dequeued bill
+// ALGORITHM: Circular Queue dequeue using modulo arithmetic
+// TIME COMPLEXITY: O(1) - constant time removal
+// USE CASE: Process bills in FIFO order for payment collection
+Bill dequeueBill()
+{
+    Bill b = billQueue[billFront];
+    billFront = (billFront + 1) % BILL_CAP;
+    billSize--;
+    return b;
+}
+
+// =============================================================
+// Sales Analysis Data
+// =============================================================
+
+struct SalesRecord
+{
+    string date;
+    double revenue;
+    int ordersCount;
+    string topDish;
+};
+
+static const int MAX_SALES = 365;
+SalesRecord salesData[MAX_SALES];
+int salesCount = 0;
+
+// =============================================================
+// Inventory Management using Hash Table
+// =============================================================
+
+struct InventoryItem
+{
+    string name;
+    int quantity;
+    string unit;
+    double costPerUnit;
+    int reorderLevel;
+};
+
+static const int HASH_SIZE = 101;
+InventoryItem inventoryTable[HASH_SIZE];
+bool inventoryUsed[HASH_SIZE];
+
+int simpleHash(const string &key)
+{
+    int sum = 0;
+    for (char c : key)
+    {
+        sum += static_cast<int>(c);
+    }
+    return sum % HASH_SIZE;
+}
+
+// HASH TABLE LOOKUP FUNCTION: Finds position of item in hash table using linear probing
+// HOW IT WORKS:
+// 1. Compute initial hash index: sum of ASCII values % HASH_SIZE
+// 2. Start at computed index
+// 3. If position is occupied AND the name doesn't match, continue probing
+// 4. Increment step value and wrap around using modulo (linear probing)
+// 5. Return the index when:
+//    - Found matching item (used==true AND name matches)
+//    - Found empty slot (used==false)
+// ALGORITHM: Hash table with linear probing collision resolution
+// TIME COMPLEXITY: O(1) average, O(n) worst case (many collisions)
+// USE CASE: Fast ingredient lookup in restaurant inventory
+int probeIndex(const string &key)
+{
+    int idx = simpleHash(key);
+    int step = 1;
+    while (inventoryUsed[idx] && inventoryTable[idx].name != key)
+    {
+        idx = (idx + step) % HASH_SIZE;
+        step++;
+    }
+    return idx;
+}
+
+void addInventoryItem()
+{
+    InventoryItem item;
+    item.name = readLine("Enter ingredient name: ");
+    item.quantity = readInt("Enter quantity: ", 0, 1000000);
+    item.unit = readLine("Enter unit (kg/ltr/pcs): ");
+    item.costPerUnit = readFloat("Enter cost per unit: ", 0.0, 100000.0);
+    item.reorderLevel = readInt("Enter reorder level: ", 0, 10000);
+    int idx = probeIndex(item.name);
+    inventoryTable[idx] = item;
+    inventoryUsed[idx] = true;
+    cout << "Inventory item added at slot " << idx << "\n";
+}
+
+void updateInventoryItem()
+{
+    string key = readLine("Enter ingredient name to update: ");
+    int idx = probeIndex(key);
+    if (!inventoryUsed[idx] || inventoryTable[idx].name != key)
+    {
+        cout << "Item not found in inventory.\n";
+        return;
+    }
+    inventoryTable[idx].quantity = readInt("Enter new quantity: ", 0, 1000000);
+    inventoryTable[idx].costPerUnit = readFloat("Enter new cost per unit: ", 0.0, 100000.0);
+    cout << "Inventory item updated.\n";
+}
+
+void viewInventoryItem()
+{
+    string key = readLine("Enter ingredient name: ");
+    int idx = probeIndex(key);
+    if (!inventoryUsed[idx] || inventoryTable[idx].name != key)
+    {
+        cout << "Item not found.\n";
+        return;
+    }
+    cout << "Name: " << inventoryTable[idx].name
+         << " | Qty: " << inventoryTable[idx].quantity << " " << inventoryTable[idx].unit
+         << " | Cost/Unit: $" << inventoryTable[idx].costPerUnit
+         << " | Reorder: " << inventoryTable[idx].reorderLevel << "\n";
+}
+
+void listInventory()
+{
+    cout << "\n=== Inventory Snapshot ===\n";
+    for (int i = 0; i < HASH_SIZE; i++)
+    {
+        if (inventoryUsed[i])
+        {
+            cout << inventoryTable[i].name << " | " << inventoryTable[i].quantity
+                 << " " << inventoryTable[i].unit << " | $" << inventoryTable[i].costPerUnit << "/unit";
+            if (inventoryTable[i].quantity <= inventoryTable[i].reorderLevel)
+            {
+                cout << " [LOW STOCK - REORDER NEEDED]";
+            }
+            cout << "\n";
+        }
+    }
+}
+
+// =============================================================
+// Online Ordering System
+// =============================================================
+
+struct OnlineOrder
+{
+    int orderId;
+    int customerId;
+    string deliveryAddress;
+    string items[20];
+    int itemCount;
+    double totalAmount;
+    string status; // Placed, Confirmed, Out for Delivery, Delivered
+    int deliveryTime; // estimated minutes
+    int deliveryNode; // location in the delivery network, -1 if not routable
+    int windowStart;  // promised delivery window, minutes on the dispatch clock
+    int windowEnd;
+    int assignedRider; // rider dispatched directly to this order, -1 if none
+    int placedAt;      // dispatch clock minute the order came in
+};
+
+static const int MAX_ONLINE_ORDERS = 200;
+OnlineOrder onlineOrders[MAX_ONLINE_ORDERS];
+int onlineOrderCount = 0;
+
+// =============================================================
+// Offers and Promotions
+// =============================================================
+
+struct Offer
+{
+    int offerId;
+    string offerName;
+    string description;
+    double discountPercent;
+    string validFrom;
+    string validTo;
+    bool active;
+};
+
+static const int MAX_OFFERS = 50;
+Offer offers[MAX_OFFERS];
+int offerCount = 0;
+
+// =============================================================
+// Feedback and Rating System
+// =============================================================
+
+struct Feedback
+{
+    int feedbackId;
+    int customerId;
+    string customerName;
+    int rating; // 1-5 stars
+    string comments;
+    string date;
+    string category; // Food, Service, Ambience, Overall
+};
+
+static const int MAX_FEEDBACK = 500;
+Feedback feedbackRecords[MAX_FEEDBACK];
+int feedbackCount = 0;
+
+// =============================================================
+// Binary Search Tree for Fast Customer Lookup
+// =============================================================
+
+struct BSTNode
+{
+    int key;
+    string name;
+    BSTNode *left;
+    BSTNode *right;
+    int height;
+};
+
+BSTNode *customerBST = nullptr;
+
+inline int height(BSTNode *n) {
+    return n ? n->height : 0;
+}
+
+inline int balanceFactor(BSTNode *n) {
+    return n ? height(n->left) - height(n->right) : 0;
+}
+
+BSTNode *createNode(int key, const string &name)
+{
+    BSTNode *node = new BSTNode();
+    node->key = key;
+    node->name = name;
+    node->left = node->right = nullptr;
+    node->height = 1;
+    return node;
+}
+
+BSTNode *rightRotate(BSTNode *y)
+{
+    BSTNode *x = y->left;
+    BSTNode *T2 = x->right;
+    x->right = y;
+    y->left = T2;
+    y->height = max(height(y->left), height(y->right)) + 1;
+    x->height = max(height(x->left), height(x->right)) + 1;
+    return x;
+}
+
+BSTNode *leftRotate(BSTNode *x)
+{
+    BSTNode *y = x->right;
+    BSTNode *T2 = y->left;
+    y->left = x;
+    x->right = T2;
+    x->height = max(height(x->left), height(x->right)) + 1;
+    y->height = max(height(y->left), height(y->right)) + 1;
+    return y;
+}
+
+// AVL TREE INSERTION FUNCTION: Inserts a customer into a self-balancing binary search tree
+// HOW IT WORKS:
+// 1. Base case: If node is NULL, create and return new node
+// 2. Recursive case: Insert into left subtree if key < node->key, else right
+// 3. Update height after insertion
+// 4. Calculate balance factor (height difference between left and right subtrees)
+// 5. If unbalanced (|BF| > 1), perform rotations:
+//    - Left-Left case: Right rotation
+//    - Right-Right case: Left rotation
+//    - Left-Right case: Left rotate child, then right rotate
+//    - Right-Left case: Right rotate child, then left rotate
+// ALGORITHM: AVL Tree insertion with automatic balancing
+// TIME COMPLEXITY: O(log n) - guaranteed logarithmic due to balance maintenance
+// USE CASE: Fast customer lookup by ID with guaranteed O(log n) search time
+BSTNode *insertAVL(BSTNode *node, int key, const string &name)
+{
+    if (!node)
+    {
+        return createNode(key, name);
+    }
+    if (key < node->key)
+    {
+        node->left = insertAVL(node->left, key, name);
+    }
+    else if (key > node->key)
+    {
+        node->right = insertAVL(node->right, key, name);
+    }
+    else
+    {
+        return node;
+    }
+    node->height = 1 + max(height(node->left), height(node->right));
+    int bf = balanceFactor(node);
+    if (bf > 1 && key < node->left->key)
+    {
+        return rightRotate(node);
+    }
+    if (bf < -1 && key > node->right->key)
+    {
+        return leftRotate(node);
+    }
+    if (bf > 1 && key > node->left->key)
+    {
+        node->left = leftRotate(node->left);
+        return rightRotate(node);
+    }
+    if (bf < -1 && key < node->right->key)
+    {
+        node->right = rightRotate(node->right);
+        return leftRotate(node);
+    }
+    return node;
+}
+
+// BST SEARCH FUNCTION: Recursively searches for a customer node by ID
+// HOW IT WORKS:
+// 1. Base case: If root is NULL, customer not found, return nullptr
+// 2. If key matches root's key, found the customer, return root
+// 3. If key < root->key, search left subtree (smaller IDs)
+// 4. If key > root->key, search right subtree (larger IDs)
+// ALGORITHM: Binary Search Tree lookup
+// TIME COMPLEXITY: O(log n) average, O(n) worst (balanced vs unbalanced)
+// USE CASE: Quick customer lookup without full linear search
+BSTNode *searchBST(BSTNode *root, int key)
+{
+    if (!root)
+        return nullptr;
+    if (key == root->key)
+        return root;
+    if (key < root->key)
+        return searchBST(root->left, key);
+    return searchBST(root->right, key);
+}
+
+// IN-ORDER TRAVERSAL FUNCTION: Displays all customers in sorted order by ID
+// HOW IT WORKS:
+// 1. Recursively visit left subtree (smaller IDs)
+// 2. Print current node (ID and name) - this gives sorted output
+// 3. Recursively visit right subtree (larger IDs)
+// ALGORITHM: DFS (Depth-First Search) with In-Order traversal
+// TIME COMPLEXITY: O(n) - visits each node exactly once
+// USE CASE: Display all customers in ID order for management view
+void inorderBST(BSTNode *root)
+{
+    if (!root)
+        return;
+    inorderBST(root->left);
+    cout << root->key << ": " << root->name << " | ";
+    inorderBST(root->right);
+}
+
+// =============================================================
+// Graph for Delivery Route Optimization
+// =============================================================
+
+static const int MAX_LOCATIONS = 20;
+int deliveryGraph[MAX_LOCATIONS][MAX_LOCATIONS];
+int locationCount = 0;
+
+struct AdjNode
+{
+    int dest;
+    int weight;
+    AdjNode *next;
+};
+
+AdjNode *adjList[MAX_LOCATIONS];
+
+// The delivery network itself lives in CSR form and may have millions of
+// nodes. The matrix and adjList above mirror it only while it has at most
+// MAX_LOCATIONS nodes, for the small-graph matrix algorithms and displays.
+static const int GRAPH_INF = 1000000000;
+
+// Sum of two path lengths, capped at GRAPH_INF ("unreachable"). Road costs
+// stay below GRAPH_INF, so the sum is taken in 64 bits before capping.
+inline int addPathLengths(int a, int b)
+{
+    return static_cast<int>(min(static_cast<long long>(a) + b, static_cast<long long>(GRAPH_INF)));
+}
+
+static const int DELIVERY_PRINT_LIMIT = 50; // print per-node results up to this size
+// Re-adding a road sets its weight, so the builder keeps the latest copy
+DataStructures::CSRGraphBuilder deliveryBuilder(0, DataStructures::CSRGraphBuilder::KEEP_LATEST);
+DataStructures::CSRGraph deliveryNetwork;
+bool deliveryNetworkDirty = false;
+int deliveryGraphVersion = 0;     // bumped on every change to the CSR network, roads or weights
+int deliveryTopologyVersion = 0;  // bumped when the set of roads changes (CSR rebuilt or replaced)
+int deliveryWeightVersion = 0;    // bumped by weight-only changes (traffic updates)
+int deliveryWeightDropVersion = 0; // deliveryWeightVersion of the last update that made a road cheaper
+bool deliveryBuilderStale = false; // builder is behind the CSR network (prebuilt install or weight patches)
+string deliveryHierarchyFile;      // contraction hierarchy cache, next to the road file; empty = none
+
+// Recent road changes, numbered: roadChangeLog[k] is change number
+// roadChangeBase + k. Each consumer (all-pairs table, kitchen distance
+// tree) keeps the number of the next change it has not applied; one that
+// fell behind the log, or sees a new epoch because the whole network was
+// replaced, recomputes from scratch instead.
+struct RoadChange
+{
+    int u;
+    int v;
+    int oldWeight; // -1 for a new road
+    int newWeight;
+    bool oneWay;   // only u -> v changed; otherwise both directions
+};
+static const size_t ROAD_CHANGE_LOG_LIMIT = 256; // past this a full recompute is cheaper
+deque<RoadChange> roadChangeLog;
+long long roadChangeBase = 0;
+int deliveryTopologyEpoch = 0;
+
+long long roadChangeSerial()
+{
+    return roadChangeBase + static_cast<long long>(roadChangeLog.size());
+}
+
+void recordRoadChange(int u, int v, int oldWeight, int newWeight, bool oneWay = false)
+{
+    roadChangeLog.push_back({u, v, oldWeight, newWeight, oneWay});
+    if (roadChangeLog.size() > ROAD_CHANGE_LOG_LIMIT)
+    {
+        roadChangeLog.pop_front();
+        roadChangeBase++;
+    }
+}
+
+// The whole network was replaced: drop the log and start a new epoch
+void resetRoadChanges()
+{
+    roadChangeBase = roadChangeSerial();
+    roadChangeLog.clear();
+    deliveryTopologyEpoch++;
+}
+
+bool deliveryMatrixActive()
+{
+    return locationCount <= MAX_LOCATIONS;
+}
+
+// Returns the CSR delivery network, rebuilding it once after edge changes
+const DataStructures::CSRGraph &deliveryCSR()
+{
+    if (deliveryNetworkDirty)
+    {
+        deliveryNetwork = deliveryBuilder.build();
+        deliveryNetworkDirty = false;
+        deliveryGraphVersion++;
+        deliveryTopologyVersion++;
+    }
+    return deliveryNetwork;
+}
+
+void initDeliveryGraph(int nodes)
+{
+    locationCount = nodes;
+    deliveryBuilder.reset(nodes);
+    deliveryBuilderStale = false;
+    deliveryNetworkDirty = true;
+    resetRoadChanges();
+    if (!deliveryMatrixActive())
+        return;
+    for (int i = 0; i < nodes; i++)
+    {
+        for (int j = 0; j < nodes; j++)
+        {
+            deliveryGraph[i][j] = (i == j) ? 0 : 99999;
+        }
+        adjList[i] = nullptr;
+    }
+}
+
+// Refills the builder from the CSR network when it fell behind (a network
+// installed already built, or weights patched in place), so road additions
+// apply on top of it (one O(E) copy, only when first needed)
+void ensureDeliveryBuilder()
+{
+    if (!deliveryBuilderStale)
+        return;
+    const DataStructures::CSRGraph &g = deliveryNetwork;
+    deliveryBuilder.reset(g.nodeCount());
+    deliveryBuilder.reserve(static_cast<size_t>(g.arcCount()));
+    for (int u = 0; u < g.nodeCount(); u++)
+        for (const auto *a = g.arcsBegin(u); a != g.arcsEnd(u); ++a)
+            deliveryBuilder.addArc(u, a->to, a->weight);
+    deliveryBuilderStale = false;
+}
+
+// Sets the weight of the AdjNode x -> y, adding the node if it is missing
+void linkAdjacency(int x, int y, int w)
+{
+    for (AdjNode *node = adjList[x]; node; node = node->next)
+    {
+        if (node->dest == y)
+        {
+            node->weight = w;
+            return;
+        }
+    }
+    AdjNode *node = new AdjNode();
+    node->dest = y;
+    node->weight = w;
+    node->next = adjList[x];
+    adjList[x] = node;
+}
+
+// UPDATE DELIVERY EDGE WEIGHT FUNCTION: Changes the travel cost of an existing road
+// HOW IT WORKS:
+// 1. Patch the weight in place: CSR network (each direction the road has,
+//    no rebuild), matrix and adjacency lists
+// 2. Log the change with its old weight, so the all-pairs table and the
+//    kitchen distance tree repair only what it affects
+// 3. Leave the builder behind (marked stale) rather than queueing the new
+//    weight in it; the next road addition reseeds it from the CSR network
+// 4. Bump the weight version, not the topology one: component labels stay,
+//    landmark bounds stay valid unless a road got cheaper, and the
+//    contraction hierarchy can be re-customised in its old node order
+// TIME COMPLEXITY: O(log degree), O(degree) on the small-graph lists
+// Returns false if there is no road from u to v
+bool updateDeliveryEdgeWeight(int u, int v, int w)
+{
+    const DataStructures::CSRGraph &g = deliveryCSR();
+    if (u < 0 || v < 0 || u >= g.nodeCount() || v >= g.nodeCount() || w < 0 || w >= GRAPH_INF)
+    {
+        Core::Logger::log(Core::LogLevel::WARNING, "Invalid road update " + to_string(u) + " - " + to_string(v) + " (cost " + to_string(w) + ")");
+        return false;
+    }
+    int forward = g.arcWeight(u, v), backward = g.arcWeight(v, u);
+    if (forward < 0)
+    {
+        Core::Logger::log(Core::LogLevel::WARNING, "No road from " + to_string(u) + " to " + to_string(v));
+        return false;
+    }
+    if (forward == w && (backward < 0 || backward == w))
+        return true;
+    deliveryNetwork.setArcWeight(u, v, w);
+    if (backward >= 0)
+        deliveryNetwork.setArcWeight(v, u, w);
+    deliveryBuilderStale = true;
+    deliveryGraphVersion++;
+    deliveryWeightVersion++;
+    if (w < forward || (backward >= 0 && w < backward))
+        deliveryWeightDropVersion = deliveryWeightVersion;
+    if (backward == forward)
+        recordRoadChange(u, v, forward, w);
+    else
+    {
+        recordRoadChange(u, v, forward, w, true);
+        if (backward >= 0)
+            recordRoadChange(v, u, backward, w, true);
+    }
+    if (!deliveryMatrixActive())
+        return true;
+    deliveryGraph[u][v] = w;
+    linkAdjacency(u, v, w);
+    if (backward >= 0)
+    {
+        deliveryGraph[v][u] = w;
+        linkAdjacency(v, u, w);
+    }
+    return true;
+}
+
+// ADD DELIVERY EDGE FUNCTION: Two-way road u - v with travel cost w
+// Adding a road that already exists sets its weight: the matrix, the
+// adjacency lists and the CSR network all keep the latest value.
+void addDeliveryEdge(int u, int v, int w)
+{
+    if (u == v || u < 0 || v < 0)
+        return;
+    if (w < 0 || w >= GRAPH_INF)
+    {
+        Core::Logger::log(Core::LogLevel::WARNING, "Invalid road " + to_string(u) + " - " + to_string(v) + " (cost " + to_string(w) + ")");
+        return;
+    }
+    if (!deliveryNetworkDirty && u >= 0 && v >= 0 && u < deliveryNetwork.nodeCount() && v < deliveryNetwork.nodeCount() &&
+        deliveryNetwork.arcWeight(u, v) >= 0 && deliveryNetwork.arcWeight(v, u) >= 0)
+    {
+        updateDeliveryEdgeWeight(u, v, w);
+        return;
+    }
+    ensureDeliveryBuilder();
+    deliveryBuilder.addEdge(u, v, w);
+    if (deliveryMatrixActive())
+        recordRoadChange(u, v, deliveryGraph[u][v] == 99999 ? -1 : deliveryGraph[u][v], w);
+    else if (deliveryNetworkDirty || (u < deliveryNetwork.nodeCount() && v < deliveryNetwork.nodeCount() &&
+                                      (deliveryNetwork.arcWeight(u, v) >= 0 || deliveryNetwork.arcWeight(v, u) >= 0)))
+        resetRoadChanges(); // old weight unknown (not built yet) or one-way: recompute from scratch
+    else
+        recordRoadChange(u, v, -1, w);
+    deliveryNetworkDirty = true;
+    if (!deliveryMatrixActive())
+        return;
+    deliveryGraph[u][v] = w;
+    deliveryGraph[v][u] = w;
+    linkAdjacency(u, v, w);
+    linkAdjacency(v, u, w);
+}
+
+// Rebuilds the matrix and adjacency-list view from the CSR network after the
+// whole network was replaced; only small networks (<= MAX_LOCATIONS) have one
+void refreshDeliveryMirror()
+{
+    if (!deliveryMatrixActive())
+        return;
+    const DataStructures::CSRGraph &g = deliveryCSR();
+    for (int i = 0; i < locationCount; i++)
+    {
+        for (int j = 0; j < locationCount; j++)
+            deliveryGraph[i][j] = (i == j) ? 0 : 99999;
+        adjList[i] = nullptr;
+        for (const auto *a = g.arcsBegin(i); a != g.arcsEnd(i); ++a)
+        {
+            deliveryGraph[i][a->to] = a->weight;
+            AdjNode *node = new AdjNode();
+            node->dest = a->to;
+            node->weight = a->weight;
+            node->next = adjList[i];
+            adjList[i] = node;
+        }
+    }
+}
+
+// Replaces the delivery network with a prebuilt edge set (e.g. a city road graph)
+void installDeliveryNetwork(DataStructures::CSRGraphBuilder &&builder)
+{
+    locationCount = builder.nodeCount();
+    deliveryBuilder = move(builder);
+    deliveryBuilder.setDuplicatePolicy(DataStructures::CSRGraphBuilder::KEEP_LATEST);
+    deliveryBuilderStale = false;
+    deliveryNetworkDirty = true;
+    deliveryHierarchyFile.clear();
+    resetRoadChanges();
+    refreshDeliveryMirror();
+}
+
+// Installs an already built network (e.g. one read from a road file); the
+// matrix view is refreshed when it is small enough to have one
+void installDeliveryNetwork(DataStructures::CSRGraph &&graph)
+{
+    locationCount = graph.nodeCount();
+    deliveryNetwork = move(graph);
+    deliveryNetworkDirty = false;
+    deliveryBuilderStale = true;
+    deliveryGraphVersion++;
+    deliveryTopologyVersion++;
+    deliveryHierarchyFile.clear();
+    resetRoadChanges();
+    refreshDeliveryMirror();
+}
+
+// SYNTHETIC ROAD NETWORK GENERATOR: Street grid for large-graph demos and benchmarks
+// HOW IT WORKS:
+// 1. Lay nodes out on a side x side grid, node id = row * side + col
+// 2. Join horizontal/vertical neighbours as two-way streets, leaving ~8%
+//    of blocks closed so routes must detour
+// 3. Add a few diagonal shortcuts (~3%) to break the grid symmetry
+// 4. Weights are travel costs 10-100, diagonals cost a bit more
+// TIME COMPLEXITY: O(n)
+DataStructures::CSRGraphBuilder generateRoadNetwork(int nodes, unsigned seed)
+{
+    mt19937 gen(seed);
+    uniform_int_distribution<int> cost(10, 100), roll(0, 99);
+    int side = max(1, static_cast<int>(sqrt(static_cast<double>(nodes))));
+    DataStructures::CSRGraphBuilder builder(nodes);
+    builder.reserve(static_cast<size_t>(nodes) * 4);
+    for (int u = 0; u < nodes; u++)
+    {
+        int col = u % side;
+        if (col + 1 < side && u + 1 < nodes && roll(gen) >= 8)
+            builder.addEdge(u, u + 1, cost(gen));
+        if (u + side < nodes && roll(gen) >= 8)
+            builder.addEdge(u, u + side, cost(gen));
+        if (col + 1 < side && u + side + 1 < nodes && roll(gen) < 3)
+            builder.addEdge(u, u + side + 1, cost(gen) + 40);
+    }
+    return builder;
+}
+
+void displayDeliveryGraph()
+{
+    if (!deliveryMatrixActive())
+    {
+        const DataStructures::CSRGraph &g = deliveryCSR();
+        cout << "\nDelivery network (CSR): " << g.nodeCount() << " locations, "
+             << g.arcCount() / 2 << " roads (too large for matrix view)\n";
+        return;
+    }
+    cout << "\nDelivery Location Graph (Adjacency Matrix):\n";
+    for (int i = 0; i < locationCount; i++)
+    {
+        for (int j = 0; j < locationCount; j++)
+        {
+            cout << setw(6) << deliveryGraph[i][j] << " ";
+        }
+        cout << "\n";
+    }
+}
+
+// =============================================================
+// Road Network Loader (memory-mapped DIMACS / edge-list files)
+// =============================================================
+
+// Runs task(worker) on `workers` threads, inline when there is only one
+void runOnWorkers(int workers, const function<void(int)> &task)
+{
+    if (workers <= 1)
+    {
+        task(0);
+        return;
+    }
+    vector<thread> pool;
+    for (int w = 0; w < workers; w++)
+        pool.emplace_back(task, w);
+    for (thread &t : pool)
+        t.join();
+}
+
+int parallelWorkerCount(int jobs)
+{
+    int hardware = static_cast<int>(thread::hardware_concurrency());
+    return max(1, min(jobs, max(1, hardware)));
+}
+
+static const uint32_t ROAD_CACHE_MAGIC = 0x31525352; // "RSR1"
+static const uint32_t ROAD_CACHE_VERSION = 1;
+static const size_t ROAD_PARSE_CHUNK = size_t(8) << 20; // bytes of text per parse worker, at least
+static const int ROAD_MAX_NODES = 1 << 25;               // largest network a road file may declare or imply
+static const long long ROAD_MIN_ID_RANGE = 1024;          // ids an edge list may use regardless of its length
+
+enum class RoadFileFormat
+{
+    AUTO,      // DIMACS if the first record is a c/p/a line, else edge list
+    DIMACS,    // 9th DIMACS challenge .gr: "p sp N M", then "a u v w" arcs, 1-based
+    EDGE_LIST  // "u v [w]" two-way roads, 0-based; '#' or '%' comments; weight defaults to 1
+};
+
+struct RoadLoadStats
+{
+    RoadFileFormat format = RoadFileFormat::AUTO;
+    int nodes = 0;
+    long long records = 0;    // arc / edge lines parsed
+    long long badRecords = 0; // malformed or out-of-range lines, skipped
+    long long arcs = 0;       // in the final graph (after dropping duplicates and self-loops)
+    bool fromCache = false;
+    int workers = 1;
+    double parseMs = 0;
+    double buildMs = 0;
+    double cacheMs = 0; // reading or writing the binary cache
+};
+
+// Read-only view of a whole file: memory-mapped on POSIX systems, read
+// into a buffer elsewhere. Throws FILE_ERROR if the file cannot be opened.
+class MappedFile
+{
+private:
+    const char *bytes = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    vector<char> buffer;
+#else
+    void *mapping = nullptr;
+#endif
+
+public:
+    explicit MappedFile(const string &path)
+    {
+#ifdef _WIN32
+        ifstream file(path, ios::binary | ios::ate);
+        if (!file.is_open())
+            throw Core::CustomException(Core::ErrorCode::FILE_ERROR, "Cannot open file: " + path);
+        buffer.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(buffer.data(), buffer.size());
+        bytes = buffer.data();
+        length = buffer.size();
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw Core::CustomException(Core::ErrorCode::FILE_ERROR, "Cannot open file: " + path);
+        struct stat info;
+        if (fstat(fd, &info) != 0)
+        {
+            close(fd);
+            throw Core::CustomException(Core::ErrorCode::FILE_ERROR, "Cannot stat file: " + path);
+        }
+        length = static_cast<size_t>(info.st_size);
+        if (length > 0)
+        {
+            mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED)
+            {
+                mapping = nullptr;
+                close(fd);
+                throw Core::CustomException(Core::ErrorCode::FILE_ERROR, "Cannot map file: " + path);
+            }
+            madvise(mapping, length, MADV_SEQUENTIAL);
+            bytes = static_cast<const char *>(mapping);
+        }
+        close(fd); // the mapping stays valid
+#endif
+    }
+
+    ~MappedFile()
+    {
+#ifndef _WIN32
+        if (mapping)
+            munmap(mapping, length);
+#endif
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const char *data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+struct RoadRecord
+{
+    int u;
+    int v;
+    int weight;
+};
+
+// Reads an unsigned decimal after any blanks; false (p unchanged past the
+// blanks) if there is none or it overflows an int
+static inline bool parseRoadInt(const char *&p, const char *end, int &value)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+        p++;
+    if (p == end || *p < '0' || *p > '9')
+        return false;
+    long long x = 0;
+    while (p < end && *p >= '0' && *p <= '9')
+    {
+        x = x * 10 + (*p++ - '0');
+        if (x > numeric_limits<int>::max())
+            return false;
+    }
+    value = static_cast<int>(x);
+    return true;
+}
+
+static inline const char *nextRoadLine(const char *p, const char *end)
+{
+    const void *newline = memchr(p, '\n', end - p);
+    return newline ? static_cast<const char *>(newline) + 1 : end;
+}
+
+// Parses the records in [p, end), which starts at a line start. Ids come
+// out 0-based; maxId tracks the largest one seen. DIMACS arcs naming a node
+// past nodeLimit (the declared node count) are counted as bad.
+static void parseRoadChunk(const char *p, const char *end, RoadFileFormat format, int nodeLimit,
+                           vector<RoadRecord> &out, int &maxId, long long &bad)
+{
+    while (p < end)
+    {
+        const char *line = p;
+        p = nextRoadLine(p, end);
+        while (line < p && (*line == ' ' || *line == '\t'))
+            line++;
+        if (line == p || *line == '\n' || *line == '\r')
+            continue;
+        RoadRecord r{0, 0, 1};
+        if (format == RoadFileFormat::DIMACS)
+        {
+            if (*line != 'a')
+                continue; // comments and the problem line
+            line++;
+            if (!parseRoadInt(line, p, r.u) || !parseRoadInt(line, p, r.v) || !parseRoadInt(line, p, r.weight) ||
+                r.u == 0 || r.v == 0 || r.u > nodeLimit || r.v > nodeLimit)
+            {
+                bad++;
+                continue;
+            }
+            r.u--;
+            r.v--;
+        }
+        else
+        {
+            if (*line == '#' || *line == '%')
+                continue;
+            if (!parseRoadInt(line, p, r.u) || !parseRoadInt(line, p, r.v))
+            {
+                bad++;
+                continue;
+            }
+            parseRoadInt(line, p, r.weight);
+        }
+        maxId = max(maxId, max(r.u, r.v));
+        out.push_back(r);
+    }
+}
+
+// PARALLEL CSR BUILD FUNCTION: CSRGraphBuilder::build on worker threads
+// HOW IT WORKS:
+// 1. Count arcs per source with atomic counters, prefix-sum into offsets
+// 2. Scatter arcs into their rows through atomic per-row cursors (order
+//    inside a row is arbitrary at this point)
+// 3. Sort each row by (destination, weight) and keep the cheapest arc per
+//    destination; rows are split between workers by arc count
+// 4. Close the gaps left by dropped duplicates (skipped when there are none)
+// TIME COMPLEXITY: O((V + E) / workers + sum(deg log deg) / workers)
+DataStructures::CSRGraph buildCSRInParallel(int n, const vector<vector<RoadRecord>> &parts, bool twoWay, int workers)
+{
+    using Arc = DataStructures::CSRGraph::Arc;
+    int p = static_cast<int>(parts.size());
+    auto keep = [n](const RoadRecord &r) { return r.u != r.v && r.u < n && r.v < n; };
+
+    vector<atomic<int>> cursor(n + 1);
+    // Returns the old count; a lone worker skips the locked add
+    auto bump = [&cursor, workers](int u) {
+        if (workers > 1)
+            return cursor[u].fetch_add(1, memory_order_relaxed);
+        int old = cursor[u].load(memory_order_relaxed);
+        cursor[u].store(old + 1, memory_order_relaxed);
+        return old;
+    };
+    runOnWorkers(min(workers, p), [&](int w) {
+        for (int k = w; k < p; k += workers)
+            for (const RoadRecord &r : parts[k])
+            {
+                if (!keep(r))
+                    continue;
+                bump(r.u);
+                if (twoWay)
+                    bump(r.v);
+            }
+    });
+    vector<int> offsets(n + 1, 0);
+    for (int u = 0; u < n; u++)
+    {
+        offsets[u + 1] = offsets[u] + cursor[u].load(memory_order_relaxed);
+        cursor[u].store(offsets[u], memory_order_relaxed);
+    }
+
+    vector<Arc> arcs(offsets[n]);
+    runOnWorkers(min(workers, p), [&](int w) {
+        for (int k = w; k < p; k += workers)
+            for (const RoadRecord &r : parts[k])
+            {
+                if (!keep(r))
+                    continue;
+                arcs[bump(r.u)] = {r.v, r.weight};
+                if (twoWay)
+                    arcs[bump(r.v)] = {r.u, r.weight};
+            }
+    });
+
+    // Row ranges with about the same number of arcs each
+    vector<int> bounds(workers + 1, n);
+    bounds[0] = 0;
+    for (int w = 1; w < workers; w++)
+        bounds[w] = static_cast<int>(lower_bound(offsets.begin(), offsets.end(), static_cast<long long>(offsets[n]) * w / workers) - offsets.begin());
+    vector<int> kept(n, 0);
+    runOnWorkers(workers, [&](int w) {
+        for (int u = bounds[w]; u < bounds[w + 1] && u < n; u++)
+        {
+            Arc *first = arcs.data() + offsets[u], *last = arcs.data() + offsets[u + 1];
+            sort(first, last, [](const Arc &a, const Arc &b) { return a.to != b.to ? a.to < b.to : a.weight < b.weight; });
+            Arc *out = first;
+            for (Arc *it = first; it != last; ++it)
+                if (out == first || (out - 1)->to != it->to)
+                    *out++ = *it;
+            kept[u] = static_cast<int>(out - first);
+        }
+    });
+
+    int total = 0;
+    for (int u = 0; u < n; u++)
+        total += kept[u];
+    if (total != offsets[n])
+    {
+        int out = 0;
+        for (int u = 0; u < n; u++)
+        {
+            if (out != offsets[u])
+                memmove(arcs.data() + out, arcs.data() + offsets[u], sizeof(Arc) * kept[u]);
+            offsets[u] = out;
+            out += kept[u];
+        }
+        offsets[n] = out;
+        arcs.resize(out);
+        arcs.shrink_to_fit();
+    }
+    return DataStructures::CSRGraph(move(offsets), move(arcs));
+}
+
+// Size and modification time of the source file, stored in the cache so a
+// changed road file is parsed again
+static pair<uint64_t, int64_t> roadFileStamp(const string &path)
+{
+    uint64_t size = static_cast<uint64_t>(filesystem::file_size(path));
+    int64_t modified = static_cast<int64_t>(filesystem::last_write_time(path).time_since_epoch().count());
+    return {size, modified};
+}
+
+// SAVE ROAD CACHE FUNCTION: Binary copy of a parsed road graph
+// Layout: magic, version, source size, source mtime, node count, arc count,
+// graph fingerprint, row offsets, then (to, weight) arcs
+void saveRoadCache(const string &filename, const DataStructures::CSRGraph &g, pair<uint64_t, int64_t> stamp)
+{
+    ofstream file(filename, ios::binary);
+    if (!file.is_open())
+        throw Core::CustomException(Core::ErrorCode::FILE_ERROR, "Cannot open file: " + filename);
+    uint32_t header[2] = {ROAD_CACHE_MAGIC, ROAD_CACHE_VERSION};
+    int64_t counts[2] = {g.nodeCount(), g.arcCount()};
+    uint64_t fingerprint = g.fingerprint();
+    file.write(reinterpret_cast<const char *>(header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(&stamp.first), sizeof(stamp.first));
+    file.write(reinterpret_cast<const char *>(&stamp.second), sizeof(stamp.second));
+    file.write(reinterpret_cast<const char *>(counts), sizeof(counts));
+    file.write(reinterpret_cast<const char *>(&fingerprint), sizeof(fingerprint));
+    file.write(reinterpret_cast<const char *>(g.rowOffsets().data()), sizeof(int) * g.rowOffsets().size());
+    file.write(reinterpret_cast<const char *>(g.arcList().data()), sizeof(DataStructures::CSRGraph::Arc) * g.arcList().size());
+    if (!file)
+        throw Core::CustomException(Core::ErrorCode::FILE_ERROR, "Cannot write road cache: " + filename);
+}
+
+// LOAD ROAD CACHE FUNCTION: Maps the cache and copies it out; false if it
+// belongs to another version of the source file. Throws FILE_ERROR if it
+// is unreadable or inconsistent.
+bool loadRoadCache(const string &filename, pair<uint64_t, int64_t> stamp, DataStructures::CSRGraph &g)
+{
+    MappedFile file(filename);
+    const size_t headerBytes = 2 * sizeof(uint32_t) + sizeof(uint64_t) + sizeof(int64_t) + 2 * sizeof(int64_t) + sizeof(uint64_t);
+    if (file.size() < headerBytes)
+        throw Core::CustomException(Core::ErrorCode::FILE_ERROR, "Not a road cache file: " + filename);
+    const char *p = file.data();
+    uint32_t header[2];
+    uint64_t size, fingerprint;
+    int64_t modified, counts[2];
+    memcpy(header, p, sizeof(header));
+    p += sizeof(header);
+    memcpy(&size, p, sizeof(size));
+    p += sizeof(size);
+    memcpy(&modified, p, sizeof(modified));
+    p += sizeof(modified);
+    memcpy(counts, p, sizeof(counts));
+    p += sizeof(counts);
+    memcpy(&fingerprint, p, sizeof(fingerprint));
+    p += sizeof(fingerprint);
+    if (header[0] != ROAD_CACHE_MAGIC)
+        throw Core::CustomException(Core::ErrorCode::FILE_ERROR, "Not a road cache file: " + filename);
+    if (header[1] != ROAD_CACHE_VERSION || size != stamp.first || modified != stamp.second)
+        return false;
+    int64_t nodes = counts[0], arcCount = counts[1];
+    if (nodes < 0 || arcCount < 0 || nodes > numeric_limits<int>::max() || arcCount > numeric_limits<int>::max() ||
+        file.size() != headerBytes + sizeof(int) * (nodes + 1) + sizeof(DataStructures::CSRGraph::Arc) * arcCount)
+        throw Core::CustomException(Core::ErrorCode::FILE_ERROR, "Truncated road cache file: " + filename);
+
+    vector<int> offsets(nodes + 1);
+    vector<DataStructures::CSRGraph::Arc> arcs(arcCount);
+    memcpy(offsets.data(), p, sizeof(int) * offsets.size());
+    p += sizeof(int) * offsets.size();
+    memcpy(arcs.data(), p, sizeof(DataStructures::CSRGraph::Arc) * arcs.size());
+    // Bounds only: the fingerprint in the header is trusted, not recomputed
+    bool consistent = offsets[0] == 0 && offsets[nodes] == arcCount;
+    for (int64_t u = 0; u < nodes && consistent; u++)
+        consistent = offsets[u] <= offsets[u + 1];
+    for (size_t k = 0; k < arcs.size() && consistent; k++)
+        consistent = arcs[k].to >= 0 && arcs[k].to < nodes;
+    if (!consistent)
+        throw Core::CustomException(Core::ErrorCode::FILE_ERROR, "Corrupt road cache file: " + filename);
+    g = DataStructures::CSRGraph(move(offsets), move(arcs), fingerprint);
+    return true;
+}
+
+// READ ROAD FILE FUNCTION: Parses a road graph file into a CSR graph
+// HOW IT WORKS:
+// 1. Memory-map the file (no iostreams; the OS pages it in as we go)
+// 2. Detect the format, and for DIMACS read the node count from "p sp"
+// 3. Split the text into one chunk per worker at line boundaries and parse
+//    the chunks in parallel with a hand-written integer scanner
+// 4. Build the CSR graph in parallel (buildCSRInParallel)
+// TIME COMPLEXITY: O(file bytes / workers + build)
+// Throws FILE_ERROR if the file cannot be read
+DataStructures::CSRGraph readRoadFile(const string &path, RoadFileFormat format, RoadLoadStats &stats)
+{
+    auto start = chrono::steady_clock::now();
+    MappedFile file(path);
+    const char *begin = file.data(), *end = begin + file.size();
+
+    int declaredNodes = -1;
+    for (const char *p = begin; p < end;)
+    {
+        const char *line = p;
+        p = nextRoadLine(p, end);
+        while (line < p && (*line == ' ' || *line == '\t'))
+            line++;
+        if (line == p || *line == '\n' || *line == '\r' || *line == '#' || *line == '%')
+            continue;
+        if (format == RoadFileFormat::AUTO)
+            format = (*line == 'c' || *line == 'p' || *line == 'a') ? RoadFileFormat::DIMACS : RoadFileFormat::EDGE_LIST;
+        if (format == RoadFileFormat::EDGE_LIST || *line == 'a')
+            break;
+        if (*line == 'p')
+        {
+            const char *q = line + 1;
+            while (q < p && (*q == ' ' || *q == '\t'))
+                q++;
+            while (q < p && *q >= 'a' && *q <= 'z')
+                q++; // problem type, e.g. "sp"
+            int arcs = 0;
+            if (!parseRoadInt(q, p, declaredNodes) || !parseRoadInt(q, p, arcs))
+                throw Core::CustomException(Core::ErrorCode::FILE_ERROR, "Bad DIMACS problem line in " + path);
+            if (declaredNodes > ROAD_MAX_NODES)
+                throw Core::CustomException(Core::ErrorCode::FILE_ERROR, "DIMACS node count " + to_string(declaredNodes) +
+                                                                         " exceeds " + to_string(ROAD_MAX_NODES) + " in " + path);
+            break;
+        }
+    }
+    if (format == RoadFileFormat::AUTO)
+        format = RoadFileFormat::EDGE_LIST; // empty file
+    stats.format = format;
+
+    int workers = parallelWorkerCount(static_cast<int>(file.size() / ROAD_PARSE_CHUNK) + 1);
+    stats.workers = workers;
+    vector<const char *> cuts(workers + 1, end);
+    cuts[0] = begin;
+    for (int w = 1; w < workers; w++)
+    {
+        const char *guess = begin + file.size() / workers * w;
+        cuts[w] = max(cuts[w - 1], guess == begin ? begin : nextRoadLine(guess - 1, end));
+    }
+    vector<vector<RoadRecord>> parts(workers);
+    vector<int> maxIds(workers, -1);
+    vector<long long> bad(workers, 0);
+    // DIMACS arcs past the declared count are malformed; edge list ids are
+    // checked against the record count below, once it is known
+    int nodeLimit = declaredNodes >= 0 ? declaredNodes : numeric_limits<int>::max();
+    runOnWorkers(workers, [&](int w) {
+        parts[w].reserve((cuts[w + 1] - cuts[w]) / 12);
+        parseRoadChunk(cuts[w], cuts[w + 1], format, nodeLimit, parts[w], maxIds[w], bad[w]);
+    });
+    for (int w = 0; w < workers; w++)
+    {
+        stats.records += static_cast<long long>(parts[w].size());
+        stats.badRecords += bad[w];
+    }
+    long long n = declaredNodes;
+    if (declaredNodes < 0)
+    {
+        // n records touch at most 2n distinct ids; anything far past that is a
+        // stray id that would size the graph (and its allocation) on its own
+        n = static_cast<long long>(*max_element(maxIds.begin(), maxIds.end())) + 1;
+        long long limit = min(static_cast<long long>(ROAD_MAX_NODES), max(2 * stats.records, ROAD_MIN_ID_RANGE));
+        if (n > limit)
+            throw Core::CustomException(Core::ErrorCode::FILE_ERROR, "Location id " + to_string(n - 1) + " in " + path +
+                                                                     " exceeds the limit of " + to_string(limit - 1) +
+                                                                     " for " + to_string(stats.records) + " roads");
+    }
+    stats.parseMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    DataStructures::CSRGraph g = buildCSRInParallel(static_cast<int>(n), parts, format == RoadFileFormat::EDGE_LIST, workers);
+    stats.buildMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    stats.nodes = g.nodeCount();
+    stats.arcs = g.arcCount();
+    return g;
+}
+
+// LOAD ROAD NETWORK FUNCTION: Replaces the delivery network with a road file
+// HOW IT WORKS:
+// 1. If <path>.csr exists and was written for this exact file (same size
+//    and modification time), map it and copy the graph out
+// 2. Otherwise parse the file (readRoadFile) and write the cache for the
+//    next start
+// 3. Install the graph as the delivery network
+// Returns false (and logs why) if the file cannot be loaded
+bool loadRoadNetwork(const string &path, RoadFileFormat format = RoadFileFormat::AUTO, bool useCache = true,
+                     RoadLoadStats *statsOut = nullptr)
+{
+    RoadLoadStats stats;
+    DataStructures::CSRGraph g;
+    const string cachePath = path + ".csr";
+    try
+    {
+        pair<uint64_t, int64_t> stamp = roadFileStamp(path);
+        if (useCache && filesystem::exists(cachePath))
+        {
+            auto start = chrono::steady_clock::now();
+            try
+            {
+                stats.fromCache = loadRoadCache(cachePath, stamp, g);
+            }
+            catch (const Core::CustomException &e)
+            {
+                Core::Logger::log(Core::LogLevel::WARNING, string("Ignoring road cache: ") + e.what());
+            }
+            stats.cacheMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        }
+        if (!stats.fromCache)
+        {
+            g = readRoadFile(path, format, stats);
+            if (stats.badRecords > 0)
+                Core::Logger::log(Core::LogLevel::WARNING, to_string(stats.badRecords) + " malformed lines skipped in " + path);
+            if (useCache)
+            {
+                auto start = chrono::steady_clock::now();
+                try
+                {
+                    saveRoadCache(cachePath, g, stamp);
+                }
+                catch (const Core::CustomException &e)
+                {
+                    Core::Logger::log(Core::LogLevel::WARNING, string("Road cache not written: ") + e.what());
+                }
+                stats.cacheMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            }
+        }
+    }
+    catch (const Core::CustomException &e)
+    {
+        Core::Logger::log(Core::LogLevel::ERROR, string("Road network not loaded: ") + e.what());
+        return false;
+    }
+    catch (const filesystem::filesystem_error &e)
+    {
+        Core::Logger::log(Core::LogLevel::ERROR, string("Road network not loaded: ") + e.what());
+        return false;
+    }
+    catch (const bad_alloc &)
+    {
+        Core::Logger::log(Core::LogLevel::ERROR, "Road network not loaded: out of memory building " + path);
+        return false;
+    }
+    catch (const length_error &e)
+    {
+        Core::Logger::log(Core::LogLevel::ERROR, string("Road network not loaded: ") + e.what());
+        return false;
+    }
+    stats.nodes = g.nodeCount();
+    stats.arcs = g.arcCount();
+    installDeliveryNetwork(move(g));
+    deliveryHierarchyFile = path + ".ch";
+    Core::Logger::log(Core::LogLevel::INFO, "Road network loaded from " + path + (stats.fromCache ? " (cache)" : "") + ": " +
+                      to_string(stats.nodes) + " locations, " + to_string(stats.arcs) + " arcs");
+    if (statsOut)
+        *statsOut = stats;
+    return true;
+}
+
+// =============================================================
+// Location Coordinates & Spatial Index
+// =============================================================
+
+static const int LOCATION_GRID_CELLS = 64; // rider grid cells along the longer side of the map
+
+// Explicit positions from a coordinate file; without one, location id sits
+// at (id % side, id / side), the layout generateRoadNetwork builds roads on
+vector<DataStructures::GeoPoint> deliveryCoordinates;
+int deliveryCoordinatesNodes = -1; // network size the coordinates were loaded for
+int deliveryCoordinatesSerial = 0; // bumped whenever positions change
+
+bool deliveryCoordinatesLoaded()
+{
+    return !deliveryCoordinates.empty() && deliveryCoordinatesNodes == deliveryCSR().nodeCount();
+}
+
+DataStructures::GeoPoint locationPosition(int id)
+{
+    if (deliveryCoordinatesLoaded() && id >= 0 && id < static_cast<int>(deliveryCoordinates.size()))
+        return deliveryCoordinates[id];
+    int side = max(1, static_cast<int>(sqrt(static_cast<double>(deliveryCSR().nodeCount()))));
+    return {static_cast<double>(id % side), static_cast<double>(id / side)};
+}
+
+void setLocationCoordinates(vector<DataStructures::GeoPoint> &&coordinates)
+{
+    deliveryCoordinates = move(coordinates);
+    deliveryCoordinatesNodes = deliveryCSR().nodeCount();
+    deliveryCoordinatesSerial++;
+}
+
+static inline bool parseSignedCoordinate(const char *&p, const char *end, double &value)
+{
+    while (p < end && (*p == ' ' || *p == '\t'))
+        p++;
+    bool negative = p < end && *p == '-';
+    if (negative)
+        p++;
+    int magnitude;
+    if (!parseRoadInt(p, end, magnitude))
+        return false;
+    value = negative ? -static_cast<double>(magnitude) : magnitude;
+    return true;
+}
+
+// LOAD COORDINATES FUNCTION: Reads a DIMACS .co file ("v <id> <x> <y>")
+// for the current road network; locations the file skips keep their grid
+// position. Load the network first, coordinates second.
+bool loadRoadCoordinates(const string &path)
+{
+    int n = deliveryCSR().nodeCount();
+    vector<DataStructures::GeoPoint> coordinates(n);
+    for (int id = 0; id < n; id++)
+        coordinates[id] = locationPosition(id);
+    long long placed = 0, bad = 0;
+    try
+    {
+        MappedFile file(path);
+        const char *p = file.data(), *end = p + file.size();
+        while (p < end)
+        {
+            const char *line = p;
+            p = nextRoadLine(p, end);
+            if (*line != 'v')
+                continue;
+            line++;
+            int id;
+            DataStructures::GeoPoint at;
+            if (!parseRoadInt(line, p, id) || !parseSignedCoordinate(line, p, at.x) || !parseSignedCoordinate(line, p, at.y) ||
+                id < 1 || id > n)
+            {
+                bad++;
+                continue;
+            }
+            coordinates[id - 1] = at; // DIMACS ids are 1-based
+            placed++;
+        }
     }
-    for (int i = 0; i <= n - m; ++i) {
-        if (p == t) {
-            bool match = true;
-            for (int j = 0; j < m; ++j) if (text[i + j] != pat[j]) { match = false; break; }
-            if (match) res.push_back(i);
+    catch (const Core::CustomException &e)
+    {
+        Core::Logger::log(Core::LogLevel::ERROR, string("Coordinates not loaded: ") + e.what());
+        return false;
+    }
+    if (bad > 0)
+        Core::Logger::log(Core::LogLevel::WARNING, to_string(bad) + " malformed coordinate lines skipped in " + path);
+    setLocationCoordinates(move(coordinates));
+    Core::Logger::log(Core::LogLevel::INFO, "Coordinates loaded for " + to_string(placed) + " of " + to_string(n) + " locations");
+    return true;
+}
+
+DataStructures::KDTree deliveryLocationTree;
+int deliveryLocationTreeNodes = -1;
+int deliveryLocationTreeSerial = -1;
+
+// k-d tree over the locations, rebuilt when the network size or the
+// coordinates change (roads alone do not move locations)
+const DataStructures::KDTree &deliveryLocationIndex()
+{
+    int n = deliveryCSR().nodeCount();
+    if (deliveryLocationTreeNodes != n || deliveryLocationTreeSerial != deliveryCoordinatesSerial)
+    {
+        vector<DataStructures::GeoPoint> points(n);
+        for (int id = 0; id < n; id++)
+            points[id] = locationPosition(id);
+        deliveryLocationTree.build(points);
+        deliveryLocationTreeNodes = n;
+        deliveryLocationTreeSerial = deliveryCoordinatesSerial;
+    }
+    return deliveryLocationTree;
+}
+
+// NEAREST LOCATION FUNCTION: Which road node is this address closest to?
+// Returns -1 on an empty network. O(log V) expected
+int nearestDeliveryLocation(const DataStructures::GeoPoint &p)
+{
+    auto best = deliveryLocationIndex().nearest(p, 1);
+    return best.empty() ? -1 : best[0].first;
+}
+
+vector<pair<int, double>> nearestDeliveryLocations(const DataStructures::GeoPoint &p, int k)
+{
+    return deliveryLocationIndex().nearest(p, k);
+}
+
+vector<int> deliveryLocationsWithin(const DataStructures::GeoPoint &p, double radius)
+{
+    return deliveryLocationIndex().within(p, radius);
+}
+
+// Rider positions from the location feed
+DataStructures::UniformGrid riderGrid;
+bool riderGridReady = false;
+
+// Sizes the grid to the map's bounding box on first use; riders outside it
+// still work (they clamp to the border cells), just with fuller cells
+void ensureRiderGrid()
+{
+    if (riderGridReady)
+        return;
+    int n = deliveryCSR().nodeCount();
+    double minX = 0, minY = 0, maxX = 1, maxY = 1;
+    for (int id = 0; id < n; id++)
+    {
+        DataStructures::GeoPoint p = locationPosition(id);
+        if (id == 0 || p.x < minX)
+            minX = p.x;
+        if (id == 0 || p.y < minY)
+            minY = p.y;
+        if (id == 0 || p.x > maxX)
+            maxX = p.x;
+        if (id == 0 || p.y > maxY)
+            maxY = p.y;
+    }
+    riderGrid.reset(minX, minY, maxX, maxY, max(maxX - minX, maxY - minY) / LOCATION_GRID_CELLS);
+    riderGridReady = true;
+}
+
+// RIDER FEED FUNCTION: Applies a batch of (rider, position) reports
+void updateRiderLocations(const vector<DataStructures::UniformGrid::Update> &batch)
+{
+    ensureRiderGrid();
+    riderGrid.apply(batch);
+}
+
+// Rider is off shift or has no position yet: drop them from the index
+bool clearRiderLocation(int riderId)
+{
+    return riderGridReady && riderGrid.remove(riderId);
+}
+
+// (riderId, distance) of the k riders closest to p, closest first
+vector<pair<int, double>> nearestRiders(const DataStructures::GeoPoint &p, int k)
+{
+    if (!riderGridReady)
+        return {};
+    return riderGrid.nearest(p, k);
+}
+
+vector<int> ridersWithin(const DataStructures::GeoPoint &p, double radius)
+{
+    if (!riderGridReady)
+        return {};
+    return riderGrid.within(p, radius);
+}
+
+// =============================================================
+// CSR Graph Kernels (BFS, DFS, Dijkstra, Prim on any graph size)
+// =============================================================
+
+// BFS ORDER FUNCTION: Level-by-level visiting order from start on a CSR graph
+// HOW IT WORKS:
+// 1. The output vector doubles as the FIFO queue (head index walks it)
+// 2. Each dequeued node scans its contiguous arc row and appends unvisited
+//    neighbours
+// ALGORITHM: Queue-based graph traversal
+// TIME COMPLEXITY: O(V+E)
+vector<int> csrBfsOrder(const DataStructures::CSRGraph &g, int start)
+{
+    vector<int> order;
+    if (start < 0 || start >= g.nodeCount())
+        return order;
+    vector<char> visited(g.nodeCount(), 0);
+    visited[start] = 1;
+    order.push_back(start);
+    for (size_t head = 0; head < order.size(); head++)
+    {
+        int u = order[head];
+        for (const auto *a = g.arcsBegin(u); a != g.arcsEnd(u); ++a)
+        {
+            if (!visited[a->to])
+            {
+                visited[a->to] = 1;
+                order.push_back(a->to);
+            }
         }
-        if (i < n - m) {
-            t = (base * (t - text[i] * h % mod + mod) + text[i + m]) % mod;
+    }
+    return order;
+}
+
+// DFS ORDER FUNCTION: Depth-first preorder from start on a CSR graph
+// HOW IT WORKS:
+// 1. An explicit stack holds (node, next arc position) frames, replacing
+//    the call stack so million-node paths cannot overflow it
+// 2. The top frame advances to its next unvisited neighbour and pushes it;
+//    a frame with no arcs left is popped (backtrack)
+// 3. Visits nodes in the same order as the recursive formulation
+// ALGORITHM: Iterative stack-based graph traversal
+// TIME COMPLEXITY: O(V+E)
+vector<int> csrDfsOrder(const DataStructures::CSRGraph &g, int start)
+{
+    vector<int> order;
+    if (start < 0 || start >= g.nodeCount())
+        return order;
+    vector<char> visited(g.nodeCount(), 0);
+    vector<pair<int, int>> stack;
+    visited[start] = 1;
+    order.push_back(start);
+    stack.push_back({start, g.rowOffsets()[start]});
+    const auto &arcs = g.arcList();
+    while (!stack.empty())
+    {
+        auto &frame = stack.back();
+        int end = g.rowOffsets()[frame.first + 1];
+        while (frame.second < end && visited[arcs[frame.second].to])
+            frame.second++;
+        if (frame.second == end)
+        {
+            stack.pop_back();
+            continue;
         }
+        int v = arcs[frame.second++].to;
+        visited[v] = 1;
+        order.push_back(v);
+        stack.push_back({v, g.rowOffsets()[v]});
     }
-    return res;
+    return order;
 }
 
-// ---------- Greedy Coin Change (canonical systems) ----------
-// Returns counts per denom; assumes denoms sorted descending & canonical
-// GREEDY COIN CHANGE FUNCTION: Gives change using minimum coins (greedy approach)
+static const int BFS_ALPHA = 14;                     // go bottom-up once frontier arcs > unexplored arcs / ALPHA
+static const int BFS_BETA = 24;                      // back to top-down once the frontier < V / BETA and shrinking
+static const long long BFS_PARALLEL_GRAIN = 1 << 15; // arcs in a step before extra threads pay off
+
+// FRONTIER BFS: Direction-optimizing breadth-first search with bitmap sets
 // HOW IT WORKS:
-// 1. For each denomination in descending order:
-//    a. Calculate how many coins of this denomination to use
-//    b. Subtract from remaining amount
-// 2. Continue until entire amount distributed
-// 3. Return count for each denomination
-// NOTE: Works correctly ONLY for canonical coin systems (like real currency)
-// ALGORITHM: Greedy selection - pick largest coins first
-// TIME COMPLEXITY: O(m) where m is number of denominations
-// CONSTRAINTS: Fails for non-canonical systems (e.g., coins {1,3,4} amount=6 → greedy gives 3, optimal is 2)
-// USE CASE: Calculate change in currency transactions
-vector<int> greedyChange(int amount, const vector<int>& denoms) {
-    vector<int> take(denoms.size(), 0);
-    for (size_t i = 0; i < denoms.size(); ++i) {
-        take[i] = amount / denoms[i];
-        amount %= denoms[i];
+// 1. Visited nodes and the bottom-up frontiers are bitmaps (one bit per
+//    node, 64 per word), so membership tests touch 1/32 of the memory an
+//    int array would
+// 2. Top-down step: every frontier node scans its arcs and claims unvisited
+//    neighbours with an atomic bit set (workers split the frontier)
+// 3. Bottom-up step: every unvisited node scans its incoming arcs and stops
+//    at the first parent found in the frontier (workers own whole bitmap
+//    words, so no atomics); cheap once the frontier holds much of the graph
+// 4. Switch to bottom-up when the frontier's arcs exceed 1/ALPHA of the
+//    arcs still unexplored, and back when the frontier falls under
+//    V/BETA nodes while shrinking (Beamer's heuristic)
+// 5. Visited state survives between runs until reset(), so repeated runs
+//    from fresh seeds label connected components in O(V + E) overall
+// ALGORITHM: Direction-optimizing BFS
+// TIME COMPLEXITY: O(V + E) worst case; bottom-up levels often skip most
+//                  arcs on low-diameter graphs
+// USE CASE: Reachability, components and hop distances on large networks
+class FrontierBFS
+{
+public:
+    struct Stats
+    {
+        int levels = 0;
+        int topDownSteps = 0;
+        int bottomUpSteps = 0;
+        long long reached = 0;
+        long long arcsScanned = 0;
+    };
+
+private:
+    const DataStructures::CSRGraph *g = nullptr;
+    const DataStructures::CSRGraph *rev = nullptr; // incoming arcs; nullptr when g is symmetric
+    bool undirected = false;                       // also follow arcs backwards (weak connectivity)
+    bool switching = true;
+    int n = 0;
+    int workers = 1;
+    long long totalArcs = 0;
+    struct Visit
+    {
+        int level = -1;  // -1 until visited
+        int parent = -1; // -1 for sources
+    };
+    vector<Visit> visits; // level and parent side by side: one cache miss per discovery
+    vector<atomic<uint64_t>> visited;
+    vector<uint64_t> frontierBits, nextBits;
+    vector<int> frontier, order;
+    vector<vector<int>> localNext;
+    Stats stats;
+
+    const DataStructures::CSRGraph &incoming() const { return rev ? *rev : *g; }
+
+    int arcsOf(int x) const
+    {
+        int d = g->degree(x);
+        if (undirected && rev)
+            d += rev->degree(x);
+        return d;
     }
-    return take; // If amount > 0, greedy failed (non-canonical system)
+
+    bool isVisited(int v) const { return (visited[v >> 6].load(memory_order_relaxed) >> (v & 63)) & 1; }
+
+    // Sets v's visited bit; only one caller wins. Single-threaded steps skip
+    // the locked read-modify-write.
+    bool claim(int v, bool shared)
+    {
+        uint64_t bit = uint64_t(1) << (v & 63);
+        uint64_t word = visited[v >> 6].load(memory_order_relaxed);
+        if (word & bit)
+            return false;
+        if (!shared)
+        {
+            visited[v >> 6].store(word | bit, memory_order_relaxed);
+            return true;
+        }
+        return !(visited[v >> 6].fetch_or(bit, memory_order_relaxed) & bit);
+    }
+
+    // Gathers the workers' next frontiers; returns the arcs they hold
+    long long collectFrontier(int threads, long long arcs)
+    {
+        if (threads == 1)
+        {
+            frontier.swap(localNext[0]);
+            return arcs;
+        }
+        frontier.clear();
+        for (int w = 0; w < threads; w++)
+            frontier.insert(frontier.end(), localNext[w].begin(), localNext[w].end());
+        return arcs;
+    }
+
+    // Both steps return the arc count of the new frontier
+    long long topDownStep(int level, int threads)
+    {
+        int f = static_cast<int>(frontier.size());
+        bool shared = threads > 1;
+        atomic<long long> scanned(0), nextArcs(0);
+        runOnWorkers(threads, [&](int w) {
+            vector<int> &out = localNext[w];
+            out.clear();
+            long long arcs = 0, found = 0;
+            auto visit = [&](int x, int y) {
+                if (claim(y, shared))
+                {
+                    visits[y] = {level, x};
+                    out.push_back(y);
+                    found += arcsOf(y);
+                }
+            };
+            for (int i = static_cast<int>(static_cast<long long>(f) * w / threads); i < static_cast<long long>(f) * (w + 1) / threads; i++)
+            {
+                int x = frontier[i];
+                for (const auto *a = g->arcsBegin(x); a != g->arcsEnd(x); ++a)
+                    visit(x, a->to);
+                arcs += g->degree(x);
+                if (undirected && rev)
+                {
+                    for (const auto *a = rev->arcsBegin(x); a != rev->arcsEnd(x); ++a)
+                        visit(x, a->to);
+                    arcs += rev->degree(x);
+                }
+            }
+            scanned += arcs;
+            nextArcs += found;
+        });
+        stats.arcsScanned += scanned;
+        stats.topDownSteps++;
+        return collectFrontier(threads, nextArcs);
+    }
+
+    long long bottomUpStep(int level, int threads)
+    {
+        int words = static_cast<int>(visited.size());
+        atomic<long long> scanned(0), nextArcs(0);
+        runOnWorkers(threads, [&](int w) {
+            vector<int> &out = localNext[w];
+            out.clear();
+            long long arcs = 0, foundArcs = 0;
+            auto inFrontier = [this](int u) { return (frontierBits[u >> 6] >> (u & 63)) & 1; };
+            for (int k = static_cast<int>(static_cast<long long>(words) * w / threads); k < static_cast<long long>(words) * (w + 1) / threads; k++)
+            {
+                uint64_t seen = visited[k].load(memory_order_relaxed), found = 0;
+                if (seen == ~uint64_t(0))
+                    continue;
+                for (int b = 0; b < 64; b++)
+                {
+                    int v = k * 64 + b;
+                    if (v >= n)
+                        break;
+                    if ((seen >> b) & 1)
+                        continue;
+                    int parent = -1;
+                    const DataStructures::CSRGraph &in = incoming();
+                    for (const auto *a = in.arcsBegin(v); a != in.arcsEnd(v) && parent < 0; ++a)
+                    {
+                        arcs++;
+                        if (inFrontier(a->to))
+                            parent = a->to;
+                    }
+                    if (parent < 0 && undirected && rev)
+                        for (const auto *a = g->arcsBegin(v); a != g->arcsEnd(v) && parent < 0; ++a)
+                        {
+                            arcs++;
+                            if (inFrontier(a->to))
+                                parent = a->to;
+                        }
+                    if (parent < 0)
+                        continue;
+                    found |= uint64_t(1) << b;
+                    visits[v] = {level, parent};
+                    out.push_back(v);
+                    foundArcs += arcsOf(v);
+                }
+                if (found)
+                {
+                    visited[k].store(seen | found, memory_order_relaxed); // this worker owns word k
+                    nextBits[k] = found;
+                }
+            }
+            scanned += arcs;
+            nextArcs += foundArcs;
+        });
+        stats.arcsScanned += scanned;
+        frontierBits.swap(nextBits);
+        fill(nextBits.begin(), nextBits.end(), 0);
+        stats.bottomUpSteps++;
+        return collectFrontier(threads, nextArcs);
+    }
+
+public:
+    // reverse: the transposed graph, or nullptr if g is symmetric (every
+    // arc has its twin, as two-way delivery roads do)
+    void bind(const DataStructures::CSRGraph &graph, const DataStructures::CSRGraph *reverse = nullptr, int threads = 0)
+    {
+        g = &graph;
+        rev = reverse;
+        n = graph.nodeCount();
+        workers = threads > 0 ? threads : parallelWorkerCount(n / 65536 + 1);
+        visits.assign(n, Visit());
+        visited = vector<atomic<uint64_t>>((n + 63) / 64);
+        frontierBits.assign(visited.size(), 0);
+        nextBits.assign(visited.size(), 0);
+        localNext.assign(workers, {});
+    }
+
+    // Follow arcs in both directions (weakly connected components)
+    void setUndirected(bool both) { undirected = both; }
+    // false: top-down only, for comparison
+    void setDirectionOptimizing(bool on) { switching = on; }
+
+    void reset()
+    {
+        fill(visits.begin(), visits.end(), Visit());
+        for (auto &word : visited)
+            word.store(0, memory_order_relaxed);
+    }
+
+    // Visits everything reachable from the sources that earlier runs have
+    // not visited; stops after the level that reaches target (if >= 0).
+    // Returns the nodes visited by this run, level by level.
+    const vector<int> &run(const vector<int> &sources, int target = -1)
+    {
+        stats = Stats();
+        order.clear();
+        frontier.clear();
+        totalArcs = g->arcCount() * ((undirected && rev) ? 2 : 1);
+        long long frontierArcs = 0;
+        for (int s : sources)
+            if (s >= 0 && s < n && claim(s, false))
+            {
+                visits[s] = {0, -1};
+                frontier.push_back(s);
+                frontierArcs += arcsOf(s);
+            }
+        long long unexplored = totalArcs;
+        bool bottomUp = false;
+        for (int level = 1; !frontier.empty(); level++)
+        {
+            order.insert(order.end(), frontier.begin(), frontier.end());
+            stats.levels = level;
+            unexplored -= frontierArcs;
+            if (target >= 0 && isVisited(target))
+                break;
+            size_t previous = frontier.size();
+            if (switching && !bottomUp && frontierArcs > unexplored / BFS_ALPHA)
+            {
+                bottomUp = true;
+                fill(frontierBits.begin(), frontierBits.end(), 0);
+                for (int x : frontier)
+                    frontierBits[x >> 6] |= uint64_t(1) << (x & 63);
+            }
+            else if (bottomUp && static_cast<long long>(frontier.size()) * BFS_BETA < n)
+            {
+                bottomUp = false;
+            }
+            long long work = bottomUp ? unexplored : frontierArcs;
+            int threads = work >= BFS_PARALLEL_GRAIN ? workers : 1;
+            frontierArcs = bottomUp ? bottomUpStep(level, threads) : topDownStep(level, threads);
+            if (bottomUp && frontier.size() < previous && static_cast<long long>(frontier.size()) * BFS_BETA < n)
+                bottomUp = false; // frontier shrinking: hand back to top-down
+        }
+        stats.reached = static_cast<long long>(order.size());
+        return order;
+    }
+
+    int level(int v) const { return visits[v].level; }
+    int parent(int v) const { return visits[v].parent; }
+    bool reached(int v) const { return isVisited(v); }
+    const Stats &lastStats() const { return stats; }
+};
+
+// Transposed copy of g (every arc reversed), for backward traversals
+DataStructures::CSRGraph transposeCSR(const DataStructures::CSRGraph &g)
+{
+    int n = g.nodeCount();
+    vector<int> offsets(n + 1, 0);
+    for (const auto &a : g.arcList())
+        offsets[a.to + 1]++;
+    for (int v = 0; v < n; v++)
+        offsets[v + 1] += offsets[v];
+    vector<DataStructures::CSRGraph::Arc> arcs(g.arcList().size());
+    vector<int> cursor(offsets.begin(), offsets.end() - 1);
+    for (int u = 0; u < n; u++) // rows come out sorted by tail
+        for (const auto *a = g.arcsBegin(u); a != g.arcsEnd(u); ++a)
+            arcs[cursor[a->to]++] = {u, a->weight};
+    return DataStructures::CSRGraph(move(offsets), move(arcs));
 }
 
-} // namespace Algorithms
+// True when every arc u -> v has a twin v -> u. O(E log degree)
+bool csrIsSymmetric(const DataStructures::CSRGraph &g)
+{
+    for (int u = 0; u < g.nodeCount(); u++)
+        for (const auto *a = g.arcsBegin(u); a != g.arcsEnd(u); ++a)
+            if (g.arcWeight(a->to, u) < 0)
+                return false;
+    return true;
+}
 
-// =============================================================
-// NAMESPACE: SERVICES (Business Logic Facades)
-// =============================================================
-namespace Services {
-// Service-layer facades would live here; procedural functions below
-// serve the same role within this single-translation-unit design.
+// CONNECTED COMPONENTS FUNCTION: Labels every node with its component
+// HOW IT WORKS: Frontier BFS from each node not yet visited; visited state
+// carries over between runs, so every node and arc is handled once.
+// Directed graphs get weakly connected components (arcs followed both ways).
+// TIME COMPLEXITY: O(V + E)
+struct ComponentLabels
+{
+    vector<int> label; // component id per node, 0-based, largest component not necessarily first
+    vector<int> size;  // nodes per component
+};
+
+ComponentLabels connectedComponents(const DataStructures::CSRGraph &g, const DataStructures::CSRGraph *reverse = nullptr, int workers = 0)
+{
+    ComponentLabels result;
+    result.label.assign(g.nodeCount(), -1);
+    FrontierBFS bfs;
+    bfs.bind(g, reverse, workers);
+    bfs.setUndirected(true);
+    for (int v = 0; v < g.nodeCount(); v++)
+    {
+        if (result.label[v] >= 0)
+            continue;
+        int id = static_cast<int>(result.size.size());
+        const vector<int> &members = bfs.run({v});
+        for (int x : members)
+            result.label[x] = id;
+        result.size.push_back(static_cast<int>(members.size()));
+    }
+    return result;
 }
 
-// =============================================================
-// UTILITY FUNCTIONS (Input Validation)
-// =============================================================
+struct ShortestPathTree
+{
+    vector<int> dist;   // GRAPH_INF when unreachable
+    vector<int> parent; // -1 for the source and unreachable nodes
+};
 
-int readInt(const string &label, int low, int high)
+enum class HeapKind
 {
-    while (true)
+    BINARY,
+    DARY4,
+    RADIX,
+    DIAL
+};
+
+inline string heapKindToString(HeapKind kind)
+{
+    switch (kind)
     {
-        cout << label;
-        int x;
-        if (cin >> x)
+    case HeapKind::BINARY: return "Binary heap";
+    case HeapKind::DARY4: return "4-ary heap";
+    case HeapKind::RADIX: return "Radix heap";
+    case HeapKind::DIAL: return "Dial buckets";
+    default: return "Unknown";
+    }
+}
+
+// SHORTEST PATH ENGINE: Reusable Dijkstra over a CSR graph with a pluggable queue
+// HOW IT WORKS:
+// 1. dist/parent buffers are sized once per graph (bind) and validated by a
+//    generation stamp, so starting a new query is O(1) instead of O(V)
+// 2. The frontier queue is picked per engine:
+//    - BINARY: std heap with lazy deletion (baseline)
+//    - DARY4:  indexed 4-ary heap with true decrease-key
+//    - RADIX:  radix heap, O(1) push, suited to integer weights
+//    - DIAL:   ring of max-weight+1 buckets, best for small weights
+// 3. Point-to-point queries (target >= 0) stop as soon as the target is
+//    settled; only labels on the target's path are final afterwards
+// ALGORITHM: Dijkstra's shortest path (non-negative integer weights)
+// TIME COMPLEXITY: O((V+E) log V) with heaps, O(V + E + maxDistance) with Dial
+// USE CASE: Many route queries against the same delivery network
+class ShortestPathEngine
+{
+private:
+    // std heap on a reusable vector so its capacity survives across queries
+    struct BinaryQueue
+    {
+        vector<pair<int, int>> heap;
+        bool empty() const { return heap.empty(); }
+        void push(int key, int node)
         {
-            if (x >= low && x <= high)
+            heap.push_back({key, node});
+            push_heap(heap.begin(), heap.end(), greater<pair<int, int>>());
+        }
+        pair<int, int> pop()
+        {
+            pop_heap(heap.begin(), heap.end(), greater<pair<int, int>>());
+            pair<int, int> top = heap.back();
+            heap.pop_back();
+            return top;
+        }
+        void clear() { heap.clear(); }
+    };
+
+    const DataStructures::CSRGraph *graph = nullptr;
+    HeapKind kind;
+    vector<int> dist;
+    vector<int> parent;
+    vector<uint32_t> stamp;
+    uint32_t generation = 0;
+    int source = -1;
+    int settledCount = 0;
+    BinaryQueue binaryQueue;
+    DataStructures::IndexedDaryHeap daryHeap;
+    DataStructures::RadixHeap radixHeap;
+    DataStructures::DialBuckets dialBuckets;
+
+    int maxArcWeight = 1;
+
+    void setLabel(int v, int d, int p)
+    {
+        stamp[v] = generation;
+        dist[v] = d;
+        parent[v] = p;
+    }
+
+    template <typename Queue>
+    int search(Queue &queue, int src, int target)
+    {
+        queue.clear();
+        setLabel(src, 0, -1);
+        queue.push(0, src);
+        while (!queue.empty())
+        {
+            auto [d, u] = queue.pop();
+            if (d > dist[u])
+                continue; // stale duplicate left by a lazy queue
+            settledCount++;
+            if (u == target)
+                return d;
+            for (const auto *a = graph->arcsBegin(u); a != graph->arcsEnd(u); ++a)
             {
-                return x;
+                int nd = addPathLengths(d, a->weight);
+                if (nd < distanceTo(a->to))
+                {
+                    setLabel(a->to, nd, u);
+                    queue.push(nd, a->to);
+                }
             }
-            else
+        }
+        return target >= 0 ? GRAPH_INF : 0;
+    }
+
+public:
+    explicit ShortestPathEngine(HeapKind heap = HeapKind::DARY4) : kind(heap) {}
+
+    // Sizes the buffers for g; call again whenever g is rebuilt
+    void bind(const DataStructures::CSRGraph &g)
+    {
+        graph = &g;
+        int n = g.nodeCount();
+        dist.assign(n, GRAPH_INF);
+        parent.assign(n, -1);
+        stamp.assign(n, 0);
+        generation = 0;
+        source = -1;
+        daryHeap.resize(n);
+        maxArcWeight = 1;
+        for (const auto &a : g.arcList())
+            maxArcWeight = max(maxArcWeight, a.weight);
+        if (kind == HeapKind::DIAL)
+            dialBuckets.resize(maxArcWeight);
+    }
+
+    // Dial's ring has one bucket per unit of the heaviest road, so it is
+    // only sized when that queue is selected
+    void setHeap(HeapKind heap)
+    {
+        if (heap == HeapKind::DIAL && kind != HeapKind::DIAL && graph)
+            dialBuckets.resize(maxArcWeight);
+        kind = heap;
+    }
+    HeapKind heap() const { return kind; }
+
+    // Runs from src; with target >= 0 returns its distance (GRAPH_INF if
+    // unreachable) and stops early, otherwise labels every reachable node
+    int run(int src, int target = -1)
+    {
+        settledCount = 0;
+        source = src;
+        if (!graph || src < 0 || src >= graph->nodeCount())
+            return GRAPH_INF;
+        if (++generation == 0)
+        {
+            fill(stamp.begin(), stamp.end(), 0);
+            generation = 1;
+        }
+        switch (kind)
+        {
+        case HeapKind::BINARY: return search(binaryQueue, src, target);
+        case HeapKind::RADIX: return search(radixHeap, src, target);
+        case HeapKind::DIAL: return search(dialBuckets, src, target);
+        case HeapKind::DARY4:
+        default: return search(daryHeap, src, target);
+        }
+    }
+
+    int distanceTo(int v) const { return stamp[v] == generation ? dist[v] : GRAPH_INF; }
+    int parentOf(int v) const { return stamp[v] == generation ? parent[v] : -1; }
+    int settled() const { return settledCount; }
+
+    // Source-to-target node sequence from the last run, empty if unreachable
+    vector<int> pathTo(int target) const
+    {
+        vector<int> path;
+        if (!graph || target < 0 || target >= graph->nodeCount() || distanceTo(target) == GRAPH_INF)
+            return path;
+        for (int v = target; v != -1; v = parentOf(v))
+            path.push_back(v);
+        reverse(path.begin(), path.end());
+        return path;
+    }
+
+    ShortestPathTree tree() const
+    {
+        int n = graph ? graph->nodeCount() : 0;
+        ShortestPathTree result{vector<int>(n), vector<int>(n)};
+        for (int v = 0; v < n; v++)
+        {
+            result.dist[v] = distanceTo(v);
+            result.parent[v] = parentOf(v);
+        }
+        return result;
+    }
+};
+
+// CSR DIJKSTRA FUNCTION: Full single-source shortest path tree over a CSR graph
+// ALGORITHM: Dijkstra with an indexed 4-ary heap (see ShortestPathEngine)
+// TIME COMPLEXITY: O((V+E) log V)
+ShortestPathTree csrDijkstra(const DataStructures::CSRGraph &g, int src, HeapKind heap = HeapKind::DARY4)
+{
+    ShortestPathEngine engine(heap);
+    engine.bind(g);
+    engine.run(src);
+    return engine.tree();
+}
+
+struct SpanningForest
+{
+    vector<int> parent;      // -1 for each component root
+    long long totalCost = 0;
+    int edgeCount = 0;
+    int components = 0;
+};
+
+// CSR PRIM FUNCTION: Minimum spanning forest over a CSR graph
+// HOW IT WORKS:
+// 1. Grow a tree from the lowest-numbered node not yet covered
+// 2. Repeatedly attach the cheapest arc leaving the tree (binary heap with
+//    lazy deletion, keys kept per node)
+// 3. When the heap empties, start a new tree in the next component
+// ALGORITHM: Prim's MST, restarted per connected component
+// TIME COMPLEXITY: O(E log V)
+SpanningForest csrPrimMST(const DataStructures::CSRGraph &g)
+{
+    int n = g.nodeCount();
+    SpanningForest forest;
+    forest.parent.assign(n, -1);
+    vector<int> key(n, GRAPH_INF);
+    vector<char> inTree(n, 0);
+    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
+    for (int root = 0; root < n; root++)
+    {
+        if (inTree[root])
+            continue;
+        forest.components++;
+        key[root] = 0;
+        pq.push({0, root});
+        while (!pq.empty())
+        {
+            auto [k, u] = pq.top();
+            pq.pop();
+            if (inTree[u] || k > key[u])
+                continue;
+            inTree[u] = 1;
+            if (forest.parent[u] != -1)
             {
-                cout << "Value out of range. Expected between " << low << " and " << high << "\n";
+                forest.totalCost += k;
+                forest.edgeCount++;
+            }
+            for (const auto *a = g.arcsBegin(u); a != g.arcsEnd(u); ++a)
+            {
+                if (!inTree[a->to] && a->weight < key[a->to])
+                {
+                    key[a->to] = a->weight;
+                    forest.parent[a->to] = u;
+                    pq.push({a->weight, a->to});
+                }
             }
         }
-        else
+    }
+    return forest;
+}
+
+// One undirected road for the spanning-tree algorithms
+struct WeightedEdge
+{
+    int u;
+    int v;
+    int weight;
+};
+
+// Every road of g once (u < v); one-way arcs and two-way roads whose
+// directions differ in cost are kept as separate candidate edges
+vector<WeightedEdge> csrEdgeList(const DataStructures::CSRGraph &g)
+{
+    vector<WeightedEdge> edges;
+    edges.reserve(g.arcList().size() / 2);
+    for (int u = 0; u < g.nodeCount(); u++)
+        for (const auto *a = g.arcsBegin(u); a != g.arcsEnd(u); ++a)
+            if (u < a->to || g.arcWeight(a->to, u) != a->weight)
+                edges.push_back({u, a->to, a->weight});
+    return edges;
+}
+
+// RADIX SORT FUNCTION: Orders edges by non-negative integer weight
+// HOW IT WORKS: LSD radix sort, 11 bits per pass (3 passes cover 32 bits);
+// passes whose digit is the same for every edge are skipped, so road
+// weights under 2048 sort in a single stable counting pass
+// TIME COMPLEXITY: O(E) per pass, versus O(E log E) comparisons
+void radixSortEdges(vector<WeightedEdge> &edges)
+{
+    const int BITS = 11, BUCKETS = 1 << BITS;
+    vector<WeightedEdge> buffer(edges.size());
+    vector<size_t> count(BUCKETS);
+    for (int shift = 0; shift < 32; shift += BITS)
+    {
+        fill(count.begin(), count.end(), 0);
+        for (const WeightedEdge &e : edges)
+            count[(static_cast<uint32_t>(e.weight) >> shift) & (BUCKETS - 1)]++;
+        if (count[(static_cast<uint32_t>(edges.empty() ? 0 : edges[0].weight) >> shift) & (BUCKETS - 1)] == edges.size())
+            continue; // every edge shares this digit
+        size_t sum = 0;
+        for (size_t &c : count)
         {
-            cout << "Invalid input. Please enter a number.\n";
-            cin.clear();
+            size_t here = c;
+            c = sum;
+            sum += here;
         }
-        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        for (const WeightedEdge &e : edges)
+            buffer[count[(static_cast<uint32_t>(e.weight) >> shift) & (BUCKETS - 1)]++] = e;
+        edges.swap(buffer);
     }
 }
 
-string readLine(const string &label)
+// Turns chosen tree edges into SpanningForest parent links (BFS from the
+// lowest node of each tree), so every MST variant reports the same way
+void rootSpanningForest(int n, const vector<WeightedEdge> &treeEdges, SpanningForest &forest)
 {
-    cout << label;
-    string s;
-    getline(cin >> ws, s);
-    return s;
+    forest.parent.assign(n, -1);
+    forest.edgeCount = static_cast<int>(treeEdges.size());
+    forest.components = n - forest.edgeCount;
+    forest.totalCost = 0;
+    // Tree adjacency by counting sort (no per-row sorting needed)
+    vector<int> offsets(n + 1, 0), next(treeEdges.size() * 2);
+    for (const WeightedEdge &e : treeEdges)
+    {
+        forest.totalCost += e.weight;
+        offsets[e.u + 1]++;
+        offsets[e.v + 1]++;
+    }
+    for (int v = 0; v < n; v++)
+        offsets[v + 1] += offsets[v];
+    vector<int> cursor(offsets.begin(), offsets.end() - 1);
+    for (const WeightedEdge &e : treeEdges)
+    {
+        next[cursor[e.u]++] = e.v;
+        next[cursor[e.v]++] = e.u;
+    }
+    vector<char> seen(n, 0);
+    vector<int> queue;
+    queue.reserve(n);
+    for (int root = 0; root < n; root++)
+    {
+        if (seen[root])
+            continue;
+        seen[root] = 1;
+        queue.assign(1, root);
+        for (size_t head = 0; head < queue.size(); head++)
+        {
+            int x = queue[head];
+            for (int k = offsets[x]; k < offsets[x + 1]; k++)
+                if (!seen[next[k]])
+                {
+                    seen[next[k]] = 1;
+                    forest.parent[next[k]] = x;
+                    queue.push_back(next[k]);
+                }
+        }
+    }
 }
 
-double readFloat(const string &label, double low, double high)
+// KRUSKAL'S MST FUNCTION: Minimum spanning forest from a sorted edge list
+// HOW IT WORKS:
+// 1. List every road once and radix-sort by weight
+// 2. Scan cheapest first; keep an edge when its ends lie in different
+//    disjoint sets (path compression + union by rank), then merge them
+// 3. Stop early once only one set per component can remain (n - 1 edges)
+// ALGORITHM: Kruskal's MST
+// TIME COMPLEXITY: O(E alpha(V)) after the O(E) radix sort
+// USE CASE: Sparse road networks, where it avoids Prim's heap traffic
+SpanningForest csrKruskalMST(const DataStructures::CSRGraph &g)
 {
-    while (true)
+    int n = g.nodeCount();
+    vector<WeightedEdge> edges = csrEdgeList(g);
+    radixSortEdges(edges);
+    DataStructures::DisjointSets sets(n);
+    vector<WeightedEdge> chosen;
+    chosen.reserve(max(0, n - 1));
+    for (const WeightedEdge &e : edges)
     {
-        cout << label;
-        double x;
-        if (cin >> x)
+        if (sets.unite(e.u, e.v))
         {
-            if (x >= low && x <= high)
+            chosen.push_back(e);
+            if (static_cast<int>(chosen.size()) == n - 1)
+                break;
+        }
+    }
+    SpanningForest forest;
+    rootSpanningForest(n, chosen, forest);
+    return forest;
+}
+
+// BORUVKA'S MST FUNCTION: Minimum spanning forest in parallel rounds
+// HOW IT WORKS:
+// 1. Every component picks its cheapest outgoing edge; workers scan slices
+//    of the edge list and lower a packed (weight, edge index) key per
+//    component with an atomic compare-and-swap, the index breaking ties
+//    so picks never close a cycle
+// 2. Merge along the picked edges (disjoint sets, serial: one per component)
+// 3. Relabel edge ends to their new component and drop edges that became
+//    internal, in parallel; each round at least halves the components
+// ALGORITHM: Boruvka's MST
+// TIME COMPLEXITY: O(E log V) work over O(log V) rounds, split across workers
+// USE CASE: Large graphs on multi-core machines
+SpanningForest csrBoruvkaMST(const DataStructures::CSRGraph &g, int workers = 0)
+{
+    int n = g.nodeCount();
+    vector<WeightedEdge> edges = csrEdgeList(g); // original ends, for the result
+    vector<pair<int, int>> ends(edges.size());   // current component of each end
+    vector<uint32_t> live(edges.size());         // indices of edges still between components
+    for (size_t i = 0; i < edges.size(); i++)
+    {
+        ends[i] = {edges[i].u, edges[i].v};
+        live[i] = static_cast<uint32_t>(i);
+    }
+    workers = workers > 0 ? workers : parallelWorkerCount(static_cast<int>(edges.size() / 65536) + 1);
+    const uint64_t NONE = ~uint64_t(0);
+    vector<atomic<uint64_t>> cheapest(n);
+    for (auto &c : cheapest)
+        c.store(NONE, memory_order_relaxed);
+    vector<int> active(n), rootOf(n);
+    iota(active.begin(), active.end(), 0);
+    DataStructures::DisjointSets sets(n);
+    vector<WeightedEdge> chosen;
+    vector<vector<uint32_t>> kept(workers);
+
+    while (!live.empty())
+    {
+        size_t m = live.size();
+        runOnWorkers(workers, [&](int w) {
+            auto lower = [&](int c, uint64_t key) {
+                uint64_t seen = cheapest[c].load(memory_order_relaxed);
+                while (key < seen && !cheapest[c].compare_exchange_weak(seen, key, memory_order_relaxed))
+                {
+                }
+            };
+            for (size_t k = m * w / workers; k < m * (w + 1) / workers; k++)
             {
-                return x;
+                uint32_t i = live[k];
+                uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(edges[i].weight)) << 32) | i;
+                lower(ends[i].first, key);
+                lower(ends[i].second, key);
             }
-            else
+        });
+        for (int c : active)
+        {
+            uint64_t key = cheapest[c].load(memory_order_relaxed);
+            cheapest[c].store(NONE, memory_order_relaxed);
+            if (key == NONE)
+                continue;
+            uint32_t i = static_cast<uint32_t>(key);
+            if (sets.unite(ends[i].first, ends[i].second))
+                chosen.push_back(edges[i]);
+        }
+        size_t next = 0;
+        for (int c : active)
+        {
+            rootOf[c] = sets.find(c);
+            if (rootOf[c] == c)
+                active[next++] = c;
+        }
+        active.resize(next);
+        runOnWorkers(workers, [&](int w) {
+            vector<uint32_t> &out = kept[w];
+            out.clear();
+            for (size_t k = m * w / workers; k < m * (w + 1) / workers; k++)
             {
-                cout << "Value out of range. Expected between " << low << " and " << high << "\n";
+                uint32_t i = live[k];
+                ends[i] = {rootOf[ends[i].first], rootOf[ends[i].second]};
+                if (ends[i].first != ends[i].second)
+                    out.push_back(i);
             }
+        });
+        live.clear();
+        for (const auto &part : kept)
+            live.insert(live.end(), part.begin(), part.end());
+    }
+    SpanningForest forest;
+    rootSpanningForest(n, chosen, forest);
+    return forest;
+}
+
+// DENSE PRIM FUNCTION: Prim's MST over an adjacency matrix
+// HOW IT WORKS: Linear scan for the cheapest key each step (no heap);
+// weight 0 marks "no road", as in the delivery matrix
+// TIME COMPLEXITY: O(V²), best when nearly every pair is connected
+SpanningForest densePrimMST(const int *weights, int stride, int n)
+{
+    SpanningForest forest;
+    forest.parent.assign(n, -1);
+    vector<int> key(n, GRAPH_INF);
+    vector<char> inTree(n, 0);
+    for (int step = 0; step < n; step++)
+    {
+        int u = -1;
+        for (int v = 0; v < n; v++)
+            if (!inTree[v] && (u < 0 || key[v] < key[u]))
+                u = v;
+        if (key[u] == GRAPH_INF)
+        {
+            key[u] = 0; // new tree in another component
+            forest.components++;
         }
         else
         {
-            cout << "Invalid numeric input. Please retry.\n";
-            cin.clear();
+            forest.totalCost += key[u];
+            forest.edgeCount++;
+        }
+        inTree[u] = 1;
+        const int *row = weights + static_cast<size_t>(u) * stride;
+        for (int v = 0; v < n; v++)
+        {
+            if (row[v] && !inTree[v] && row[v] < key[v])
+            {
+                key[v] = row[v];
+                forest.parent[v] = u;
+            }
         }
-        cin.ignore(numeric_limits<streamsize>::max(), '\n');
     }
+    return forest;
 }
 
-// =============================================================
-// GLOBAL DATA STORAGE (Managed by Services layer)
-// NOTE: Static arrays used instead of STL containers
-// to meet academic constraints and ensure predictable memory layout.
-// =============================================================
+void printTraversal(const string &label, int start, const vector<int> &order)
+{
+    cout << label << " traversal from location " << start << ": ";
+    if (static_cast<int>(order.size()) <= DELIVERY_PRINT_LIMIT)
+    {
+        for (int u : order)
+            cout << u << " ";
+    }
+    else
+    {
+        for (int i = 0; i < DELIVERY_PRINT_LIMIT; i++)
+            cout << order[i] << " ";
+        cout << "... (" << order.size() << " locations reached)";
+    }
+    cout << "\n";
+}
 
-static const int MAX_CUSTOMERS = 500;
-Domain::Customer customerRecords[MAX_CUSTOMERS];
-int customerCount = 0;
+// BFS (BREADTH-FIRST SEARCH): Explores delivery graph level-by-level from start location
+// HOW IT WORKS:
+// 1. Mark start vertex as visited and enqueue it
+// 2. While queue is not empty:
+//    a. Dequeue a vertex
+//    b. Print/process it
+//    c. Mark all unvisited neighbors as visited and enqueue them
+// 3. Result: Visits vertices in order of distance from source
+// ALGORITHM: Queue-based graph traversal over the CSR network
+// TIME COMPLEXITY: O(V+E) where V=vertices, E=edges
+// USE CASE: Find all reachable delivery locations from a starting point
+void bfsDelivery(int start)
+{
+    printTraversal("BFS", start, csrBfsOrder(deliveryCSR(), start));
+}
 
-static const int MAX_MENU_ITEMS = 200;
-Domain::MenuItem menuItems[MAX_MENU_ITEMS];
-int menuItemCount = 0;
+// DFS (DEPTH-FIRST SEARCH): Explores delivery graph deeply before backtracking
+// HOW IT WORKS:
+// 1. Mark starting vertex as visited and print it
+// 2. For each adjacent unvisited vertex, go deeper (explicit stack, see
+//    csrDfsOrder)
+// 3. Continues until dead-end, then backtracks to explore other branches
+// ALGORITHM: Iterative stack-based graph traversal over the CSR network
+// TIME COMPLEXITY: O(V+E) where V=vertices, E=edges
+// USE CASE: Detect connectivity, find delivery paths, topological sorting
+void dfsDelivery(int start)
+{
+    printTraversal("DFS", start, csrDfsOrder(deliveryCSR(), start));
+}
 
-static const int MAX_ORDERS = 300;
-Domain::Order orderHeap[MAX_ORDERS];
-int orderHeapSize = 0;
+// Traversal state for the delivery network, rebuilt after network changes.
+// Loaded road files may hold one-way arcs; those networks keep a transposed
+// copy for bottom-up BFS steps and weakly connected components.
+struct DeliveryTraversalCache
+{
+    int version = -1;
+    bool symmetric = true;
+    DataStructures::CSRGraph reverse;
+    ComponentLabels components;
+};
+DeliveryTraversalCache deliveryTraversal;
 
-inline void swapOrder(Domain::Order &a, Domain::Order &b) {
-    swap(a, b);
+DeliveryTraversalCache &deliveryTraversalState()
+{
+    const DataStructures::CSRGraph &g = deliveryCSR();
+    if (deliveryTraversal.version != deliveryTopologyVersion)
+    {
+        deliveryTraversal.symmetric = csrIsSymmetric(g);
+        deliveryTraversal.reverse = deliveryTraversal.symmetric ? DataStructures::CSRGraph() : transposeCSR(g);
+        deliveryTraversal.components = connectedComponents(g, deliveryTraversal.symmetric ? nullptr : &deliveryTraversal.reverse);
+        deliveryTraversal.version = deliveryTopologyVersion;
+    }
+    return deliveryTraversal;
 }
 
-inline void orderHeapifyUp(int index) {
-    while (index > 0) {
-        int parent = (index - 1) >> 1;
-        if (orderHeap[parent].priority >= orderHeap[index].priority) break;
-        swap(orderHeap[parent], orderHeap[index]);
-        index = parent;
+// Component labels of the delivery network (weak components if one-way roads exist)
+const ComponentLabels &deliveryComponents()
+{
+    return deliveryTraversalState().components;
+}
+
+// Locations reachable from start over the delivery network, level by level
+vector<int> deliveryReachableFrom(int start)
+{
+    const DataStructures::CSRGraph &g = deliveryCSR();
+    if (start < 0 || start >= g.nodeCount())
+        return {};
+    DeliveryTraversalCache &state = deliveryTraversalState();
+    FrontierBFS bfs;
+    bfs.bind(g, state.symmetric ? nullptr : &state.reverse);
+    return bfs.run({start});
+}
+
+// REACHABILITY FUNCTION: Can a rider get from src to dst?
+// HOW IT WORKS: Two-way networks answer from the cached component labels
+// in O(1); networks with one-way roads run a frontier BFS from src that
+// stops at the level reaching dst (and only when both share a weak component)
+bool deliveryReachable(int src, int dst)
+{
+    const DataStructures::CSRGraph &g = deliveryCSR();
+    if (src < 0 || dst < 0 || src >= g.nodeCount() || dst >= g.nodeCount())
+        return false;
+    DeliveryTraversalCache &state = deliveryTraversalState();
+    if (state.components.label[src] != state.components.label[dst])
+        return false;
+    if (state.symmetric || src == dst)
+        return true;
+    FrontierBFS bfs;
+    bfs.bind(g, &state.reverse);
+    bfs.run({src}, dst);
+    return bfs.reached(dst);
+}
+
+void displayDeliveryComponents()
+{
+    const ComponentLabels &c = deliveryComponents();
+    int largest = 0;
+    for (int s : c.size)
+        largest = max(largest, s);
+    cout << "Delivery network: " << deliveryCSR().nodeCount() << " locations in " << c.size.size() << " connected component(s), largest holds " << largest << "\n";
+    if (!deliveryTraversal.symmetric)
+        cout << "(network has one-way roads: components are weakly connected)\n";
+    int shown = 0;
+    for (size_t id = 0; id < c.size.size() && shown < DELIVERY_PRINT_LIMIT; id++)
+    {
+        if (c.size[id] == largest)
+            continue;
+        int first = static_cast<int>(find(c.label.begin(), c.label.end(), static_cast<int>(id)) - c.label.begin());
+        cout << "  Component " << id << ": " << c.size[id] << " location(s), e.g. location " << first << "\n";
+        shown++;
     }
 }
 
-inline void orderHeapifyDown(int index) {
-    while (true) {
-        int left = (index << 1) + 1;
-        int right = left + 1;
-        int largest = index;
-        if (left < orderHeapSize && orderHeap[left].priority > orderHeap[largest].priority)
-            largest = left;
-        if (right < orderHeapSize && orderHeap[right].priority > orderHeap[largest].priority)
-            largest = right;
-        if (largest == index) break;
-        swap(orderHeap[largest], orderHeap[index]);
-        index = largest;
+// Shared routing engine for the delivery network, re-bound after rebuilds
+ShortestPathEngine deliveryRouter;
+int deliveryRouterVersion = -1;
+
+ShortestPathEngine &deliveryRoutingEngine()
+{
+    const DataStructures::CSRGraph &g = deliveryCSR();
+    if (deliveryRouterVersion != deliveryGraphVersion)
+    {
+        deliveryRouter.bind(g);
+        deliveryRouterVersion = deliveryGraphVersion;
     }
+    return deliveryRouter;
+}
+
+// SHORTEST DELIVERY ROUTE FUNCTION: Point-to-point route between two locations
+// HOW IT WORKS:
+// 1. Reuse the shared engine's buffers (no O(V) reset per query)
+// 2. Stop Dijkstra as soon as the destination is settled
+// 3. Walk parent links back to the source
+// TIME COMPLEXITY: O((V'+E') log V') where V' is the area settled before dst
+// USE CASE: Rider routing from restaurant to customer
+vector<int> shortestDeliveryRoute(int src, int dst, int *distance = nullptr)
+{
+    ShortestPathEngine &engine = deliveryRoutingEngine();
+    int d = engine.run(src, dst);
+    if (distance)
+        *distance = d;
+    return engine.pathTo(dst);
 }
 
 // =============================================================
-// Kitchen Management - Linked List Queue
-// NOTE: KitchenOrder uses string status (not FSM enum) because:
-// - Kitchen queue is a transient internal workflow, not a business entity
-// - Domain::Order uses FSM for business-critical state transitions
-// - Kitchen status is informational only ("Queued", "Cooking", "Done")
-// - This separation maintains clean domain boundaries
+// Route Query Cache (memoized s -> t distances)
 // =============================================================
 
-struct KitchenOrder
+static const int ROUTE_CACHE_CAPACITY = 4096; // (src, dst) pairs kept
+
+// ROUTE CACHE: LRU memo of point-to-point distances in front of the searches
+// HOW IT WORKS:
+// 1. Key (src, dst) packed into 64 bits; each entry stores the distance and
+//    the deliveryGraphVersion it was computed on
+// 2. addDeliveryEdge, weight updates and network rebuilds bump that
+//    version, so an older entry is rejected (and overwritten) on lookup;
+//    nothing is flushed up front
+// 3. Every distance engine (Dijkstra, ALT, CH) is exact, so they share one
+//    cache; misses time their search, giving an estimate of the time saved
+// TIME COMPLEXITY: O(1) average per lookup
+// USE CASE: Online-order ETAs that keep asking for the same restaurant ->
+//           zone distances
+class RouteCache
 {
-    int orderId;
-    string dishName;
-    int tableNumber;
-    int prepTime;
-    string status;  // "Queued", "Cooking", "Done" - transient workflow
-    KitchenOrder *next;
+public:
+    struct Stats
+    {
+        long long lookups = 0;
+        long long hits = 0;    // searches saved
+        long long stale = 0;   // entries rejected for an older graph version
+        long long misses = 0;  // includes stale
+        double searchMs = 0;   // time spent in searches after a miss
+    };
+
+private:
+    struct Entry
+    {
+        int distance = GRAPH_INF;
+        int version = -1;
+    };
+    DataStructures::LRUCache<uint64_t, Entry> cache;
+    Stats stats;
+
+    static uint64_t key(int src, int dst)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(src)) << 32) | static_cast<uint32_t>(dst);
+    }
+
+public:
+    explicit RouteCache(int capacity = ROUTE_CACHE_CAPACITY) : cache(capacity) {}
+
+    bool lookup(int src, int dst, int version, int &distance)
+    {
+        stats.lookups++;
+        Entry e;
+        if (cache.get(key(src, dst), e))
+        {
+            if (e.version == version)
+            {
+                stats.hits++;
+                distance = e.distance;
+                return true;
+            }
+            stats.stale++;
+        }
+        stats.misses++;
+        return false;
+    }
+
+    void store(int src, int dst, int version, int distance, double searchMs)
+    {
+        cache.put(key(src, dst), {distance, version});
+        stats.searchMs += searchMs;
+    }
+
+    // Distance from the cache, or from search() (timed and stored) on a miss
+    int distance(int src, int dst, int version, const function<int()> &search)
+    {
+        int d;
+        if (lookup(src, dst, version, d))
+            return d;
+        auto start = chrono::steady_clock::now();
+        d = search();
+        store(src, dst, version, d, chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+        return d;
+    }
+
+    double hitRate() const { return stats.lookups ? static_cast<double>(stats.hits) / stats.lookups : 0.0; }
+    // Hits times the average search a miss cost
+    double savedMs() const { return stats.misses ? stats.hits * stats.searchMs / stats.misses : 0.0; }
+    const Stats &lastStats() const { return stats; }
+    int size() const { return cache.size(); }
+    long long evictions() const { return cache.evictionCount(); }
+    void resetStats() { stats = Stats(); }
+    void clear()
+    {
+        cache.clear();
+        stats = Stats();
+    }
 };
 
-KitchenOrder *kitchenHead = nullptr;
-KitchenOrder *kitchenTail = nullptr;
-int kitchenCounter = 0;
+RouteCache deliveryRouteCache;
 
-// ENQUEUE KITCHEN FUNCTION: Adds a new order to the end of kitchen queue
+// Cached point-to-point distance over the shared Dijkstra engine
+int cachedDeliveryDistance(int src, int dst)
+{
+    deliveryCSR();
+    return deliveryRouteCache.distance(src, dst, deliveryGraphVersion, [&]() {
+        int d = GRAPH_INF;
+        shortestDeliveryRoute(src, dst, &d);
+        return d;
+    });
+}
+
+void displayRouteCacheStats()
+{
+    const RouteCache::Stats &s = deliveryRouteCache.lastStats();
+    cout << "\nRoute Cache (" << deliveryRouteCache.size() << "/" << ROUTE_CACHE_CAPACITY << " routes, graph version " << deliveryGraphVersion << "):\n";
+    cout << "Lookups: " << s.lookups << ", hits: " << s.hits << " (" << fixed << setprecision(1) << deliveryRouteCache.hitRate() * 100 << "%)\n";
+    cout << "Searches saved: " << s.hits << " (~" << setprecision(2) << deliveryRouteCache.savedMs() << " ms)\n";
+    cout << "Stale entries rejected: " << s.stale << ", evictions: " << deliveryRouteCache.evictions() << "\n";
+}
+
+// =============================================================
+// Dynamic Shortest-Path Trees (incremental repair on road changes)
+// =============================================================
+
+// DYNAMIC SHORTEST PATHS: Distance tree from a set of sources kept exact as roads change
 // HOW IT WORKS:
-// 1. Create new KitchenOrder node with order details
-// 2. Initialize status as 'Queued'
-// 3. Set next pointer to nullptr (this is the new tail)
-// 4. If queue is empty, make this node both head and tail
-// 5. Otherwise, append to tail and update tail pointer
-// 6. Increment kitchen counter
-// ALGORITHM: Singly Linked List FIFO (First-In-First-Out) Queue
-// TIME COMPLEXITY: O(1) - constant time insertion at tail
-// USE CASE: Maintain order of dishes to be prepared in kitchen
-void enqueueKitchen(int orderId, const string &dish, int table, int time)
+// 1. build(): one multi-source Dijkstra (every source at distance 0)
+//    recording each node's distance and tree parent, plus a reverse
+//    adjacency (tails of the arcs into each node)
+// 2. Arc u -> v got cheaper or opened: if d(u) + w < d(v), v improves and a
+//    Dijkstra seeded with v alone spreads the gain; it only passes through
+//    nodes whose distance actually drops
+// 3. Arc u -> v got dearer or closed and is v's tree arc: v's subtree may
+//    have lost its paths. Collect it (following arcs whose head has the
+//    tail as parent), seed every node in it with its best arc from outside
+//    the subtree, and settle the subtree with Dijkstra. A change to an arc
+//    outside the tree costs nothing
+// 4. Adding a source is a decrease at that node; removing one repairs its
+//    subtree the same way
+// 5. An optional distance bound stops every search at that radius, so the
+//    tree and each repair stay inside it; nodes beyond report GRAPH_INF
+// ALGORITHM: Ramalingam-Reps dynamic single-source shortest paths
+// TIME COMPLEXITY: O(E log V) build; O(A log A) per change, A = arcs around
+//                  the nodes whose distance changed; O(E) when a new road
+//                  changes the topology (the reverse adjacency is rebuilt)
+// USE CASE: Distances from the restaurant (and satellite kitchens) that
+//           follow traffic updates during service
+class DynamicShortestPaths
 {
-    KitchenOrder *node = new KitchenOrder();
-    node->orderId = orderId;
-    node->dishName = dish;
-    node->tableNumber = table;
-    node->prepTime = time;
-    node->status = "Queued";
-    node->next = nullptr;
-    if (kitchenTail == nullptr)
+private:
+    int n = 0;
+    vector<int> dist;
+    vector<int> parent; // tree parent; -1 for sources and unreachable nodes
+    vector<char> isSource;
+    vector<int> inOffsets; // tails of arcs into v: inFrom[inOffsets[v] .. inOffsets[v+1])
+    vector<int> inFrom;
+    long long arcsIndexed = -1;
+    DataStructures::IndexedDaryHeap heap;
+    vector<char> inRegion;
+    vector<int> region;
+    long long touched = 0;
+    int limit = GRAPH_INF;   // nodes farther than this stay unreached (bounded search)
+    vector<int> changed;     // nodes whose distance the last operation may have changed
+
+    void indexIncomingArcs(const DataStructures::CSRGraph &g)
+    {
+        inOffsets.assign(n + 1, 0);
+        for (const auto &a : g.arcList())
+            inOffsets[a.to + 1]++;
+        for (int v = 0; v < n; v++)
+            inOffsets[v + 1] += inOffsets[v];
+        inFrom.assign(g.arcList().size(), 0);
+        vector<int> cursor(inOffsets.begin(), inOffsets.end() - 1);
+        for (int u = 0; u < n; u++)
+            for (const auto *a = g.arcsBegin(u); a != g.arcsEnd(u); ++a)
+                inFrom[cursor[a->to]++] = u;
+        arcsIndexed = g.arcCount();
+    }
+
+    // Settles queued nodes, relaxing arcs; counts every settled node
+    void propagate(const DataStructures::CSRGraph &g)
+    {
+        while (!heap.empty())
+        {
+            auto [d, x] = heap.pop();
+            if (d != dist[x])
+                continue;
+            touched++;
+            changed.push_back(x);
+            for (const auto *a = g.arcsBegin(x); a != g.arcsEnd(x); ++a)
+            {
+                int nd = d + a->weight;
+                if (nd < dist[a->to] && nd <= limit)
+                {
+                    dist[a->to] = nd;
+                    parent[a->to] = x;
+                    heap.push(nd, a->to);
+                }
+            }
+        }
+    }
+
+    void lowered(const DataStructures::CSRGraph &g, int u, int v, int w)
+    {
+        dist[v] = dist[u] + w;
+        parent[v] = u;
+        heap.push(dist[v], v);
+        propagate(g);
+    }
+
+    // Recomputes the subtree under root, whose path may have become longer
+    void repairSubtree(const DataStructures::CSRGraph &g, int root)
+    {
+        region.assign(1, root);
+        inRegion[root] = 1;
+        for (size_t i = 0; i < region.size(); i++)
+        {
+            int x = region[i];
+            for (const auto *a = g.arcsBegin(x); a != g.arcsEnd(x); ++a)
+                if (parent[a->to] == x && !inRegion[a->to])
+                {
+                    inRegion[a->to] = 1;
+                    region.push_back(a->to);
+                }
+        }
+        for (int x : region)
+        {
+            dist[x] = isSource[x] ? 0 : GRAPH_INF;
+            parent[x] = -1;
+        }
+        changed.insert(changed.end(), region.begin(), region.end()); // some may end up unreached
+        for (int x : region)
+        {
+            for (int k = inOffsets[x]; k < inOffsets[x + 1]; k++)
+            {
+                int p = inFrom[k];
+                if (inRegion[p] || dist[p] == GRAPH_INF)
+                    continue;
+                int w = g.arcWeight(p, x);
+                if (w >= 0 && dist[p] + w < dist[x] && dist[p] + w <= limit)
+                {
+                    dist[x] = dist[p] + w;
+                    parent[x] = p;
+                }
+            }
+            if (dist[x] != GRAPH_INF)
+                heap.push(dist[x], x);
+        }
+        for (int x : region)
+            inRegion[x] = 0;
+        propagate(g);
+    }
+
+public:
+    // maxDistance bounds the search: only nodes within it are settled and
+    // kept exact through later changes; the rest report GRAPH_INF
+    void build(const DataStructures::CSRGraph &g, const vector<int> &sources, int maxDistance = GRAPH_INF)
     {
-        kitchenHead = kitchenTail = node;
+        n = g.nodeCount();
+        limit = maxDistance;
+        changed.clear();
+        dist.assign(n, GRAPH_INF);
+        parent.assign(n, -1);
+        isSource.assign(n, 0);
+        inRegion.assign(n, 0);
+        heap.resize(n);
+        indexIncomingArcs(g);
+        touched = 0;
+        for (int s : sources)
+        {
+            if (s < 0 || s >= n)
+                continue;
+            isSource[s] = 1;
+            dist[s] = 0;
+            heap.push(0, s);
+        }
+        propagate(g);
     }
-    else
+
+    // The arc u -> v changed, was added or removed; g already reflects it.
+    // Decided from the arc's current weight, so a batch of changes can be
+    // replayed one arc at a time against the final graph.
+    void arcChanged(const DataStructures::CSRGraph &g, int u, int v)
     {
-        kitchenTail->next = node;
-        kitchenTail = node;
+        touched = 0;
+        changed.clear();
+        if (g.arcCount() != arcsIndexed)
+            indexIncomingArcs(g); // a road was added or removed
+        int w = g.arcWeight(u, v);
+        if (w >= 0 && dist[u] != GRAPH_INF && dist[u] + w < dist[v] && dist[u] + w <= limit)
+            lowered(g, u, v, w);
+        else if (parent[v] == u && (w < 0 || dist[u] + w != dist[v]))
+            repairSubtree(g, v);
+    }
+
+    void addSource(const DataStructures::CSRGraph &g, int s)
+    {
+        touched = 0;
+        changed.clear();
+        if (s < 0 || s >= n || isSource[s])
+            return;
+        isSource[s] = 1;
+        if (dist[s] == 0)
+            return;
+        dist[s] = 0;
+        parent[s] = -1;
+        heap.push(0, s);
+        propagate(g);
     }
-    kitchenCounter++;
-}
 
-// PROCESS KITCHEN ORDER FUNCTION: Removes and processes the first order from queue
-// HOW IT WORKS:
-// 1. Check if queue is empty (kitchenHead == nullptr)
-// 2. If empty, print message and return
-// 3. Get the order at front (head) and display its details
-// 4. Move head pointer to next order in queue
-// 5. If queue becomes empty, also set tail to nullptr
-// 6. Decrement kitchen counter
-// 7. Free memory of processed order
-// ALGORITHM: Singly Linked List FIFO Dequeue
-// TIME COMPLEXITY: O(1) - constant time removal from head
-// USE CASE: Process dishes in order they were received by kitchen
-void processKitchenOrder()
-{
-    if (kitchenHead == nullptr)
+    void removeSource(const DataStructures::CSRGraph &g, int s)
     {
-        cout << "No orders in kitchen queue.\n";
-        return;
+        touched = 0;
+        changed.clear();
+        if (s < 0 || s >= n || !isSource[s])
+            return;
+        isSource[s] = 0;
+        repairSubtree(g, s);
     }
-    KitchenOrder *node = kitchenHead;
-    cout << "Processing Order ID: " << node->orderId << " | Dish: " << node->dishName
-         << " | Table: " << node->tableNumber << " | Prep Time: " << node->prepTime << " mins\n";
-    kitchenHead = kitchenHead->next;
-    if (kitchenHead == nullptr)
+
+    bool ready() const { return n > 0; }
+    int size() const { return n; }
+    int distance(int v) const { return v >= 0 && v < n ? dist[v] : GRAPH_INF; }
+    int parentOf(int v) const { return parent[v]; }
+    long long touchedLastUpdate() const { return touched; } // nodes settled by the last change
+    const vector<int> &changedLastUpdate() const { return changed; }
+    int bound() const { return limit; }
+
+    // Nearest source -> v, following tree parents back
+    vector<int> pathTo(int v) const
     {
-        kitchenTail = nullptr;
+        vector<int> path;
+        if (distance(v) == GRAPH_INF)
+            return path;
+        for (int x = v; x != -1; x = parent[x])
+            path.push_back(x);
+        reverse(path.begin(), path.end());
+        return path;
     }
-    kitchenCounter--;
-    delete node;
-}
+};
 
-// DISPLAY KITCHEN QUEUE FUNCTION: Lists all orders currently in kitchen queue
-// HOW IT WORKS:
-// 1. Start from head of linked list
-// 2. Traverse through each order node in the queue
-// 3. For each order, print position, order ID, dish name, table number, and prep time
-// 4. Continue until reaching end of queue (null pointer)
-// ALGORITHM: Linked List traversal
-// TIME COMPLEXITY: O(n) where n is number of orders in queue
-// USE CASE: Kitchen staff view list of pending orders to prepare
-void displayKitchenQueue()
+// Locations orders leave from: the restaurant, plus any satellite kitchens
+vector<int> deliveryKitchens = {0};
+DynamicShortestPaths kitchenDistances;
+int kitchenDistancesEpoch = -1;
+long long kitchenDistancesSerial = 0; // next road change the tree has not applied
+
+// Distance tree from the kitchens for the current network: built once,
+// then repaired change by change from the road change log
+const DynamicShortestPaths &kitchenDistanceTree()
 {
-    cout << "\nKitchen Queue:\n";
-    KitchenOrder *cur = kitchenHead;
-    int pos = 1;
-    while (cur)
+    const DataStructures::CSRGraph &g = deliveryCSR();
+    if (!kitchenDistances.ready() || kitchenDistancesEpoch != deliveryTopologyEpoch || kitchenDistancesSerial < roadChangeBase ||
+        kitchenDistances.size() != g.nodeCount())
     {
-        cout << pos++ << ". Order#" << cur->orderId << " | " << cur->dishName
-             << " | Table " << cur->tableNumber << " | Time: " << cur->prepTime << " mins\n";
-        cur = cur->next;
+        kitchenDistances.build(g, deliveryKitchens);
+        kitchenDistancesEpoch = deliveryTopologyEpoch;
+        kitchenDistancesSerial = roadChangeSerial();
+        return kitchenDistances;
+    }
+    for (long long k = kitchenDistancesSerial; k < roadChangeSerial(); k++)
+    {
+        const RoadChange &c = roadChangeLog[k - roadChangeBase];
+        kitchenDistances.arcChanged(g, c.u, c.v);
+        if (!c.oneWay)
+            kitchenDistances.arcChanged(g, c.v, c.u);
     }
+    kitchenDistancesSerial = roadChangeSerial();
+    return kitchenDistances;
+}
+
+// Distance from the nearest kitchen to a location, O(1) after repairs
+int kitchenDistance(int node)
+{
+    return kitchenDistanceTree().distance(node);
+}
+
+bool addDeliveryKitchen(int node)
+{
+    if (node < 0 || node >= deliveryCSR().nodeCount() || find(deliveryKitchens.begin(), deliveryKitchens.end(), node) != deliveryKitchens.end())
+        return false;
+    const DataStructures::CSRGraph &g = deliveryCSR();
+    kitchenDistanceTree();
+    deliveryKitchens.push_back(node);
+    kitchenDistances.addSource(g, node);
+    Core::Logger::log(Core::LogLevel::INFO, "Satellite kitchen added at location " + to_string(node));
+    return true;
+}
+
+bool removeDeliveryKitchen(int node)
+{
+    auto it = find(deliveryKitchens.begin(), deliveryKitchens.end(), node);
+    if (it == deliveryKitchens.end() || deliveryKitchens.size() == 1)
+        return false; // the last kitchen stays
+    const DataStructures::CSRGraph &g = deliveryCSR();
+    kitchenDistanceTree();
+    deliveryKitchens.erase(it);
+    kitchenDistances.removeSource(g, node);
+    Core::Logger::log(Core::LogLevel::INFO, "Satellite kitchen removed at location " + to_string(node));
+    return true;
 }
 
 // =============================================================
-// Table Reservation Management
+// Delivery Zones (Isochrones from the kitchens)
 // =============================================================
 
-struct TableReservation
+static const unsigned char ZONE_OUTSIDE = 255; // band of a location no kitchen reaches in time
+
+// Band limits in minutes of travel; the last one is the delivery radius
+// orders are accepted within
+vector<int> deliveryZoneBands = {15, 30, 45};
+
+// ISOCHRONE SERVICE: "Deliverable within N minutes" zones around the kitchens
+// HOW IT WORKS:
+// 1. One multi-source Dijkstra from every kitchen, bounded at the largest
+//    band: the search stops at the delivery radius instead of covering the
+//    whole city
+// 2. Each location gets a one-byte band (index of the first band limit its
+//    distance fits, or ZONE_OUTSIDE), and the zone sizes are counted
+// 3. Road changes and kitchen changes go through the bounded dynamic tree
+//    (DynamicShortestPaths); only the locations it reports as changed get
+//    their band and the zone counts rewritten
+// ALGORITHM: Bounded multi-source Dijkstra + Ramalingam-Reps repair
+// TIME COMPLEXITY: O(A log A) build, A = arcs inside the radius; repairs
+//                  proportional to the affected region; O(1) band lookups
+// USE CASE: Zone display and rejecting out-of-range orders at intake
+class IsochroneService
 {
-    int reservationId;
-    int tableNumber;
-    int customerId;
-    string customerName;
-    string date;
-    string time;
-    int guestCount;
-    string status; // Booked, Confirmed, Cancelled, Completed
-};
+private:
+    DynamicShortestPaths tree;
+    vector<int> limits;
+    vector<unsigned char> band;
+    vector<int> zoneSize; // locations per band
+    vector<int> kitchens;
 
-static const int MAX_RESERVATIONS = 300;
-TableReservation reservations[MAX_RESERVATIONS];
-int reservationCount = 0;
+    unsigned char bandFor(int d) const
+    {
+        for (size_t b = 0; b < limits.size(); b++)
+            if (d <= limits[b])
+                return static_cast<unsigned char>(b);
+        return ZONE_OUTSIDE;
+    }
 
-static const int MAX_TABLES = 50;
-bool tableOccupied[MAX_TABLES];
-int tableCapacity[MAX_TABLES];
+    void refresh(const vector<int> &nodes)
+    {
+        for (int v : nodes)
+        {
+            unsigned char now = bandFor(tree.distance(v));
+            if (now == band[v])
+                continue;
+            if (band[v] != ZONE_OUTSIDE)
+                zoneSize[band[v]]--;
+            if (now != ZONE_OUTSIDE)
+                zoneSize[now]++;
+            band[v] = now;
+        }
+    }
 
-void initializeTables()
-{
-    for (int i = 0; i < MAX_TABLES; i++)
+public:
+    // bandLimits ascending, fewer than 255
+    void build(const DataStructures::CSRGraph &g, const vector<int> &sources, const vector<int> &bandLimits)
     {
-        tableOccupied[i] = false;
-        tableCapacity[i] = (i % 3 == 0) ? 2 : (i % 3 == 1) ? 4 : 6; // Mix of 2, 4, 6 seaters
+        limits = bandLimits;
+        kitchens = sources;
+        band.assign(g.nodeCount(), ZONE_OUTSIDE);
+        zoneSize.assign(limits.size(), 0);
+        tree.build(g, sources, limits.empty() ? -1 : limits.back());
+        refresh(tree.changedLastUpdate());
     }
-}
 
-// =============================================================
-// Billing System with Circular Queue
-// =============================================================
+    void arcChanged(const DataStructures::CSRGraph &g, int u, int v)
+    {
+        tree.arcChanged(g, u, v);
+        refresh(tree.changedLastUpdate());
+    }
 
-struct Bill
-{
-    int billId;
-    int orderId;
-    int customerId;
-    double subtotal;
-    double tax;
-    double discount;
-    double finalAmount;
-    string paymentMethod;
-    string status;
+    void addKitchen(const DataStructures::CSRGraph &g, int s)
+    {
+        tree.addSource(g, s);
+        refresh(tree.changedLastUpdate());
+        if (find(kitchens.begin(), kitchens.end(), s) == kitchens.end())
+            kitchens.push_back(s);
+    }
+
+    void removeKitchen(const DataStructures::CSRGraph &g, int s)
+    {
+        tree.removeSource(g, s);
+        refresh(tree.changedLastUpdate());
+        kitchens.erase(remove(kitchens.begin(), kitchens.end(), s), kitchens.end());
+    }
+
+    // O(1): index into bandLimits, or ZONE_OUTSIDE
+    unsigned char bandOf(int v) const { return v >= 0 && v < static_cast<int>(band.size()) ? band[v] : ZONE_OUTSIDE; }
+    bool deliverable(int v) const { return bandOf(v) != ZONE_OUTSIDE; }
+    // Minutes from the nearest kitchen; GRAPH_INF beyond the radius
+    int minutesTo(int v) const { return tree.distance(v); }
+    int zoneCount(int b) const { return zoneSize[b]; }
+    long long touchedLastUpdate() const { return tree.touchedLastUpdate(); }
+    const vector<int> &bandLimits() const { return limits; }
+    const vector<int> &sources() const { return kitchens; }
+    bool ready() const { return tree.ready(); }
+    int size() const { return tree.size(); }
 };
 
-static const int BILL_CAP = 300;
-Bill billQueue[BILL_CAP];
-int billFront = 0;
-int billRear = 0;
-int billSize = 0;
+IsochroneService deliveryZones;
+int deliveryZonesEpoch = -1;
+long long deliveryZonesSerial = 0; // next road change the zones have not applied
 
-// ENQUEUE BILL FUNCTION: Adds a new bill to circular queue for processing
-// HOW IT WORKS:
-// 1. Check if circular queue is at full capacity
-// 2. If full, print error and return without adding
-// 3. Otherwise, insert bill at rear position
-// 4. Move rear pointer to next position using modulo (wraps around)
-// 5. Increment size counter
-// ALGORITHM: Circular Queue - enqueue operation
-// TIME COMPLEXITY: O(1) - constant time
-// USE CASE: Queue bills for payment processing in FIFO order
-bool billIsFull()
+// Zones for the current network, kitchens and bands: built once, then kept
+// current from the road change log and kitchen changes
+const IsochroneService &deliveryZoneService()
 {
-    return billSize == BILL_CAP;
+    const DataStructures::CSRGraph &g = deliveryCSR();
+    if (!deliveryZones.ready() || deliveryZonesEpoch != deliveryTopologyEpoch || deliveryZonesSerial < roadChangeBase ||
+        deliveryZones.size() != g.nodeCount() || deliveryZones.bandLimits() != deliveryZoneBands)
+    {
+        deliveryZones.build(g, deliveryKitchens, deliveryZoneBands);
+        deliveryZonesEpoch = deliveryTopologyEpoch;
+        deliveryZonesSerial = roadChangeSerial();
+        return deliveryZones;
+    }
+    for (long long k = deliveryZonesSerial; k < roadChangeSerial(); k++)
+    {
+        const RoadChange &c = roadChangeLog[k - roadChangeBase];
+        deliveryZones.arcChanged(g, c.u, c.v);
+        if (!c.oneWay)
+            deliveryZones.arcChanged(g, c.v, c.u);
+    }
+    deliveryZonesSerial = roadChangeSerial();
+    vector<int> current = deliveryZones.sources();
+    for (int s : current)
+        if (find(deliveryKitchens.begin(), deliveryKitchens.end(), s) == deliveryKitchens.end())
+            deliveryZones.removeKitchen(g, s);
+    for (int s : deliveryKitchens)
+        if (find(current.begin(), current.end(), s) == current.end())
+            deliveryZones.addKitchen(g, s);
+    return deliveryZones;
+}
+
+// INTAKE CHECK: Can an order to this location be delivered in time?
+// One band lookup once the zones are current
+bool withinDeliveryZone(int node)
+{
+    return deliveryZoneService().deliverable(node);
 }
 
-bool billIsEmpty()
+// Sets the radius; bands at a third, two thirds and all of it
+void setDeliveryRadius(int minutes)
 {
-    return billSize == 0;
+    minutes = max(3, minutes);
+    deliveryZoneBands = {minutes / 3, 2 * minutes / 3, minutes};
+    Core::Logger::log(Core::LogLevel::INFO, "Delivery radius set to " + to_string(minutes) + " minutes");
 }
 
-// ENQUEUE BILL FUNCTION: Adds a new bill to the circular queue for billing system
-// HOW IT WORKS:
-// 1. Check if queue is full (billSize == BILL_CAP)
-// 2. If full, print error and return without adding
-// 3. Copy bill into billQueue at billRear position
-// 4. Move billRear pointer forward: (billRear + 1) % BILL_CAP (wraps around)
-// 5. Increment billSize counter
-// ALGORITHM: Circular Queue enqueue using modulo arithmetic
-// TIME COMPLEXITY: O(1) - constant time insertion
-// USE CASE: Store bills waiting for payment processing
-void enqueueBill(const Bill &b)
+void displayDeliveryZones()
 {
-    if (billIsFull())
+    const IsochroneService &zones = deliveryZoneService();
+    cout << "\nDelivery zones from " << zones.sources().size() << " kitchen(s):\n";
+    int total = 0;
+    for (size_t b = 0; b < zones.bandLimits().size(); b++)
     {
-        cout << "Billing queue full.\n";
-        return;
+        total += zones.zoneCount(static_cast<int>(b));
+        cout << "  Within " << zones.bandLimits()[b] << " min: " << total << " location(s)\n";
     }
-    billQueue[billRear] = b;
-    billRear = (billRear + 1) % BILL_CAP;
-    billSize++;
-}
-
-// DEQUEUE BILL FUNCTION: Removes and returns the oldest bill from circular queue
-// HOW IT WORKS:
-// 1. Get bill at billFront position (oldest bill waiting)
-// 2. Move billFront pointer forward: (billFront + 1) % BILL_CAP (wraps around)
-// 3. Decrement billSize counter
-// 4. Return the dequeued bill
-// ALGORITHM: Circular Queue dequeue using modulo arithmetic
-// TIME COMPLEXITY: O(1) - constant time removal
-// USE CASE: Process bills in FIFO order for payment collection
-Bill dequeueBill()
-{
-    Bill b = billQueue[billFront];
-    billFront = (billFront + 1) % BILL_CAP;
-    billSize--;
-    return b;
+    cout << "  Outside the delivery radius: " << zones.size() - total << " location(s)\n";
 }
 
 // =============================================================
-// Sales Analysis Data
+// All-Pairs Distance Matrix (Blocked Floyd-Warshall, Parallel Dijkstra)
 // =============================================================
 
-struct SalesRecord
-{
-    string date;
-    double revenue;
-    int ordersCount;
-    string topDish;
-};
-
-static const int MAX_SALES = 365;
-SalesRecord salesData[MAX_SALES];
-int salesCount = 0;
-
-// =============================================================
-// Inventory Management using Hash Table
-// =============================================================
+static const int APSP_MAX_NODES = 4096;     // 64 MB of 32-bit cells at most
+static const int FLOYD_SMALL_GRAPH = 256;   // always Floyd-Warshall up to here
+static const int FLOYD_TILE = 64;           // 64x64 ints = 16 KB per tile buffer
 
-struct InventoryItem
+enum class ApspMethod
 {
-    string name;
-    int quantity;
-    string unit;
-    double costPerUnit;
-    int reorderLevel;
+    AUTO,
+    FLOYD_WARSHALL,
+    DIJKSTRA
 };
 
-static const int HASH_SIZE = 101;
-InventoryItem inventoryTable[HASH_SIZE];
-bool inventoryUsed[HASH_SIZE];
-
-int simpleHash(const string &key)
-{
-    int sum = 0;
-    for (char c : key)
-    {
-        sum += static_cast<int>(c);
-    }
-    return sum % HASH_SIZE;
-}
-
-// HASH TABLE LOOKUP FUNCTION: Finds position of item in hash table using linear probing
+// ALL-PAIRS DISTANCES: Shortest distance between every pair of locations
 // HOW IT WORKS:
-// 1. Compute initial hash index: sum of ASCII values % HASH_SIZE
-// 2. Start at computed index
-// 3. If position is occupied AND the name doesn't match, continue probing
-// 4. Increment step value and wrap around using modulo (linear probing)
-// 5. Return the index when:
-//    - Found matching item (used==true AND name matches)
-//    - Found empty slot (used==false)
-// ALGORITHM: Hash table with linear probing collision resolution
-// TIME COMPLEXITY: O(1) average, O(n) worst case (many collisions)
-// USE CASE: Fast ingredient lookup in restaurant inventory
-int probeIndex(const string &key)
+// 1. Dense or small graphs: blocked Floyd-Warshall. The matrix is cut into
+//    FLOYD_TILE x FLOYD_TILE tiles; for each pivot tile k the diagonal tile
+//    is closed first, then the tiles in row/column k, then every other tile
+//    from those two (independent, so tile rows go to worker threads). Each
+//    step only touches three tiles, so it runs out of cache.
+// 2. Sparse graphs: one Dijkstra per source, sources handed out to worker
+//    threads through an atomic counter, each worker with its own engine
+// 3. Results land in a DistanceMatrix, narrowed to 16-bit cells if they fit
+// Incremental updates:
+// - A road getting cheaper (or a new road) u-v with weight w can only help
+//   paths through it: d(i,j) = min(d(i,j), d(i,u) + w + d(v,j)), O(n^2)
+// - A road getting dearer only affects sources whose shortest-path tree
+//   uses it (d(i,u) + old == d(i,v)); those rows are marked stale and rerun
+// TIME COMPLEXITY: Floyd-Warshall O(n^3 / threads); Dijkstra
+//                  O(n (V+E) log V / threads); cheaper-road patch O(n^2);
+//                  dearer-road refresh O(stale rows * (V+E) log V)
+// USE CASE: Metric distances for tour building (TSP) and repeated ETA lookups
+class AllPairsDistances
 {
-    int idx = simpleHash(key);
-    int step = 1;
-    while (inventoryUsed[idx] && inventoryTable[idx].name != key)
+private:
+    DataStructures::DistanceMatrix matrix;
+    bool computed = false;
+    string lastMethod = "none";
+
+    void fillFromFloydWarshall(const DataStructures::CSRGraph &g, int workers)
+    {
+        int n = g.nodeCount();
+        vector<int> d(static_cast<size_t>(n) * n, GRAPH_INF);
+        for (int u = 0; u < n; u++)
+        {
+            d[static_cast<size_t>(u) * n + u] = 0;
+            for (const auto *a = g.arcsBegin(u); a != g.arcsEnd(u); ++a)
+                d[static_cast<size_t>(u) * n + a->to] = min({d[static_cast<size_t>(u) * n + a->to], a->weight, GRAPH_INF});
+        }
+        // Cells start at or below GRAPH_INF and only ever shrink, and dik is
+        // below it, so dik + d(k, j) < 2 * GRAPH_INF always fits in an int:
+        // the min-plus loops stay 32-bit (and vectorised) without overflowing
+        // Relaxes tile (ib, jb) through the pivots of tile kb
+        auto relaxTile = [&](int ib, int jb, int kb) {
+            int iEnd = min(n, ib + FLOYD_TILE), jEnd = min(n, jb + FLOYD_TILE), kEnd = min(n, kb + FLOYD_TILE);
+            for (int k = kb; k < kEnd; k++)
+            {
+                const int *rowK = d.data() + static_cast<size_t>(k) * n;
+                for (int i = ib; i < iEnd; i++)
+                {
+                    int *rowI = d.data() + static_cast<size_t>(i) * n;
+                    int dik = rowI[k];
+                    if (dik == GRAPH_INF)
+                        continue;
+                    for (int j = jb; j < jEnd; j++)
+                        rowI[j] = min(rowI[j], dik + rowK[j]);
+                }
+            }
+        };
+        // Phase-3 version: tile (ib, jb) shares no cells with the pivot row
+        // and column, so the pivot rows and the row being updated are copied
+        // into local buffers padded to a fixed width, which lets the compiler
+        // vectorise the min-plus inner loop
+        auto relaxIndependentTile = [&](int ib, int jb, int kb) {
+            int iEnd = min(n, ib + FLOYD_TILE), kEnd = min(n, kb + FLOYD_TILE);
+            int width = min(n, jb + FLOYD_TILE) - jb;
+            int pivot[FLOYD_TILE * FLOYD_TILE];
+            int row[FLOYD_TILE];
+            fill(pivot, pivot + FLOYD_TILE * FLOYD_TILE, GRAPH_INF);
+            fill(row, row + FLOYD_TILE, GRAPH_INF);
+            for (int k = kb; k < kEnd; k++)
+                copy_n(d.data() + static_cast<size_t>(k) * n + jb, width, pivot + (k - kb) * FLOYD_TILE);
+            for (int i = ib; i < iEnd; i++)
+            {
+                int *rowI = d.data() + static_cast<size_t>(i) * n;
+                copy_n(rowI + jb, width, row);
+                for (int k = kb; k < kEnd; k++)
+                {
+                    int dik = rowI[k];
+                    if (dik == GRAPH_INF)
+                        continue;
+                    const int *pivotK = pivot + (k - kb) * FLOYD_TILE;
+                    for (int j = 0; j < FLOYD_TILE; j++)
+                        row[j] = min(row[j], dik + pivotK[j]);
+                }
+                copy_n(row, width, rowI + jb);
+            }
+        };
+        int tiles = (n + FLOYD_TILE - 1) / FLOYD_TILE;
+        for (int kt = 0; kt < tiles; kt++)
+        {
+            int kb = kt * FLOYD_TILE;
+            relaxTile(kb, kb, kb);
+            for (int t = 0; t < tiles; t++)
+            {
+                if (t == kt)
+                    continue;
+                relaxTile(kb, t * FLOYD_TILE, kb);
+                relaxTile(t * FLOYD_TILE, kb, kb);
+            }
+            atomic<int> nextRow(0);
+            runOnWorkers(min(workers, tiles), [&](int) {
+                for (int it = nextRow++; it < tiles; it = nextRow++)
+                {
+                    if (it == kt)
+                        continue;
+                    for (int jt = 0; jt < tiles; jt++)
+                        if (jt != kt)
+                            relaxIndependentTile(it * FLOYD_TILE, jt * FLOYD_TILE, kb);
+                }
+            });
+        }
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+                matrix.set(i, j, d[static_cast<size_t>(i) * n + j]);
+            matrix.markRow(i, true);
+        }
+    }
+
+    // Reruns Dijkstra for the given source rows across worker threads
+    void fillRows(const DataStructures::CSRGraph &g, const vector<int> &rows, int workers)
     {
-        idx = (idx + step) % HASH_SIZE;
-        step++;
+        int n = g.nodeCount();
+        atomic<size_t> next(0);
+        runOnWorkers(min(workers, static_cast<int>(rows.size())), [&](int) {
+            ShortestPathEngine engine(HeapKind::RADIX);
+            engine.bind(g);
+            for (size_t r = next++; r < rows.size(); r = next++)
+            {
+                int src = rows[r];
+                engine.run(src);
+                for (int j = 0; j < n; j++)
+                    matrix.set(src, j, engine.distanceTo(j));
+                matrix.markRow(src, true);
+            }
+        });
     }
-    return idx;
-}
 
-void addInventoryItem()
-{
-    InventoryItem item;
-    item.name = readLine("Enter ingredient name: ");
-    item.quantity = readInt("Enter quantity: ", 0, 1000000);
-    item.unit = readLine("Enter unit (kg/ltr/pcs): ");
-    item.costPerUnit = readFloat("Enter cost per unit: ", 0.0, 100000.0);
-    item.reorderLevel = readInt("Enter reorder level: ", 0, 10000);
-    int idx = probeIndex(item.name);
-    inventoryTable[idx] = item;
-    inventoryUsed[idx] = true;
-    cout << "Inventory item added at slot " << idx << "\n";
-}
+public:
+    bool ready() const { return computed; }
+    int size() const { return computed ? matrix.size() : 0; }
+    const string &method() const { return lastMethod; }
+    const DataStructures::DistanceMatrix &table() const { return matrix; }
+    int distance(int i, int j) const { return matrix.get(i, j); }
 
-void updateInventoryItem()
-{
-    string key = readLine("Enter ingredient name to update: ");
-    int idx = probeIndex(key);
-    if (!inventoryUsed[idx] || inventoryTable[idx].name != key)
+    void clear()
     {
-        cout << "Item not found in inventory.\n";
-        return;
+        matrix.reset(0, GRAPH_INF);
+        computed = false;
+        lastMethod = "none";
     }
-    inventoryTable[idx].quantity = readInt("Enter new quantity: ", 0, 1000000);
-    inventoryTable[idx].costPerUnit = readFloat("Enter new cost per unit: ", 0.0, 100000.0);
-    cout << "Inventory item updated.\n";
-}
 
-void viewInventoryItem()
-{
-    string key = readLine("Enter ingredient name: ");
-    int idx = probeIndex(key);
-    if (!inventoryUsed[idx] || inventoryTable[idx].name != key)
+    // Full recompute; workers = 0 uses every hardware thread, AUTO picks
+    // Floyd-Warshall for small or dense graphs. Returns false (and leaves the
+    // table empty) above APSP_MAX_NODES.
+    bool compute(const DataStructures::CSRGraph &g, int workers = 0, ApspMethod method = ApspMethod::AUTO)
     {
-        cout << "Item not found.\n";
-        return;
+        int n = g.nodeCount();
+        if (n > APSP_MAX_NODES)
+        {
+            Core::Logger::log(Core::LogLevel::WARNING, "All-pairs table skipped: " + to_string(n) + " locations exceeds " + to_string(APSP_MAX_NODES));
+            clear();
+            return false;
+        }
+        if (workers <= 0)
+            workers = parallelWorkerCount(n);
+        matrix.reset(n, GRAPH_INF);
+        if (method == ApspMethod::AUTO)
+        {
+            bool dense = n <= FLOYD_SMALL_GRAPH || g.arcCount() * 8 >= static_cast<long long>(n) * n;
+            method = dense ? ApspMethod::FLOYD_WARSHALL : ApspMethod::DIJKSTRA;
+        }
+        if (method == ApspMethod::FLOYD_WARSHALL)
+        {
+            fillFromFloydWarshall(g, workers);
+            lastMethod = "blocked Floyd-Warshall";
+        }
+        else
+        {
+            vector<int> rows(n);
+            for (int i = 0; i < n; i++)
+                rows[i] = i;
+            fillRows(g, rows, workers);
+            lastMethod = "parallel Dijkstra";
+        }
+        matrix.compact();
+        computed = true;
+        return true;
     }
-    cout << "Name: " << inventoryTable[idx].name
-         << " | Qty: " << inventoryTable[idx].quantity << " " << inventoryTable[idx].unit
-         << " | Cost/Unit: $" << inventoryTable[idx].costPerUnit
-         << " | Reorder: " << inventoryTable[idx].reorderLevel << "\n";
-}
 
-void listInventory()
-{
-    cout << "\n=== Inventory Snapshot ===\n";
-    for (int i = 0; i < HASH_SIZE; i++)
+    // A road u -> v now costs w (new road or cheaper); patches every pair
+    void arcImproved(int u, int v, int w)
     {
-        if (inventoryUsed[i])
+        if (!computed)
+            return;
+        int n = matrix.size();
+        if (!matrix.staleRows().empty())
         {
-            cout << inventoryTable[i].name << " | " << inventoryTable[i].quantity
-                 << " " << inventoryTable[i].unit << " | $" << inventoryTable[i].costPerUnit << "/unit";
-            if (inventoryTable[i].quantity <= inventoryTable[i].reorderLevel)
+            matrix.invalidateAll(); // patching needs complete rows; refresh() reruns them
+            return;
+        }
+        vector<int> fromV(n);
+        for (int j = 0; j < n; j++)
+            fromV[j] = matrix.get(v, j);
+        for (int i = 0; i < n; i++)
+        {
+            int du = matrix.get(i, u);
+            if (du == GRAPH_INF || addPathLengths(du, w) >= matrix.get(i, v))
+                continue; // the road cannot shorten anything from i
+            for (int j = 0; j < n; j++)
             {
-                cout << " [LOW STOCK - REORDER NEEDED]";
+                if (fromV[j] == GRAPH_INF)
+                    continue;
+                int via = addPathLengths(addPathLengths(du, w), fromV[j]);
+                if (via < matrix.get(i, j))
+                    matrix.set(i, j, via);
             }
-            cout << "\n";
         }
     }
-}
 
-// =============================================================
-// Online Ordering System
-// =============================================================
+    // A road u -> v that cost oldWeight got dearer or closed; marks the rows
+    // whose shortest paths may have used it and returns how many
+    int arcWorsened(int u, int v, int oldWeight)
+    {
+        if (!computed)
+            return 0;
+        int stale = 0;
+        for (int i = 0; i < matrix.size(); i++)
+        {
+            int du = matrix.get(i, u);
+            if (du != GRAPH_INF && addPathLengths(du, oldWeight) == matrix.get(i, v) && matrix.rowReady(i))
+            {
+                matrix.markRow(i, false);
+                stale++;
+            }
+        }
+        return stale;
+    }
 
-struct OnlineOrder
-{
-    int orderId;
-    int customerId;
-    string deliveryAddress;
-    string items[20];
-    int itemCount;
-    double totalAmount;
-    string status; // Placed, Confirmed, Out for Delivery, Delivered
-    int deliveryTime; // estimated minutes
+    // Recomputes stale rows against the current graph; returns how many.
+    // The table is widened first: a worker that widened it mid-fill would
+    // free the 16-bit cells under the others. compact() narrows it again.
+    int refresh(const DataStructures::CSRGraph &g, int workers = 0)
+    {
+        if (!computed)
+            return 0;
+        vector<int> rows = matrix.staleRows();
+        if (rows.empty())
+            return 0;
+        matrix.widen();
+        fillRows(g, rows, workers > 0 ? workers : parallelWorkerCount(static_cast<int>(rows.size())));
+        matrix.compact();
+        return static_cast<int>(rows.size());
+    }
 };
 
-static const int MAX_ONLINE_ORDERS = 200;
-OnlineOrder onlineOrders[MAX_ONLINE_ORDERS];
-int onlineOrderCount = 0;
-
-// =============================================================
-// Offers and Promotions
-// =============================================================
+AllPairsDistances deliveryDistances;
+int deliveryDistancesEpoch = -1;
+long long deliveryDistancesSerial = 0; // next road change the table has not applied
 
-struct Offer
+// Returns the all-pairs table for the delivery network, or nullptr if the
+// network is too large. Pending road changes are applied incrementally;
+// replacing the network triggers a full recompute.
+const AllPairsDistances *deliveryDistanceTable()
 {
-    int offerId;
-    string offerName;
-    string description;
-    double discountPercent;
-    string validFrom;
-    string validTo;
-    bool active;
-};
+    const DataStructures::CSRGraph &g = deliveryCSR();
+    if (g.nodeCount() > APSP_MAX_NODES)
+        return nullptr;
+    if (!deliveryDistances.ready() || deliveryDistancesEpoch != deliveryTopologyEpoch || deliveryDistancesSerial < roadChangeBase ||
+        deliveryDistances.size() != g.nodeCount())
+    {
+        deliveryDistances.compute(g);
+        deliveryDistancesEpoch = deliveryTopologyEpoch;
+        deliveryDistancesSerial = roadChangeSerial();
+        Core::Logger::log(Core::LogLevel::INFO, "All-pairs distances computed (" + deliveryDistances.method() + ", " + to_string(g.nodeCount()) + " locations)");
+        return &deliveryDistances;
+    }
+    for (long long k = deliveryDistancesSerial; k < roadChangeSerial(); k++)
+    {
+        const RoadChange &c = roadChangeLog[k - roadChangeBase];
+        if (c.newWeight == c.oldWeight)
+            continue;
+        bool cheaper = c.oldWeight < 0 || (c.newWeight >= 0 && c.newWeight < c.oldWeight);
+        for (int side = 0; side < (c.oneWay ? 1 : 2); side++)
+        {
+            int from = side == 0 ? c.u : c.v, to = side == 0 ? c.v : c.u;
+            if (cheaper)
+                deliveryDistances.arcImproved(from, to, c.newWeight);
+            else
+                deliveryDistances.arcWorsened(from, to, c.oldWeight);
+        }
+    }
+    deliveryDistancesSerial = roadChangeSerial();
+    deliveryDistances.refresh(g);
+    return &deliveryDistances;
+}
 
-static const int MAX_OFFERS = 50;
-Offer offers[MAX_OFFERS];
-int offerCount = 0;
+// Distance between two locations: a table lookup while the network fits
+// the all-pairs table, otherwise a cached point-to-point Dijkstra
+int deliveryDistance(int src, int dst)
+{
+    const AllPairsDistances *table = deliveryDistanceTable();
+    if (table)
+        return table->distance(src, dst);
+    return cachedDeliveryDistance(src, dst);
+}
 
 // =============================================================
-// Feedback and Rating System
+// ALT Point-to-Point Routing (A*, Landmarks, Triangle inequality)
 // =============================================================
 
-struct Feedback
+// LANDMARK ROUTER: Bidirectional A* with landmark lower bounds for s -> t queries
+// HOW IT WORKS:
+// Preprocessing:
+// 1. Pick landmarks by farthest-point sampling: the first is the node
+//    farthest from a random start, each next one maximises its distance to
+//    the nearest landmark already chosen (spreads them to the map's edges)
+// 2. Store d(L, v) and d(v, L) for every landmark (one table when the graph
+//    is symmetric, as delivery roads are)
+// Query:
+// 1. Triangle inequality gives lower bounds pi_f(v) <= d(v, t) and
+//    pi_r(v) <= d(s, v) from the tables
+// 2. Both searches use the averaged potential p(v) = (pi_f(v) - pi_r(v)) / 2
+//    (forward +p, backward -p), which keeps both consistent; keys are doubled
+//    so everything stays integral: forward 2*d + diff, backward 2*d - diff
+// 3. Expand the side with the smaller top key; every arc that connects the
+//    two searches updates the best s-t length mu
+// 4. Stop once topF + topR >= 2 * mu: no remaining path can beat mu
+// ALGORITHM: ALT (Goldberg & Harrelson) bidirectional A*
+// TIME COMPLEXITY: Preprocessing O(L (V+E) log V), memory O(L V); queries
+//                  settle a small corridor around the s-t path
+// USE CASE: Restaurant -> customer ETAs without building a full SPT
+class LandmarkRouter
 {
-    int feedbackId;
-    int customerId;
-    string customerName;
-    int rating; // 1-5 stars
-    string comments;
-    string date;
-    string category; // Food, Service, Ambience, Overall
-};
+private:
+    const DataStructures::CSRGraph *forward = nullptr;
+    const DataStructures::CSRGraph *backward = nullptr;
+    DataStructures::CSRGraph reverseGraph; // only built for directed graphs
+    bool symmetric = true;
+    vector<int> landmarks;
+    vector<vector<int>> fromLandmark; // d(L, v)
+    vector<vector<int>> toLandmark;   // d(v, L); empty when symmetric
+
+    vector<int> distF, distR, parentF, parentR;
+    vector<long long> diffCache;
+    vector<uint32_t> stampF, stampR, stampDiff;
+    uint32_t generation = 0;
+    vector<pair<long long, int>> heapF, heapR;
+    vector<long long> fromS, toS, fromT, toT;
+    int settledCount = 0;
+    int meetNode = -1;
+    int lastSource = -1;
+
+    const vector<int> &toRow(size_t i) const { return symmetric ? fromLandmark[i] : toLandmark[i]; }
+
+    int labelF(int v) const { return stampF[v] == generation ? distF[v] : GRAPH_INF; }
+    int labelR(int v) const { return stampR[v] == generation ? distR[v] : GRAPH_INF; }
+
+    // pi_f(v) - pi_r(v) for the current query, computed once per node
+    long long potentialDiff(int v)
+    {
+        if (stampDiff[v] == generation)
+            return diffCache[v];
+        long long pf = 0, pr = 0;
+        for (size_t i = 0; i < landmarks.size(); i++)
+        {
+            long long fv = fromLandmark[i][v], tv = toRow(i)[v];
+            pf = max(pf, max(tv - toT[i], fromT[i] - fv));
+            pr = max(pr, max(fv - fromS[i], toS[i] - tv));
+        }
+        stampDiff[v] = generation;
+        diffCache[v] = pf - pr;
+        return diffCache[v];
+    }
 
-static const int MAX_FEEDBACK = 500;
-Feedback feedbackRecords[MAX_FEEDBACK];
-int feedbackCount = 0;
+    static void pushKey(vector<pair<long long, int>> &heap, long long key, int v)
+    {
+        heap.push_back({key, v});
+        push_heap(heap.begin(), heap.end(), greater<pair<long long, int>>());
+    }
 
-// =============================================================
-// Binary Search Tree for Fast Customer Lookup
-// =============================================================
+    static pair<long long, int> popKey(vector<pair<long long, int>> &heap)
+    {
+        pop_heap(heap.begin(), heap.end(), greater<pair<long long, int>>());
+        pair<long long, int> top = heap.back();
+        heap.pop_back();
+        return top;
+    }
 
-struct BSTNode
-{
-    int key;
-    string name;
-    BSTNode *left;
-    BSTNode *right;
-    int height;
-};
+public:
+    bool ready() const { return forward != nullptr && !landmarks.empty(); }
+    bool isSymmetric() const { return symmetric; }
+    const vector<int> &landmarkNodes() const { return landmarks; }
+    int settled() const { return settledCount; }
 
-BSTNode *customerBST = nullptr;
+    void preprocess(const DataStructures::CSRGraph &g, int landmarkCount = 8, unsigned seed = 1)
+    {
+        forward = &g;
+        int n = g.nodeCount();
+        symmetric = true;
+        for (int u = 0; u < n && symmetric; u++)
+        {
+            for (const auto *a = g.arcsBegin(u); a != g.arcsEnd(u); ++a)
+            {
+                if (g.arcWeight(a->to, u) != a->weight)
+                {
+                    symmetric = false;
+                    break;
+                }
+            }
+        }
+        if (symmetric)
+        {
+            backward = &g;
+            reverseGraph = DataStructures::CSRGraph();
+        }
+        else
+        {
+            DataStructures::CSRGraphBuilder builder(n);
+            builder.reserve(g.arcCount());
+            for (int u = 0; u < n; u++)
+                for (const auto *a = g.arcsBegin(u); a != g.arcsEnd(u); ++a)
+                    builder.addArc(a->to, u, a->weight);
+            reverseGraph = builder.build();
+            backward = &reverseGraph;
+        }
 
-inline int height(BSTNode *n) {
-    return n ? n->height : 0;
-}
+        landmarks.clear();
+        fromLandmark.clear();
+        toLandmark.clear();
+        distF.assign(n, GRAPH_INF);
+        distR.assign(n, GRAPH_INF);
+        parentF.assign(n, -1);
+        parentR.assign(n, -1);
+        diffCache.assign(n, 0);
+        stampF.assign(n, 0);
+        stampR.assign(n, 0);
+        stampDiff.assign(n, 0);
+        generation = 0;
+        if (n == 0)
+            return;
 
-inline int balanceFactor(BSTNode *n) {
-    return n ? height(n->left) - height(n->right) : 0;
-}
+        ShortestPathEngine forwardEngine(HeapKind::RADIX), backwardEngine(HeapKind::RADIX);
+        forwardEngine.bind(g);
+        backwardEngine.bind(*backward);
+        mt19937 gen(seed);
+        forwardEngine.run(static_cast<int>(gen() % n));
+        int candidate = 0;
+        for (int v = 0; v < n; v++)
+        {
+            int d = forwardEngine.distanceTo(v);
+            if (d != GRAPH_INF && d > forwardEngine.distanceTo(candidate))
+                candidate = v;
+        }
 
-BSTNode *createNode(int key, const string &name)
-{
-    BSTNode *node = new BSTNode();
-    node->key = key;
-    node->name = name;
-    node->left = node->right = nullptr;
-    node->height = 1;
-    return node;
-}
+        vector<int> nearest(n, GRAPH_INF);
+        for (int i = 0; i < landmarkCount; i++)
+        {
+            landmarks.push_back(candidate);
+            forwardEngine.run(candidate);
+            vector<int> row(n);
+            for (int v = 0; v < n; v++)
+                row[v] = forwardEngine.distanceTo(v);
+            if (!symmetric)
+            {
+                backwardEngine.run(candidate);
+                vector<int> back(n);
+                for (int v = 0; v < n; v++)
+                    back[v] = backwardEngine.distanceTo(v);
+                toLandmark.push_back(move(back));
+            }
+            int best = -1;
+            for (int v = 0; v < n; v++)
+            {
+                nearest[v] = min(nearest[v], row[v]);
+                if (nearest[v] != GRAPH_INF && nearest[v] > 0 && (best == -1 || nearest[v] > nearest[best]))
+                    best = v;
+            }
+            fromLandmark.push_back(move(row));
+            if (best == -1)
+                break; // every reachable node is already a landmark
+            candidate = best;
+        }
+        fromS.resize(landmarks.size());
+        toS.resize(landmarks.size());
+        fromT.resize(landmarks.size());
+        toT.resize(landmarks.size());
+        Core::Logger::log(Core::LogLevel::INFO, "ALT preprocessing: " + to_string(landmarks.size()) + " landmarks over " + to_string(n) + " nodes");
+    }
 
-BSTNode *rightRotate(BSTNode *y)
-{
-    BSTNode *x = y->left;
-    BSTNode *T2 = x->right;
-    x->right = y;
-    y->left = T2;
-    y->height = max(height(y->left), height(y->right)) + 1;
-    x->height = max(height(x->left), height(x->right)) + 1;
-    return x;
-}
+    // Returns d(s, t), or GRAPH_INF if t is unreachable
+    int query(int s, int t)
+    {
+        settledCount = 0;
+        meetNode = -1;
+        lastSource = s;
+        if (!ready() || s < 0 || t < 0 || s >= forward->nodeCount() || t >= forward->nodeCount())
+            return GRAPH_INF;
+        if (++generation == 0)
+        {
+            fill(stampF.begin(), stampF.end(), 0);
+            fill(stampR.begin(), stampR.end(), 0);
+            fill(stampDiff.begin(), stampDiff.end(), 0);
+            generation = 1;
+        }
+        for (size_t i = 0; i < landmarks.size(); i++)
+        {
+            fromS[i] = fromLandmark[i][s];
+            toS[i] = toRow(i)[s];
+            fromT[i] = fromLandmark[i][t];
+            toT[i] = toRow(i)[t];
+        }
+        heapF.clear();
+        heapR.clear();
+        stampF[s] = generation;
+        distF[s] = 0;
+        parentF[s] = -1;
+        stampR[t] = generation;
+        distR[t] = 0;
+        parentR[t] = -1;
+        pushKey(heapF, potentialDiff(s), s);
+        pushKey(heapR, -potentialDiff(t), t);
+        long long mu = s == t ? 0 : GRAPH_INF;
+        if (s == t)
+            meetNode = s;
+
+        while (!heapF.empty() && !heapR.empty())
+        {
+            if (heapF.front().first + heapR.front().first >= 2 * mu)
+                break;
+            bool forwardSide = heapF.front().first <= heapR.front().first;
+            if (forwardSide)
+            {
+                auto [key, u] = popKey(heapF);
+                if (key != 2LL * distF[u] + potentialDiff(u))
+                    continue;
+                settledCount++;
+                for (const auto *a = forward->arcsBegin(u); a != forward->arcsEnd(u); ++a)
+                {
+                    int nd = distF[u] + a->weight;
+                    if (nd >= labelF(a->to))
+                        continue;
+                    stampF[a->to] = generation;
+                    distF[a->to] = nd;
+                    parentF[a->to] = u;
+                    pushKey(heapF, 2LL * nd + potentialDiff(a->to), a->to);
+                    int back = labelR(a->to);
+                    if (back != GRAPH_INF && nd + (long long)back < mu)
+                    {
+                        mu = nd + (long long)back;
+                        meetNode = a->to;
+                    }
+                }
+            }
+            else
+            {
+                auto [key, u] = popKey(heapR);
+                if (key != 2LL * distR[u] - potentialDiff(u))
+                    continue;
+                settledCount++;
+                for (const auto *a = backward->arcsBegin(u); a != backward->arcsEnd(u); ++a)
+                {
+                    int nd = distR[u] + a->weight;
+                    if (nd >= labelR(a->to))
+                        continue;
+                    stampR[a->to] = generation;
+                    distR[a->to] = nd;
+                    parentR[a->to] = u;
+                    pushKey(heapR, 2LL * nd - potentialDiff(a->to), a->to);
+                    int fwd = labelF(a->to);
+                    if (fwd != GRAPH_INF && nd + (long long)fwd < mu)
+                    {
+                        mu = nd + (long long)fwd;
+                        meetNode = a->to;
+                    }
+                }
+            }
+        }
+        return mu >= GRAPH_INF ? GRAPH_INF : static_cast<int>(mu);
+    }
 
-BSTNode *leftRotate(BSTNode *x)
+    // Node sequence of the last query's route, empty if none was found
+    vector<int> lastPath() const
+    {
+        vector<int> path;
+        if (meetNode == -1)
+            return path;
+        for (int v = meetNode; v != -1; v = parentF[v])
+            path.push_back(v);
+        reverse(path.begin(), path.end());
+        for (int v = parentR[meetNode]; v != -1 && stampR[meetNode] == generation; v = parentR[v])
+            path.push_back(v);
+        return path;
+    }
+};
+
+LandmarkRouter deliveryLandmarks;
+int deliveryLandmarksVersion = -1;       // topology version the tables were built on
+int deliveryLandmarksWeightVersion = -1; // weight version they were built on
+static const int DELIVERY_LANDMARKS = 8;
+
+// Landmark tables for the current delivery network. Traffic that only makes
+// roads slower keeps them: old distances still bound the new ones from
+// below, so the potentials stay feasible (just less tight). New roads,
+// cheaper roads, or any weight change on a directed graph (whose reverse
+// copy would go stale) rebuild them.
+LandmarkRouter &deliveryLandmarkRouter()
 {
-    BSTNode *y = x->right;
-    BSTNode *T2 = y->left;
-    y->left = x;
-    x->right = T2;
-    x->height = max(height(x->left), height(x->right)) + 1;
-    y->height = max(height(y->left), height(y->right)) + 1;
-    return y;
+    const DataStructures::CSRGraph &g = deliveryCSR();
+    bool weightsChanged = deliveryLandmarksWeightVersion != deliveryWeightVersion;
+    if (deliveryLandmarksVersion != deliveryTopologyVersion || deliveryWeightDropVersion > deliveryLandmarksWeightVersion ||
+        (weightsChanged && !deliveryLandmarks.isSymmetric()))
+    {
+        deliveryLandmarks.preprocess(g, DELIVERY_LANDMARKS);
+        deliveryLandmarksVersion = deliveryTopologyVersion;
+        deliveryLandmarksWeightVersion = deliveryWeightVersion;
+    }
+    return deliveryLandmarks;
 }
-
-// AVL TREE INSERTION FUNCTION: Inserts a customer into a self-balancing binary search tree
-// HOW IT WORKS:
-// 1. Base case: If node is NULL, create and return new node
-// 2. Recursive case: Insert into left subtree if key < node->key, else right
-// 3. Update height after insertion
-// 4. Calculate balance factor (height difference between left and right subtrees)
-// 5. If unbalanced (|BF| > 1), perform rotations:
-//    - Left-Left case: Right rotation
-//    - Right-Right case: Left rotation
-//    - Left-Right case: Left rotate child, then right rotate
-//    - Right-Left case: Right rotate child, then left rotate
-// ALGORITHM: AVL Tree insertion with automatic balancing
-// TIME COMPLEXITY: O(log n) - guaranteed logarithmic due to balance maintenance
-// USE CASE: Fast customer lookup by ID with guaranteed O(log n) search time
-BSTNode *insertAVL(BSTNode *node, int key, const string &name)
+
+// DELIVERY ETA DISTANCE FUNCTION: Restaurant -> customer distance via ALT
+// Returns GRAPH_INF when unreachable; fills route with the node sequence.
+int deliveryDistanceALT(int src, int dst, vector<int> *route = nullptr)
 {
-    if (!node)
+    LandmarkRouter &router = deliveryLandmarkRouter();
+    if (!route)
+        return deliveryRouteCache.distance(src, dst, deliveryGraphVersion, [&]() { return router.query(src, dst); });
+    int d = router.query(src, dst);
+    deliveryRouteCache.store(src, dst, deliveryGraphVersion, d, 0); // route requests always search
+    *route = router.lastPath();
+    return d;
+}
+
+// =============================================================
+// Contraction Hierarchies (preprocessed sub-millisecond routing)
+// =============================================================
+
+// CONTRACTION HIERARCHY: Node-ordered shortcut graph for very fast s -> t queries
+// HOW IT WORKS:
+// Preprocessing:
+// 1. Repeatedly contract the least important remaining node. Importance =
+//    2 * edge difference (shortcuts it would add - roads it removes)
+//    + already-contracted neighbours + hierarchy level reached so far
+//    (keeps contraction spread evenly over the map); the front node is
+//    re-evaluated lazily before it is contracted
+// 2. Contracting v: for each pair of remaining neighbours u, w run a
+//    bounded witness Dijkstra from u that avoids v; if no path shorter than
+//    u-v-w is found, add shortcut u-w (remembering v as its middle node).
+//    The search stops once every w is settled; its settle and hop budget
+//    is staged on the average degree of the remaining graph, so the dense
+//    top of the hierarchy, where a missed witness costs the most, gets the
+//    longest searches
+// 3. v's rank is its contraction order; every road or shortcut is stored
+//    once, on its lower-ranked end, as an "upward" arc. Rows are laid out
+//    in rank order so the top of the hierarchy, which every query visits,
+//    sits together in cache
+// Query:
+// 1. Bidirectional Dijkstra from s and t that only follows upward arcs;
+//    the best meeting node gives the distance
+// 2. Stall-on-demand: a node reachable more cheaply through a higher
+//    neighbour is not expanded
+// 3. Shortcuts are unpacked recursively through their middle nodes to
+//    recover the road-level route
+// ALGORITHM: Contraction hierarchies (Geisberger et al.)
+// TIME COMPLEXITY: Queries settle a few hundred nodes even on million-node
+//                  graphs; preprocessing is roughly O(V * witness budget)
+// CONSTRAINTS: Two-way roads (symmetric graph), non-negative weights
+// USE CASE: ETA quotes for every online order
+class ContractionHierarchy
+{
+public:
+    struct UpArc
     {
-        return createNode(key, name);
-    }
-    if (key < node->key)
+        int to;
+        int weight;
+        int middle; // -1 for an original road, else the contracted node
+    };
+
+private:
+    static const uint32_t FILE_MAGIC = 0x31484344; // "DCH1"
+
+    struct WitnessBudget
     {
-        node->left = insertAVL(node->left, key, name);
-    }
-    else if (key > node->key)
+        int settle;
+        int hops;
+    };
+
+    // Importance estimates settle at most this many nodes per witness search
+    static constexpr int WITNESS_ESTIMATE_SETTLES = 30;
+
+    // Witness search limits for the average degree of the remaining graph
+    static WitnessBudget witnessBudget(double averageDegree)
     {
-        node->right = insertAVL(node->right, key, name);
-    }
-    else
+        if (averageDegree < 3.3)
+            return {100, 3};
+        if (averageDegree < 5.0)
+            return {400, 5};
+        if (averageDegree < 8.0)
+            return {1000, 8};
+        return {2000, 12};
+    }
+
+    int n = 0;
+    uint64_t graphFingerprint = 0;
+    vector<int> rank;         // node -> rank; all query data is indexed by rank
+    vector<int> nodeOfRank;   // rank -> node
+    vector<int> upOffsets{0};
+    vector<UpArc> upArcs;     // rank space, sorted by target within each row
+
+    // Per-node query state, packed so a label check touches one cache line
+    struct Label
     {
-        return node;
+        int dist;
+        int parent;
+        uint32_t stamp;
+    };
+    vector<Label> labelsF, labelsB;
+    uint32_t generation = 0;
+    vector<pair<int, int>> heapF, heapB;
+    int settledCount = 0;
+    int meetNode = -1;
+
+    void prepareQueryState()
+    {
+        labelsF.assign(n, {GRAPH_INF, -1, 0});
+        labelsB.assign(n, {GRAPH_INF, -1, 0});
+        generation = 0;
     }
-    node->height = 1 + max(height(node->left), height(node->right));
-    int bf = balanceFactor(node);
-    if (bf > 1 && key < node->left->key)
+
+    int labelF(int v) const { return labelsF[v].stamp == generation ? labelsF[v].dist : GRAPH_INF; }
+    int labelB(int v) const { return labelsB[v].stamp == generation ? labelsB[v].dist : GRAPH_INF; }
+
+    const UpArc *findUpArc(int lower, int higher) const
     {
-        return rightRotate(node);
+        const UpArc *first = upArcs.data() + upOffsets[lower];
+        const UpArc *last = upArcs.data() + upOffsets[lower + 1];
+        const UpArc *it = lower_bound(first, last, higher, [](const UpArc &a, int v) { return a.to < v; });
+        return (it != last && it->to == higher) ? it : nullptr;
     }
-    if (bf < -1 && key > node->right->key)
+
+    // Appends the road-level nodes after a, up to and including b (ranks)
+    void unpackEdge(int a, int b, vector<int> &out) const
     {
-        return leftRotate(node);
+        const UpArc *arc = a < b ? findUpArc(a, b) : findUpArc(b, a);
+        if (!arc || arc->middle == -1)
+        {
+            out.push_back(nodeOfRank[b]);
+            return;
+        }
+        unpackEdge(a, arc->middle, out);
+        unpackEdge(arc->middle, b, out);
     }
-    if (bf > 1 && key > node->left->key)
+
+    static void pushEntry(vector<pair<int, int>> &heap, int key, int v)
     {
-        node->left = leftRotate(node->left);
-        return rightRotate(node);
+        heap.push_back({key, v});
+        push_heap(heap.begin(), heap.end(), greater<pair<int, int>>());
     }
-    if (bf < -1 && key < node->right->key)
+
+    static pair<int, int> popEntry(vector<pair<int, int>> &heap)
     {
-        node->right = rightRotate(node->right);
-        return leftRotate(node);
+        pop_heap(heap.begin(), heap.end(), greater<pair<int, int>>());
+        pair<int, int> top = heap.back();
+        heap.pop_back();
+        return top;
     }
-    return node;
-}
 
-// BST SEARCH FUNCTION: Recursively searches for a customer node by ID
-// HOW IT WORKS:
-// 1. Base case: If root is NULL, customer not found, return nullptr
-// 2. If key matches root's key, found the customer, return root
-// 3. If key < root->key, search left subtree (smaller IDs)
-// 4. If key > root->key, search right subtree (larger IDs)
-// ALGORITHM: Binary Search Tree lookup
-// TIME COMPLEXITY: O(log n) average, O(n) worst (balanced vs unbalanced)
-// USE CASE: Quick customer lookup without full linear search
-BSTNode *searchBST(BSTNode *root, int key)
-{
-    if (!root)
-        return nullptr;
-    if (key == root->key)
-        return root;
-    if (key < root->key)
-        return searchBST(root->left, key);
-    return searchBST(root->right, key);
-}
+public:
+    bool ready() const { return n > 0 && static_cast<int>(rank.size()) == n; }
+    bool matches(const DataStructures::CSRGraph &g) const { return ready() && g.nodeCount() == n && g.fingerprint() == graphFingerprint; }
+    long long upwardArcCount() const { return static_cast<long long>(upArcs.size()); }
+    int settled() const { return settledCount; }
 
-// IN-ORDER TRAVERSAL FUNCTION: Displays all customers in sorted order by ID
-// HOW IT WORKS:
-// 1. Recursively visit left subtree (smaller IDs)
-// 2. Print current node (ID and name) - this gives sorted output
-// 3. Recursively visit right subtree (larger IDs)
-// ALGORITHM: DFS (Depth-First Search) with In-Order traversal
-// TIME COMPLEXITY: O(n) - visits each node exactly once
-// USE CASE: Display all customers in ID order for management view
-void inorderBST(BSTNode *root)
-{
-    if (!root)
-        return;
-    inorderBST(root->left);
-    cout << root->key << ": " << root->name << " | ";
-    inorderBST(root->right);
-}
+    long long shortcutCount() const
+    {
+        long long count = 0;
+        for (const UpArc &a : upArcs)
+            count += a.middle != -1;
+        return count;
+    }
 
-// =============================================================
-// Graph for Delivery Route Optimization
-// =============================================================
+    // keepOrder: contract in the current node order instead of choosing a
+    // new one (see customize)
+    bool build(const DataStructures::CSRGraph &g, bool keepOrder = false)
+    {
+        int nodes = g.nodeCount();
+        keepOrder = keepOrder && ready() && nodes == n;
+        vector<int> fixedOrder = keepOrder ? nodeOfRank : vector<int>();
+        for (int u = 0; u < nodes; u++)
+        {
+            for (const auto *a = g.arcsBegin(u); a != g.arcsEnd(u); ++a)
+            {
+                if (g.arcWeight(a->to, u) != a->weight)
+                {
+                    Core::Logger::log(Core::LogLevel::ERROR, "Contraction hierarchy needs two-way roads; graph is directed");
+                    return false;
+                }
+            }
+        }
+        n = nodes;
+        graphFingerprint = g.fingerprint();
 
-static const int MAX_LOCATIONS = 20;
-int deliveryGraph[MAX_LOCATIONS][MAX_LOCATIONS];
-int locationCount = 0;
+        struct Link
+        {
+            int to;
+            int weight;
+            int middle;
+        };
+        vector<vector<Link>> adj(n);
+        for (int u = 0; u < n; u++)
+            for (const auto *a = g.arcsBegin(u); a != g.arcsEnd(u); ++a)
+                if (a->to != u) // self-loops never lie on a shortest path
+                    adj[u].push_back({a->to, a->weight, -1});
+
+        long long remainingArcs = 0;
+        for (int u = 0; u < n; u++)
+            remainingArcs += static_cast<long long>(adj[u].size());
+        int remainingNodes = n;
+        WitnessBudget budget = witnessBudget(n ? static_cast<double>(remainingArcs) / n : 0.0);
+
+        // Bounded witness search over the remaining graph, skipping `avoid`;
+        // stops at `limit`, once all nodes marked with targetGen are settled or
+        // after `settleLimit` nodes, and does not relax past budget.hops roads
+        vector<int> witnessDist(n, GRAPH_INF), witnessHops(n, 0);
+        vector<uint32_t> witnessStamp(n, 0), targetStamp(n, 0);
+        uint32_t witnessGen = 0, targetGen = 0;
+        int targetsLeft = 0;
+        vector<pair<int, int>> witnessHeap;
+        auto witnessLabel = [&](int v) { return witnessStamp[v] == witnessGen ? witnessDist[v] : GRAPH_INF; };
+        auto witnessSearch = [&](int source, int avoid, int limit, int settleLimit) {
+            witnessGen++;
+            witnessHeap.clear();
+            witnessStamp[source] = witnessGen;
+            witnessDist[source] = 0;
+            witnessHops[source] = 0;
+            pushEntry(witnessHeap, 0, source);
+            int settledNodes = 0;
+            while (!witnessHeap.empty() && settledNodes < settleLimit)
+            {
+                auto [d, u] = popEntry(witnessHeap);
+                if (d > witnessDist[u])
+                    continue;
+                if (d > limit)
+                    break;
+                settledNodes++;
+                if (targetStamp[u] == targetGen)
+                {
+                    targetStamp[u] = 0;
+                    if (--targetsLeft == 0)
+                        break;
+                }
+                if (witnessHops[u] >= budget.hops)
+                    continue;
+                for (const Link &l : adj[u])
+                {
+                    if (l.to == avoid)
+                        continue;
+                    int nd = addPathLengths(d, l.weight);
+                    if (nd < witnessLabel(l.to))
+                    {
+                        witnessStamp[l.to] = witnessGen;
+                        witnessDist[l.to] = nd;
+                        witnessHops[l.to] = witnessHops[u] + 1;
+                        pushEntry(witnessHeap, nd, l.to);
+                    }
+                }
+            }
+        };
+        auto addShortcut = [&](int a, int b, int weight, int middle) {
+            for (int side = 0; side < 2; side++)
+            {
+                int from = side == 0 ? a : b, to = side == 0 ? b : a;
+                bool found = false;
+                for (Link &l : adj[from])
+                {
+                    if (l.to != to)
+                        continue;
+                    if (weight < l.weight)
+                        l = {to, weight, middle};
+                    found = true;
+                    break;
+                }
+                if (!found)
+                {
+                    adj[from].push_back({to, weight, middle});
+                    remainingArcs++;
+                }
+            }
+        };
+        // Counts (and with apply, inserts) the shortcuts contracting v needs
+        vector<Link> around;
+        auto contractNode = [&](int v, bool apply) {
+            around = adj[v];
+            int shortcuts = 0;
+            int settleLimit = apply ? budget.settle : min(budget.settle, WITNESS_ESTIMATE_SETTLES);
+            for (size_t i = 0; i + 1 < around.size(); i++)
+            {
+                int limit = 0;
+                targetGen++;
+                targetsLeft = 0;
+                for (size_t j = i + 1; j < around.size(); j++)
+                {
+                    limit = max(limit, addPathLengths(around[i].weight, around[j].weight));
+                    if (targetStamp[around[j].to] != targetGen)
+                    {
+                        targetStamp[around[j].to] = targetGen;
+                        targetsLeft++;
+                    }
+                }
+                witnessSearch(around[i].to, v, limit, settleLimit);
+                for (size_t j = i + 1; j < around.size(); j++)
+                {
+                    int via = addPathLengths(around[i].weight, around[j].weight);
+                    if (witnessLabel(around[j].to) <= via)
+                        continue;
+                    shortcuts++;
+                    if (apply)
+                        addShortcut(around[i].to, around[j].to, via, v);
+                }
+            }
+            return shortcuts;
+        };
 
-struct AdjNode
-{
-    int dest;
-    int weight;
-    AdjNode *next;
-};
+        vector<int> deletedNeighbours(n, 0), level(n, 0);
+        rank.assign(n, -1);
+        vector<vector<UpArc>> upward(n);
+        int nextRank = 0;
+        auto contractNext = [&](int v) {
+            rank[v] = nextRank++;
+            for (const Link &l : adj[v])
+                upward[v].push_back({l.to, l.weight, l.middle});
+            contractNode(v, true);
+            for (const Link &l : adj[v])
+            {
+                auto &back = adj[l.to];
+                for (size_t i = 0; i < back.size(); i++)
+                {
+                    if (back[i].to == v)
+                    {
+                        back[i] = back.back();
+                        back.pop_back();
+                        break;
+                    }
+                }
+                deletedNeighbours[l.to]++;
+                level[l.to] = max(level[l.to], level[v] + 1);
+            }
+            remainingArcs -= 2 * static_cast<long long>(adj[v].size());
+            remainingNodes--;
+            budget = witnessBudget(remainingNodes ? static_cast<double>(remainingArcs) / remainingNodes : 0.0);
+            vector<Link>().swap(adj[v]);
+        };
 
-AdjNode *adjList[MAX_LOCATIONS];
+        if (keepOrder)
+        {
+            for (int v : fixedOrder)
+                contractNext(v);
+        }
+        else
+        {
+            auto importance = [&](int v) {
+                return 2 * (contractNode(v, false) - static_cast<int>(adj[v].size())) + deletedNeighbours[v] + level[v];
+            };
+            priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> order;
+            vector<int> queuedKey(n);
+            for (int v = 0; v < n; v++)
+            {
+                queuedKey[v] = importance(v);
+                order.push({queuedKey[v], v});
+            }
+            while (!order.empty())
+            {
+                auto [key, v] = order.top();
+                order.pop();
+                if (rank[v] != -1 || key != queuedKey[v])
+                    continue; // contracted already, or superseded by a newer key
+                int current = importance(v);
+                if (!order.empty() && current > order.top().first)
+                {
+                    queuedKey[v] = current; // lazy update: no longer the least important
+                    order.push({current, v});
+                    continue;
+                }
+                contractNext(v);
+            }
+        }
 
-void initDeliveryGraph(int nodes)
-{
-    locationCount = nodes;
-    for (int i = 0; i < nodes; i++)
-    {
-        for (int j = 0; j < nodes; j++)
+        nodeOfRank.assign(n, 0);
+        for (int v = 0; v < n; v++)
+            nodeOfRank[rank[v]] = v;
+        upOffsets.assign(n + 1, 0);
+        upArcs.clear();
+        for (int r = 0; r < n; r++)
         {
-            deliveryGraph[i][j] = (i == j) ? 0 : 99999;
+            vector<UpArc> &row = upward[nodeOfRank[r]];
+            for (UpArc &a : row)
+            {
+                a.to = rank[a.to];
+                if (a.middle != -1)
+                    a.middle = rank[a.middle];
+            }
+            sort(row.begin(), row.end(), [](const UpArc &a, const UpArc &b) { return a.to < b.to; });
+            upOffsets[r] = static_cast<int>(upArcs.size());
+            upArcs.insert(upArcs.end(), row.begin(), row.end());
+            vector<UpArc>().swap(row);
         }
-        adjList[i] = nullptr;
+        upOffsets[n] = static_cast<int>(upArcs.size());
+        prepareQueryState();
+        Core::Logger::log(Core::LogLevel::INFO, string(keepOrder ? "Contraction hierarchy customised: " : "Contraction hierarchy built: ") +
+                                                    to_string(n) + " nodes, " + to_string(shortcutCount()) + " shortcuts");
+        return true;
     }
-}
 
-void addDeliveryEdge(int u, int v, int w)
-{
-    deliveryGraph[u][v] = w;
-    deliveryGraph[v][u] = w;
-    AdjNode *node = new AdjNode();
-    node->dest = v;
-    node->weight = w;
-    node->next = adjList[u];
-    adjList[u] = node;
-    AdjNode *node2 = new AdjNode();
-    node2->dest = u;
-    node2->weight = w;
-    node2->next = adjList[v];
-    adjList[v] = node2;
-}
+    // CUSTOMIZE FUNCTION: Refreshes the hierarchy after road weights changed
+    // Keeps the node order and only redoes the contraction (witness searches
+    // with the new weights), skipping the importance ordering. The caller
+    // guarantees the roads themselves are unchanged; otherwise use build.
+    bool customize(const DataStructures::CSRGraph &g) { return build(g, true); }
 
-void displayDeliveryGraph()
-{
-    cout << "\nDelivery Location Graph (Adjacency Matrix):\n";
-    for (int i = 0; i < locationCount; i++)
+    // Returns d(s, t), or GRAPH_INF if t is unreachable
+    int query(int s, int t)
     {
-        for (int j = 0; j < locationCount; j++)
+        settledCount = 0;
+        meetNode = -1;
+        if (!ready() || s < 0 || t < 0 || s >= n || t >= n)
+            return GRAPH_INF;
+        if (++generation == 0)
         {
-            cout << setw(6) << deliveryGraph[i][j] << " ";
+            for (Label &l : labelsF)
+                l.stamp = 0;
+            for (Label &l : labelsB)
+                l.stamp = 0;
+            generation = 1;
         }
-        cout << "\n";
+        s = rank[s];
+        t = rank[t];
+        heapF.clear();
+        heapB.clear();
+        labelsF[s] = {0, -1, generation};
+        labelsB[t] = {0, -1, generation};
+        pushEntry(heapF, 0, s);
+        pushEntry(heapB, 0, t);
+        int mu = GRAPH_INF;
+
+        while (true)
+        {
+            int topF = heapF.empty() ? GRAPH_INF : heapF.front().first;
+            int topB = heapB.empty() ? GRAPH_INF : heapB.front().first;
+            if (min(topF, topB) >= mu)
+                break;
+            bool forwardSide = topF <= topB;
+            auto &heap = forwardSide ? heapF : heapB;
+            vector<Label> &labels = forwardSide ? labelsF : labelsB;
+
+            auto [d, u] = popEntry(heap);
+            if (d > labels[u].dist)
+                continue;
+            int other = forwardSide ? labelB(u) : labelF(u);
+            if (other != GRAPH_INF && addPathLengths(d, other) < mu)
+            {
+                mu = addPathLengths(d, other);
+                meetNode = u;
+            }
+            const UpArc *first = upArcs.data() + upOffsets[u];
+            const UpArc *last = upArcs.data() + upOffsets[u + 1];
+            bool stalled = false;
+            for (const UpArc *a = first; a != last && !stalled; ++a)
+            {
+                const Label &l = labels[a->to];
+                stalled = l.stamp == generation && l.dist != GRAPH_INF && addPathLengths(l.dist, a->weight) < d;
+            }
+            if (stalled)
+                continue;
+            settledCount++;
+            for (const UpArc *a = first; a != last; ++a)
+            {
+                int nd = addPathLengths(d, a->weight);
+                Label &l = labels[a->to];
+                if (l.stamp != generation || nd < l.dist)
+                {
+                    l = {nd, u, generation};
+                    pushEntry(heap, nd, a->to);
+                }
+            }
+        }
+        return mu;
     }
-}
 
-// BFS (BREADTH-FIRST SEARCH): Explores delivery graph level-by-level from start location
-// HOW IT WORKS:
-// 1. Mark start vertex as visited and enqueue it
-// 2. While queue is not empty:
-//    a. Dequeue a vertex
-//    b. Print/process it
-//    c. Mark all unvisited neighbors as visited and enqueue them
-// 3. Result: Visits vertices in order of distance from source
-// ALGORITHM: Queue-based graph traversal
-// TIME COMPLEXITY: O(V+E) where V=vertices, E=edges
-// USE CASE: Find all reachable delivery locations from a starting point
-void bfsDelivery(int start)
-{
-    bool visited[MAX_LOCATIONS];
-    memset(visited, false, sizeof(visited));
-    int q[MAX_LOCATIONS];
-    int front = 0, rear = 0;
-    visited[start] = true;
-    q[rear++] = start;
-    cout << "BFS traversal from location " << start << ": ";
-    while (front < rear)
-    {
-        int u = q[front++];
-        cout << u << " ";
-        AdjNode *cur = adjList[u];
-        while (cur)
-        {
-            if (!visited[cur->dest])
+    // Road-level node sequence of the last query, empty if none was found
+    vector<int> lastPath() const
+    {
+        vector<int> path;
+        if (meetNode == -1)
+            return path;
+        vector<int> up;
+        for (int v = meetNode; v != -1; v = labelsF[v].parent)
+            up.push_back(v);
+        reverse(up.begin(), up.end());
+        path.push_back(nodeOfRank[up[0]]);
+        for (size_t i = 1; i < up.size(); i++)
+            unpackEdge(up[i - 1], up[i], path);
+        for (int v = meetNode; labelsB[v].parent != -1; v = labelsB[v].parent)
+            unpackEdge(v, labelsB[v].parent, path);
+        return path;
+    }
+
+    // SAVE FUNCTION: Writes the hierarchy in a compact binary layout
+    // Layout: magic, node count, arc count, graph fingerprint, ranks,
+    // row offsets, then (to, weight, middle) triples
+    void save(const string &filename) const
+    {
+        ofstream file(filename, ios::binary);
+        if (!file.is_open())
+            throw Core::CustomException(Core::ErrorCode::FILE_ERROR, "Cannot open file: " + filename);
+        uint32_t magic = FILE_MAGIC;
+        int64_t arcs = static_cast<int64_t>(upArcs.size());
+        file.write(reinterpret_cast<const char *>(&magic), sizeof(magic));
+        file.write(reinterpret_cast<const char *>(&n), sizeof(n));
+        file.write(reinterpret_cast<const char *>(&arcs), sizeof(arcs));
+        file.write(reinterpret_cast<const char *>(&graphFingerprint), sizeof(graphFingerprint));
+        file.write(reinterpret_cast<const char *>(rank.data()), sizeof(int) * rank.size());
+        file.write(reinterpret_cast<const char *>(upOffsets.data()), sizeof(int) * upOffsets.size());
+        file.write(reinterpret_cast<const char *>(upArcs.data()), sizeof(UpArc) * upArcs.size());
+        Core::Logger::log(Core::LogLevel::INFO, "Contraction hierarchy saved to " + filename);
+    }
+
+    void load(const string &filename)
+    {
+        ifstream file(filename, ios::binary);
+        if (!file.is_open())
+            throw Core::CustomException(Core::ErrorCode::FILE_ERROR, "Cannot open file: " + filename);
+        uint32_t magic = 0;
+        int nodes = 0;
+        int64_t arcs = 0;
+        uint64_t fingerprint = 0;
+        file.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+        file.read(reinterpret_cast<char *>(&nodes), sizeof(nodes));
+        file.read(reinterpret_cast<char *>(&arcs), sizeof(arcs));
+        file.read(reinterpret_cast<char *>(&fingerprint), sizeof(fingerprint));
+        if (!file || magic != FILE_MAGIC || nodes < 0 || arcs < 0)
+            throw Core::CustomException(Core::ErrorCode::FILE_ERROR, "Not a contraction hierarchy file: " + filename);
+        // Sizes are checked against the file before anything is allocated
+        error_code sizeError;
+        uintmax_t fileBytes = filesystem::file_size(filename, sizeError);
+        uintmax_t headerBytes = sizeof(magic) + sizeof(nodes) + sizeof(arcs) + sizeof(fingerprint);
+        if (sizeError || arcs > numeric_limits<int>::max() ||
+            fileBytes != headerBytes + sizeof(int) * (2 * static_cast<uintmax_t>(nodes) + 1) + sizeof(UpArc) * static_cast<uintmax_t>(arcs))
+            throw Core::CustomException(Core::ErrorCode::FILE_ERROR, "Truncated contraction hierarchy file: " + filename);
+        vector<int> ranks(nodes), offsets(nodes + 1);
+        vector<UpArc> arcList(arcs);
+        file.read(reinterpret_cast<char *>(ranks.data()), sizeof(int) * ranks.size());
+        file.read(reinterpret_cast<char *>(offsets.data()), sizeof(int) * offsets.size());
+        file.read(reinterpret_cast<char *>(arcList.data()), sizeof(UpArc) * arcList.size());
+        if (!file)
+            throw Core::CustomException(Core::ErrorCode::FILE_ERROR, "Truncated contraction hierarchy file: " + filename);
+        // Upward arcs lead to higher ranks and shortcuts unpack through lower
+        // ones, so query() and unpackEdge() stay in bounds and terminate
+        bool consistent = offsets[0] == 0 && offsets[nodes] == arcs;
+        for (int r = 0; r < nodes && consistent; r++)
+        {
+            consistent = offsets[r] <= offsets[r + 1];
+            for (int k = offsets[r]; k < offsets[r + 1] && consistent; k++)
             {
-                visited[cur->dest] = true;
-                q[rear++] = cur->dest;
+                const UpArc &a = arcList[k];
+                consistent = a.to > r && a.to < nodes && a.weight >= 0 && a.middle >= -1 && a.middle < r;
             }
-            cur = cur->next;
         }
+        if (!consistent)
+            throw Core::CustomException(Core::ErrorCode::FILE_ERROR, "Corrupt contraction hierarchy file: " + filename);
+        nodeOfRank.assign(nodes, -1);
+        for (int v = 0; v < nodes; v++)
+        {
+            if (ranks[v] < 0 || ranks[v] >= nodes || nodeOfRank[ranks[v]] != -1)
+                throw Core::CustomException(Core::ErrorCode::FILE_ERROR, "Corrupt node order in " + filename);
+            nodeOfRank[ranks[v]] = v;
+        }
+        n = nodes;
+        graphFingerprint = fingerprint;
+        rank = move(ranks);
+        upOffsets = move(offsets);
+        upArcs = move(arcList);
+        prepareQueryState();
+        Core::Logger::log(Core::LogLevel::INFO, "Contraction hierarchy loaded from " + filename);
     }
-    cout << "\n";
+};
+
+ContractionHierarchy deliveryCH;
+int deliveryCHVersion = -1;
+int deliveryCHTopologyVersion = -1;
+
+// Hierarchy built for the current delivery network, or nullptr. Never
+// builds one: contraction takes seconds on large maps, so it only happens
+// in rebuildDeliveryHierarchy, and queries fall back to ALT meanwhile.
+ContractionHierarchy *currentDeliveryHierarchy()
+{
+    return deliveryCHVersion == deliveryGraphVersion && deliveryCH.ready() ? &deliveryCH : nullptr;
 }
 
-void dfsDeliveryUtil(int u, bool visited[])
+// REBUILD DELIVERY HIERARCHY FUNCTION: Prepares the hierarchy for the current network
+// After weight-only changes the current hierarchy is re-customised in its
+// node order. Otherwise cachePath is reused when it holds a hierarchy for
+// this exact graph, or the graph is contracted from scratch and written to
+// cachePath; an empty path skips the disk.
+// Returns false when no hierarchy can be built (directed graphs).
+bool rebuildDeliveryHierarchy(const string &cachePath)
 {
-    visited[u] = true;
-    cout << u << " ";
-    AdjNode *cur = adjList[u];
-    while (cur)
+    const DataStructures::CSRGraph &g = deliveryCSR();
+    if (deliveryCHVersion == deliveryGraphVersion && deliveryCH.ready())
+        return true;
+    bool sameRoads = deliveryCH.ready() && deliveryCHTopologyVersion == deliveryTopologyVersion;
+    deliveryCHVersion = deliveryGraphVersion;
+    deliveryCHTopologyVersion = deliveryTopologyVersion;
+    if (sameRoads)
+    {
+        if (deliveryCH.customize(g))
+            return true;
+        deliveryCH = ContractionHierarchy();
+        return false;
+    }
+    if (!cachePath.empty() && filesystem::exists(cachePath))
     {
-        if (!visited[cur->dest])
+        try
+        {
+            ContractionHierarchy cached;
+            cached.load(cachePath);
+            if (cached.matches(g))
+            {
+                deliveryCH = move(cached);
+                return true;
+            }
+        }
+        catch (const Core::CustomException &e)
         {
-            dfsDeliveryUtil(cur->dest, visited);
+            Core::Logger::log(Core::LogLevel::WARNING, string("Ignoring hierarchy cache: ") + e.what());
         }
-        cur = cur->next;
+        catch (const bad_alloc &)
+        {
+            Core::Logger::log(Core::LogLevel::WARNING, "Ignoring hierarchy cache: out of memory reading " + cachePath);
+        }
+    }
+    if (!deliveryCH.build(g))
+    {
+        deliveryCH = ContractionHierarchy();
+        return false;
     }
+    if (!cachePath.empty())
+    {
+        try
+        {
+            deliveryCH.save(cachePath);
+        }
+        catch (const Core::CustomException &e)
+        {
+            Core::Logger::log(Core::LogLevel::WARNING, string("Hierarchy not cached: ") + e.what());
+        }
+    }
+    return true;
 }
 
-// DFS (DEPTH-FIRST SEARCH): Explores delivery graph deeply before backtracking
-// HOW IT WORKS:
-// 1. Mark starting vertex as visited and print it
-// 2. For each adjacent unvisited vertex:
-//    a. Recursively call DFS on that vertex
-// 3. Continues until dead-end, then backtracks to explore other branches
-// ALGORITHM: Recursive stack-based graph traversal
-// TIME COMPLEXITY: O(V+E) where V=vertices, E=edges
-// USE CASE: Detect connectivity, find delivery paths, topological sorting
-void dfsDelivery(int start)
+// DELIVERY ETA DISTANCE (CH) FUNCTION: Restaurant -> customer distance via the hierarchy
+// Falls back to ALT while the hierarchy is missing or older than the network.
+int deliveryDistanceCH(int src, int dst, vector<int> *route = nullptr)
 {
-    bool visited[MAX_LOCATIONS];
-    memset(visited, false, sizeof(visited));
-    cout << "DFS traversal from location " << start << ": ";
-    dfsDeliveryUtil(start, visited);
-    cout << "\n";
+    ContractionHierarchy *current = currentDeliveryHierarchy();
+    if (!current)
+        return deliveryDistanceALT(src, dst, route);
+    ContractionHierarchy &ch = *current;
+    if (!route)
+        return deliveryRouteCache.distance(src, dst, deliveryGraphVersion, [&]() { return ch.query(src, dst); });
+    int d = ch.query(src, dst);
+    deliveryRouteCache.store(src, dst, deliveryGraphVersion, d, 0); // route requests always search
+    *route = ch.lastPath();
+    return d;
 }
 
 // =============================================================
@@ -1431,30 +7129,16 @@ void dijkstra(int graph[MAX_LOCATIONS][MAX_LOCATIONS], int src, int n)
         }
     }
     cout << "\nDijkstra - Shortest delivery distances from location " << src << ":\n";
-    for (int i = 0; i < n; i++)
-    {
-        cout << "Location " << i << " -> Distance: " << dist[i] << " units\n";
-    }
-}
-
-// =============================================================
-// Prim's MST for Optimal Delivery Network
-// =============================================================
-
-int minKey(int key[], bool mstSet[], int n)
-{
-    int minVal = 1e9, minIdx = -1;
-    for (int v = 0; v < n; v++)
-    {
-        if (!mstSet[v] && key[v] < minVal)
-        {
-            minVal = key[v];
-            minIdx = v;
-        }
+    for (int i = 0; i < n; i++)
+    {
+        cout << "Location " << i << " -> Distance: " << dist[i] << " units\n";
     }
-    return minIdx;
 }
 
+// =============================================================
+// Prim's MST for Optimal Delivery Network
+// =============================================================
+
 // PRIM'S MINIMUM SPANNING TREE ALGORITHM: Finds minimum cost to connect all locations
 // HOW IT WORKS:
 // 1. Initialize: Start with vertex 0, mark it as in MST, set key value = 0
@@ -1463,40 +7147,18 @@ int minKey(int key[], bool mstSet[], int n)
 //    a. Pick vertex with minimum key value not yet in MST
 //    b. Add it to MST and mark as visited
 //    c. Update key values of adjacent vertices if new weight is smaller
-// 4. Output MST edges and total cost
+// 4. Output MST edges and total cost (the scan itself is densePrimMST)
 // ALGORITHM: Prim's MST (greedy, grows tree from starting vertex)
 // TIME COMPLEXITY: O(n²) with array, O(ElogV) with priority queue
 // USE CASE: Design optimal delivery network connecting all locations with minimum cost
 void primMST(int graph[MAX_LOCATIONS][MAX_LOCATIONS], int n)
 {
-    int parent[MAX_LOCATIONS];
-    int key[MAX_LOCATIONS];
-    bool mstSet[MAX_LOCATIONS];
-    for (int i = 0; i < n; i++)
-    {
-        key[i] = 1e9;
-        mstSet[i] = false;
-    }
-    key[0] = 0;
-    parent[0] = -1;
-    for (int count = 0; count < n - 1; count++)
-    {
-        int u = minKey(key, mstSet, n);
-        mstSet[u] = true;
-        for (int v = 0; v < n; v++)
-        {
-            if (graph[u][v] && !mstSet[v] && graph[u][v] < key[v])
-            {
-                parent[v] = u;
-                key[v] = graph[u][v];
-            }
-        }
-    }
+    SpanningForest forest = densePrimMST(&graph[0][0], MAX_LOCATIONS, n);
     cout << "\nPrim's MST - Optimal Delivery Network Edges:\n";
     for (int i = 1; i < n; i++)
     {
-        if (parent[i] != -1) {
-            cout << parent[i] << " - " << i << " : " << graph[i][parent[i]] << " units\n";
+        if (forest.parent[i] != -1) {
+            cout << forest.parent[i] << " - " << i << " : " << graph[i][forest.parent[i]] << " units\n";
         }
     }
 }
@@ -1510,77 +7172,518 @@ struct Edge {
     int weight;
 };
 
+// Runs on the CSR network, so it is not limited to MAX_LOCATIONS; per-node
+// results are printed for the first n locations of small graphs only.
 void dijkstraOptimized(int src, int n) {
-    vector<int> dist(n, 1e9);
-    vector<int> parent(n, -1);
-    priority_queue<pair<int,int>, vector<pair<int,int>>, greater<pair<int,int>>> pq;
-    
-    dist[src] = 0;
-    pq.push({0, src});
-    
-    while (!pq.empty()) {
-        auto [d, u] = pq.top();
-        pq.pop();
-        
-        if (d > dist[u]) continue;
-        
-        for (int v = 0; v < n; v++) {
-            if (deliveryGraph[u][v] && dist[u] + deliveryGraph[u][v] < dist[v]) {
-                dist[v] = dist[u] + deliveryGraph[u][v];
-                parent[v] = u;
-                pq.push({dist[v], v});
-            }
-        }
-    }
-    
+    const DataStructures::CSRGraph& g = deliveryCSR();
+    ShortestPathTree tree = csrDijkstra(g, src);
+    n = min(n, g.nodeCount());
+
     Core::Logger::log(Core::LogLevel::INFO, "Dijkstra Optimized Results");
     cout << "\nDijkstra (Optimized) - Shortest Routes from Location " << src << ":\n";
-    for (int i = 0; i < n; i++) {
-        cout << "Location " << i << " -> Distance: " << (dist[i] == 1e9 ? -1 : dist[i]);
-        if (parent[i] != -1) cout << " (via " << parent[i] << ")";
-        cout << "\n";
+    if (n <= DELIVERY_PRINT_LIMIT) {
+        for (int i = 0; i < n; i++) {
+            cout << "Location " << i << " -> Distance: " << (tree.dist[i] == GRAPH_INF ? -1 : tree.dist[i]);
+            if (tree.parent[i] != -1) cout << " (via " << tree.parent[i] << ")";
+            cout << "\n";
+        }
+        return;
     }
+    int reached = 0, farthest = src;
+    for (int i = 0; i < g.nodeCount(); i++) {
+        if (tree.dist[i] == GRAPH_INF) continue;
+        reached++;
+        if (tree.dist[i] > tree.dist[farthest]) farthest = i;
+    }
+    cout << "Reachable locations: " << reached << " of " << g.nodeCount() << "\n";
+    cout << "Farthest location: " << farthest << " at distance " << tree.dist[farthest] << "\n";
 }
 
 // =============================================================
 // IMPROVED PRIM'S MST WITH PRIORITY QUEUE - O(ElogV)
 // =============================================================
 
+// Runs on the CSR network; n is kept for the existing call sites.
 void primMSTOptimized(int n) {
-    vector<bool> inMST(n, false);
-    vector<int> key(n, 1e9);
-    vector<int> parent(n, -1);
-    priority_queue<pair<int,int>, vector<pair<int,int>>, greater<pair<int,int>>> pq;
-    
-    key[0] = 0;
-    pq.push({0, 0});
-    
-    while (!pq.empty()) {
-        auto [k, u] = pq.top();
-        pq.pop();
-        
-        if (inMST[u]) continue;
-        inMST[u] = true;
-        
-        for (int v = 0; v < n; v++) {
-            if (deliveryGraph[u][v] && !inMST[v] && deliveryGraph[u][v] < key[v]) {
-                key[v] = deliveryGraph[u][v];
-                parent[v] = u;
-                pq.push({key[v], v});
+    const DataStructures::CSRGraph& g = deliveryCSR();
+    SpanningForest forest = csrPrimMST(g);
+    (void)n;
+
+    Core::Logger::log(Core::LogLevel::INFO, "Prim's MST Optimized Results");
+    cout << "\nPrim's MST (Optimized) - Minimum Spanning Tree:\n";
+    if (g.nodeCount() <= DELIVERY_PRINT_LIMIT) {
+        for (int i = 0; i < g.nodeCount(); i++) {
+            if (forest.parent[i] != -1) {
+                cout << forest.parent[i] << " - " << i << " : " << g.arcWeight(i, forest.parent[i]) << " units\n";
             }
         }
+    } else {
+        cout << "Tree edges: " << forest.edgeCount << ", components: " << forest.components << "\n";
     }
-    
-    Core::Logger::log(Core::LogLevel::INFO, "Prim's MST Optimized Results");
-    cout << "\nPrim's MST (Optimized) - Minimum Spanning Tree:\n";
-    int totalCost = 0;
-    for (int i = 1; i < n; i++) {
-        if (parent[i] != -1 && parent[i] >= 0 && parent[i] < n) {
-            cout << parent[i] << " - " << i << " : " << deliveryGraph[i][parent[i]] << " units\n";
-            totalCost += deliveryGraph[i][parent[i]];
+    cout << "Total MST Cost: " << forest.totalCost << "\n";
+}
+
+// =============================================================
+// KRUSKAL / BORUVKA MST ON THE DELIVERY NETWORK
+// =============================================================
+
+// Kruskal (sorted edges + union-find) by default; Boruvka's parallel rounds
+// for large networks
+void kruskalMST(bool boruvka) {
+    const DataStructures::CSRGraph& g = deliveryCSR();
+    auto start = chrono::steady_clock::now();
+    SpanningForest forest = boruvka ? csrBoruvkaMST(g) : csrKruskalMST(g);
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    string name = boruvka ? "Boruvka's" : "Kruskal's";
+    Core::Logger::log(Core::LogLevel::INFO, name + " MST Results");
+    cout << "\n" << name << " MST - Minimum Spanning Tree:\n";
+    if (g.nodeCount() <= DELIVERY_PRINT_LIMIT) {
+        for (int i = 0; i < g.nodeCount(); i++) {
+            if (forest.parent[i] != -1) {
+                cout << forest.parent[i] << " - " << i << " : " << g.arcWeight(forest.parent[i], i) << " units\n";
+            }
+        }
+    } else {
+        cout << "Tree edges: " << forest.edgeCount << ", components: " << forest.components << "\n";
+    }
+    cout << "Total MST Cost: " << forest.totalCost << " (" << fixed << setprecision(2) << ms << " ms)\n";
+}
+
+// =============================================================
+// STREAMING LEADERBOARDS (refreshed per event, O(log K))
+// =============================================================
+
+static const int LEADERBOARD_K = 10;
+static const int HEAVY_HITTER_COUNTERS = 64;
+
+DataStructures::TopKTracker<int, double> spendLeaderboard(LEADERBOARD_K);   // customer id -> lifetime spend
+DataStructures::TopKTracker<int, int> loyaltyLeaderboard(LEADERBOARD_K);    // customer id -> loyalty points
+DataStructures::TopKTracker<string, int> dishLeaderboard(LEADERBOARD_K);    // dish name -> times ordered
+DataStructures::SpaceSavingSketch<string> dishHeavyHitters(HEAVY_HITTER_COUNTERS);
+
+// =============================================================
+// LOYALTY LEDGER (append-only point events)
+// =============================================================
+
+enum class LoyaltyEventType { ACCRUAL, REDEMPTION, EXPIRY, ADJUSTMENT };
+
+inline string loyaltyEventToString(LoyaltyEventType type) {
+    switch (type) {
+        case LoyaltyEventType::ACCRUAL: return "ACCRUAL";
+        case LoyaltyEventType::REDEMPTION: return "REDEMPTION";
+        case LoyaltyEventType::EXPIRY: return "EXPIRY";
+        case LoyaltyEventType::ADJUSTMENT: return "ADJUSTMENT";
+        default: return "UNKNOWN";
+    }
+}
+
+struct LoyaltyEvent {
+    long long sequence;
+    int customerId;
+    LoyaltyEventType type;
+    int delta;          // signed change in points
+    time_t timestamp;
+    int billId;         // 0 when not tied to a bill
+    string note;
+};
+
+// LOYALTY LEDGER: Event log with materialized balances and per-account checkpoints
+// HOW IT WORKS:
+// 1. Every change to a customer's points is appended as an immutable event;
+//    nothing is ever edited or removed, so history answers disputes
+// 2. The current balance per customer is updated as each event is appended
+// 3. Each account keeps the indexes of its own events plus the balance before
+//    every CHECKPOINT_EVERY-th of them
+// 4. balanceAt(t) binary-searches the account's events for the last one at or
+//    before t, starts from the nearest checkpoint and replays fewer than
+//    CHECKPOINT_EVERY events instead of the whole log
+// TIME COMPLEXITY: append O(1), balance O(1), balanceAt O(log E + CHECKPOINT_EVERY)
+class LoyaltyLedger {
+private:
+    static const int CHECKPOINT_EVERY = 32;
+
+    struct Account {
+        int balance = 0;
+        vector<int> eventIndexes;   // positions in the global log, time-ordered
+        vector<int> checkpoints;    // balance before eventIndexes[j * CHECKPOINT_EVERY]
+    };
+
+    vector<LoyaltyEvent> events;
+    unordered_map<int, Account> accounts;
+
+public:
+    const LoyaltyEvent& append(int customerId, LoyaltyEventType type, int delta,
+                               int billId = 0, const string& note = "", time_t when = 0) {
+        time_t stamp = when ? when : time(nullptr);
+        // Keep the log time-ordered so point-in-time queries can binary search
+        if (!events.empty() && stamp < events.back().timestamp) stamp = events.back().timestamp;
+
+        Account& account = accounts[customerId];
+        if (account.eventIndexes.size() % CHECKPOINT_EVERY == 0) account.checkpoints.push_back(account.balance);
+        account.eventIndexes.push_back(static_cast<int>(events.size()));
+        account.balance += delta;
+        events.push_back({static_cast<long long>(events.size()) + 1, customerId, type, delta, stamp, billId, note});
+        return events.back();
+    }
+
+    int balance(int customerId) const {
+        auto it = accounts.find(customerId);
+        return it == accounts.end() ? 0 : it->second.balance;
+    }
+
+    int balanceAt(int customerId, time_t when) const {
+        auto it = accounts.find(customerId);
+        if (it == accounts.end()) return 0;
+        const Account& account = it->second;
+        auto last = upper_bound(account.eventIndexes.begin(), account.eventIndexes.end(), when,
+                                [this](time_t t, int idx) { return t < events[idx].timestamp; });
+        int upto = static_cast<int>(last - account.eventIndexes.begin());
+        if (upto == 0) return 0;
+        int block = min((upto - 1) / CHECKPOINT_EVERY, static_cast<int>(account.checkpoints.size()) - 1);
+        int bal = account.checkpoints[block];
+        for (int j = block * CHECKPOINT_EVERY; j < upto; j++) bal += events[account.eventIndexes[j]].delta;
+        return bal;
+    }
+
+    // Points from events at or before `cutoff` that are still unspent now,
+    // taking the oldest points as spent first: the balance at the cutoff
+    // less everything deducted since. O(log E + events since the cutoff)
+    int unspentBefore(int customerId, time_t cutoff) const {
+        auto it = accounts.find(customerId);
+        if (it == accounts.end()) return 0;
+        const Account& account = it->second;
+        auto since = upper_bound(account.eventIndexes.begin(), account.eventIndexes.end(), cutoff,
+                                 [this](time_t t, int idx) { return t < events[idx].timestamp; });
+        int deducted = 0;
+        for (; since != account.eventIndexes.end(); ++since)
+            if (events[*since].delta < 0) deducted -= events[*since].delta;
+        return max(0, balanceAt(customerId, cutoff) - deducted);
+    }
+
+    // Full replay, kept for audits and to cross-check balanceAt
+    int replayBalanceAt(int customerId, time_t when) const {
+        int bal = 0;
+        for (const LoyaltyEvent& e : events) {
+            if (e.timestamp > when) break;
+            if (e.customerId == customerId) bal += e.delta;
+        }
+        return bal;
+    }
+
+    vector<LoyaltyEvent> history(int customerId) const {
+        vector<LoyaltyEvent> result;
+        auto it = accounts.find(customerId);
+        if (it == accounts.end()) return result;
+        for (int idx : it->second.eventIndexes) result.push_back(events[idx]);
+        return result;
+    }
+
+    size_t eventCount() const { return events.size(); }
+
+    void clear() {
+        events.clear();
+        accounts.clear();
+    }
+};
+
+LoyaltyLedger loyaltyLedger;
+
+// =============================================================
+// SEARCH INDEXES (maintained incrementally on insert)
+// =============================================================
+
+DataStructures::RadixTrie customerNameTrie;  // ranked by loyalty points
+DataStructures::RadixTrie menuNameTrie;      // ranked by order popularity
+unordered_map<int, int> customerSlotById;    // customer id -> customerRecords slot
+unordered_map<int, int> menuSlotById;        // menu item id -> menuItems slot
+unordered_map<string, int> menuPopularity;   // dish name -> times ordered
+int customerDataEpoch = 0;                   // bumped when customerRecords is reloaded
+
+static const int AUTOCOMPLETE_NODE_BUDGET = 256;
+
+// SymSpell-style fuzzy term dictionary
+// Every distinct term contributes all strings reachable by deleting up to
+// maxDistance characters from its first prefixLength characters. A query
+// generates its own deletes; any shared delete string yields a candidate,
+// which is then verified with the bit-parallel Damerau kernel.
+// NOTE: Terms longer than prefixLength are matched on their prefix first, so
+// edits that shift characters across the prefix boundary may be missed.
+class FuzzyTermIndex {
+private:
+    int maxDistance;
+    int prefixLength;
+    vector<string> terms;
+    vector<vector<int>> postings;             // term id -> record slots
+    unordered_map<string, int> termIds;
+    unordered_map<size_t, vector<int>> deletes; // hash(delete string) -> term ids
+    vector<int> seenStamp;
+    int stamp = 0;
+
+    void collectDeletes(const string& word, int depth, unordered_set<string>& out) const {
+        if (!out.insert(word).second || depth == maxDistance) return;
+        for (size_t i = 0; i < word.size(); i++) {
+            collectDeletes(word.substr(0, i) + word.substr(i + 1), depth + 1, out);
+        }
+    }
+
+    static string normalize(const string& s) {
+        string out = s;
+        for (char& c : out) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+        return out;
+    }
+
+public:
+    struct Match {
+        int slot;
+        int distance;
+    };
+
+    FuzzyTermIndex(int maxDist, int prefixLen) : maxDistance(maxDist), prefixLength(prefixLen) {}
+
+    void clear() {
+        terms.clear();
+        postings.clear();
+        termIds.clear();
+        deletes.clear();
+        seenStamp.clear();
+    }
+
+    // ADD TERM FUNCTION: Registers a term (name token or email) for a record slot
+    // TIME COMPLEXITY: O(1) for a known term; O(p^k) deletes for a new term
+    void addTerm(const string& rawTerm, int slot) {
+        string term = normalize(rawTerm);
+        if (term.empty()) return;
+        auto it = termIds.find(term);
+        if (it != termIds.end()) {
+            postings[it->second].push_back(slot);
+            return;
+        }
+        int id = static_cast<int>(terms.size());
+        terms.push_back(term);
+        postings.push_back({slot});
+        termIds[term] = id;
+        seenStamp.push_back(0);
+        unordered_set<string> dels;
+        collectDeletes(term.substr(0, prefixLength), 0, dels);
+        hash<string> hasher;
+        for (const string& d : dels) deletes[hasher(d)].push_back(id);
+    }
+
+    // FUZZY LOOKUP FUNCTION: Returns record slots whose term is within k edits
+    // HOW IT WORKS:
+    // 1. Generate deletes of the query prefix (at most k characters removed)
+    // 2. Union the term ids stored under each delete (stamp array dedupes)
+    // 3. Verify each candidate's full term with the bit-parallel kernel
+    // ALGORITHM: Symmetric delete spelling correction + Myers/Hyyro verification
+    // TIME COMPLEXITY: O(p^k + candidates * |term|/w) - independent of dictionary size
+    vector<Match> search(const string& rawQuery, int k) {
+        vector<Match> matches;
+        string query = normalize(rawQuery);
+        if (query.empty()) return matches;
+        k = min(k, maxDistance);
+        stamp++;
+        unordered_set<string> dels;
+        collectDeletes(query.substr(0, prefixLength), 0, dels);
+        Algorithms::BitParallelPattern pattern(query);
+        hash<string> hasher;
+        for (const string& d : dels) {
+            auto it = deletes.find(hasher(d));
+            if (it == deletes.end()) continue;
+            for (int id : it->second) {
+                if (seenStamp[id] == stamp) continue;
+                seenStamp[id] = stamp;
+                int dist = Algorithms::damerauDistanceBitParallel(pattern, terms[id], k);
+                if (dist > k) continue;
+                for (int slot : postings[id]) matches.push_back({slot, dist});
+            }
+        }
+        return matches;
+    }
+
+    int termCount() const { return static_cast<int>(terms.size()); }
+};
+
+static const int FUZZY_MAX_DISTANCE = 2;
+FuzzyTermIndex customerNameFuzzy(FUZZY_MAX_DISTANCE, 12);
+FuzzyTermIndex customerEmailFuzzy(FUZZY_MAX_DISTANCE, 8);
+
+// Phonetic index: Double Metaphone key -> customer slots. Keys are computed
+// once per name token at insert time and cached per slot, so lookups never
+// re-encode stored names.
+unordered_map<string, vector<int>> phoneticIndex;
+vector<string> customerPhoneticKeys[MAX_CUSTOMERS];
+
+// Splits a name into whitespace-separated word tokens for the fuzzy index
+vector<string> tokenizeName(const string& name) {
+    vector<string> tokens;
+    stringstream ss(name);
+    string word;
+    while (ss >> word) tokens.push_back(word);
+    return tokens;
+}
+
+// INDEX CUSTOMER FUNCTION: Registers a newly stored customer with all search indexes
+// Must be called after every insertion into customerRecords.
+void indexCustomer(int slot) {
+    const Domain::Customer& c = customerRecords[slot];
+    customerSlotById[c.id] = slot;
+    customerNameTrie.insert(c.name, c.id, c.loyaltyPoints);
+    loyaltyLeaderboard.update(c.id, c.loyaltyPoints);
+    if (c.loyaltyPoints != 0 && loyaltyLedger.balance(c.id) != c.loyaltyPoints) {
+        loyaltyLedger.append(c.id, LoyaltyEventType::ADJUSTMENT, c.loyaltyPoints - loyaltyLedger.balance(c.id), 0, "Opening balance");
+    }
+    customerPhoneticKeys[slot].clear();
+    for (const string& token : tokenizeName(c.name)) {
+        customerNameFuzzy.addTerm(token, slot);
+        auto keys = Algorithms::doubleMetaphone(token);
+        for (const string& key : {keys.first, keys.second}) {
+            if (key.empty()) continue;
+            if (find(customerPhoneticKeys[slot].begin(), customerPhoneticKeys[slot].end(), key) != customerPhoneticKeys[slot].end()) continue;
+            customerPhoneticKeys[slot].push_back(key);
+            phoneticIndex[key].push_back(slot);
+        }
+    }
+    customerEmailFuzzy.addTerm(c.email, slot);
+}
+
+void indexMenuItem(int slot) {
+    const Domain::MenuItem& m = menuItems[slot];
+    menuSlotById[m.id] = slot;
+    menuNameTrie.insert(m.name, m.id, menuPopularity[m.name]);
+}
+
+void resetCustomerIndexes() {
+    customerDataEpoch++;
+    customerSlotById.clear();
+    customerNameTrie.clear();
+    customerNameFuzzy.clear();
+    customerEmailFuzzy.clear();
+    phoneticIndex.clear();
+    loyaltyLeaderboard.clear();
+    loyaltyLedger.clear(); // reloaded customers carry their balances as opening events
+}
+
+// RECORD DISH SALE FUNCTION: Bumps a dish's popularity and re-ranks it in the trie
+void recordDishSale(const string& dishName) {
+    int count = ++menuPopularity[dishName];
+    dishLeaderboard.update(dishName, count);
+    dishHeavyHitters.offer(dishName);
+    for (int i = 0; i < menuItemCount; i++) {
+        if (menuItems[i].name == dishName) {
+            menuNameTrie.updateScore(menuItems[i].id, count);
+        }
+    }
+}
+
+// AUTOCOMPLETE FUNCTIONS: Top-k name completions for the POS search box
+// ALGORITHM: Best-first search over compressed radix trie with a fixed node budget
+// TIME COMPLEXITY: O(|prefix| + budget log budget) regardless of customer count
+vector<Domain::Customer> autocompleteCustomers(const string& prefix, int k) {
+    vector<Domain::Customer> results;
+    for (const auto& hit : customerNameTrie.topK(prefix, k, AUTOCOMPLETE_NODE_BUDGET)) {
+        auto it = customerSlotById.find(hit.id);
+        if (it != customerSlotById.end()) results.push_back(customerRecords[it->second]);
+    }
+    return results;
+}
+
+vector<Domain::MenuItem> autocompleteMenuItems(const string& prefix, int k) {
+    vector<Domain::MenuItem> results;
+    for (const auto& hit : menuNameTrie.topK(prefix, k, AUTOCOMPLETE_NODE_BUDGET)) {
+        auto it = menuSlotById.find(hit.id);
+        if (it != menuSlotById.end()) results.push_back(menuItems[it->second]);
+    }
+    return results;
+}
+
+// FUZZY CUSTOMER SEARCH FUNCTION: Typo-tolerant lookup by name or email
+// HOW IT WORKS:
+// 1. Name queries are tokenized; every query token must fuzzy-match some
+//    token of the customer's name (e.g. "Jhon Smiht" -> "John Smith")
+// 2. Email queries match the whole address
+// 3. Results are ordered by total edit distance, closest first
+// ALGORITHM: SymSpell candidate generation + bit-parallel verification
+// TIME COMPLEXITY: O(tokens * (p^k + candidates)) - no full customer scan
+// USE CASE: Host mistypes a name at the POS
+vector<Domain::Customer> fuzzySearchCustomers(const string& query, const string& searchType, int maxDist = FUZZY_MAX_DISTANCE) {
+    unordered_map<int, pair<int, int>> hits; // slot -> (tokens matched, total distance)
+    vector<string> tokens = (searchType == "email") ? vector<string>{query} : tokenizeName(query);
+    FuzzyTermIndex& index = (searchType == "email") ? customerEmailFuzzy : customerNameFuzzy;
+    for (const string& token : tokens) {
+        unordered_map<int, int> best; // slot -> best distance for this token
+        for (const auto& m : index.search(token, maxDist)) {
+            auto it = best.find(m.slot);
+            if (it == best.end() || m.distance < it->second) best[m.slot] = m.distance;
+        }
+        for (const auto& b : best) {
+            hits[b.first].first++;
+            hits[b.first].second += b.second;
+        }
+    }
+    vector<pair<int, int>> ranked; // (distance, slot)
+    for (const auto& h : hits) {
+        if (h.second.first == static_cast<int>(tokens.size())) ranked.push_back({h.second.second, h.first});
+    }
+    sort(ranked.begin(), ranked.end());
+    vector<Domain::Customer> results;
+    for (const auto& r : ranked) results.push_back(customerRecords[r.second]);
+    return results;
+}
+
+// SOUNDS-LIKE SEARCH FUNCTION: Finds customers whose name is pronounced like the query
+// HOW IT WORKS:
+// 1. Encode each query token into primary/alternate Double Metaphone keys
+// 2. Look up both keys in the phonetic hash index (O(1) average per key)
+// 3. Keep customers matching every query token, ranked by how many
+//    tokens matched on the primary key
+// ALGORITHM: Double Metaphone + hash index with precomputed keys
+// TIME COMPLEXITY: O(tokens + matches) average
+// USE CASE: Reservations and waitlist names taken over the phone
+vector<int> findCustomerSlotsBySound(const string& name) {
+    vector<string> tokens = tokenizeName(name);
+    unordered_map<int, pair<int, int>> hits; // slot -> (tokens matched, primary matches)
+    for (const string& token : tokens) {
+        auto keys = Algorithms::doubleMetaphone(token);
+        unordered_map<int, int> tokenHits; // slot -> 2 if primary key hit, 1 if alternate only
+        for (int k = 0; k < 2; k++) {
+            const string& key = k == 0 ? keys.first : keys.second;
+            auto it = phoneticIndex.find(key);
+            if (key.empty() || it == phoneticIndex.end()) continue;
+            for (int slot : it->second) tokenHits[slot] = max(tokenHits[slot], 2 - k);
         }
+        for (const auto& h : tokenHits) {
+            hits[h.first].first++;
+            if (h.second == 2) hits[h.first].second++;
+        }
+    }
+    vector<pair<int, int>> ranked; // (-primary matches, slot)
+    for (const auto& h : hits) {
+        if (h.second.first == static_cast<int>(tokens.size())) ranked.push_back({-h.second.second, h.first});
+    }
+    sort(ranked.begin(), ranked.end());
+    vector<int> slots;
+    for (const auto& r : ranked) slots.push_back(r.second);
+    return slots;
+}
+
+vector<Domain::Customer> searchCustomersBySound(const string& name) {
+    vector<Domain::Customer> results;
+    for (int slot : findCustomerSlotsBySound(name)) results.push_back(customerRecords[slot]);
+    return results;
+}
+
+// MATCH RESERVATION FUNCTION: Links a phoned-in reservation to a customer record
+// Returns the matched customer ID (0 if no unambiguous phonetic match).
+int matchReservationToCustomer(TableReservation& reservation) {
+    vector<int> slots = findCustomerSlotsBySound(reservation.customerName);
+    if (slots.size() != 1) {
+        Core::Logger::log(Core::LogLevel::INFO, "Reservation " + to_string(reservation.reservationId) + ": " +
+                          to_string(slots.size()) + " phonetic candidates for " + reservation.customerName);
+        return 0;
     }
-    cout << "Total MST Cost: " << totalCost << "\n";
+    reservation.customerId = customerRecords[slots[0]].id;
+    return reservation.customerId;
 }
 
 // =============================================================
@@ -1594,10 +7697,14 @@ vector<Domain::Customer> searchCustomers(const string& keyword, const string& se
         if (searchType == "name" && customerRecords[i].name.find(keyword) != string::npos) match = true;
         else if (searchType == "phone" && customerRecords[i].phone.find(keyword) != string::npos) match = true;
         else if (searchType == "email" && customerRecords[i].email.find(keyword) != string::npos) match = true;
-        else if (searchType == "tier" && customerRecords[i].membershipTier.find(keyword) != string::npos) match = true;
+        else if (searchType == "tier" && Domain::tierToString(customerRecords[i].membershipTier).find(keyword) != string::npos) match = true;
         
         if (match) results.push_back(customerRecords[i]);
     }
+    if (results.empty() && (searchType == "name" || searchType == "email")) {
+        results = fuzzySearchCustomers(keyword, searchType);
+        Core::Logger::log(Core::LogLevel::INFO, "No exact match, fuzzy search returned " + to_string(results.size()) + " customers");
+    }
     Core::Logger::log(Core::LogLevel::INFO, "Searched customers with keyword: " + keyword);
     return results;
 }
@@ -1665,7 +7772,7 @@ void saveCustomersToFile(const string& filename) {
              << customerRecords[i].phone << ","
              << customerRecords[i].email << ","
              << customerRecords[i].loyaltyPoints << ","
-             << customerRecords[i].membershipTier << "\n";
+             << Domain::tierToString(customerRecords[i].membershipTier) << "\n";
     }
     file.close();
     Core::Logger::log(Core::LogLevel::INFO, "Customers saved to " + filename);
@@ -1694,6 +7801,7 @@ void loadCustomersFromFile(const string& filename) {
     string line;
     getline(file, line); // Skip header
     customerCount = 0;
+    resetCustomerIndexes();
     
     while (getline(file, line) && customerCount < MAX_CUSTOMERS) {
         stringstream ss(line);
@@ -1708,8 +7816,9 @@ void loadCustomersFromFile(const string& filename) {
         getline(ss, token, ','); loyaltyPoints = stoi(token);
         getline(ss, tier, ',');
         
-        customerRecords[customerCount] = {id, name, phone, email, loyaltyPoints, tier};
+        customerRecords[customerCount] = {id, name, phone, email, loyaltyPoints, Domain::tierFromString(tier)};
         customerBST = insertAVL(customerBST, id, name);
+        indexCustomer(customerCount);
         customerCount++;
     }
     file.close();
@@ -1872,22 +7981,71 @@ map<string, int> getCategoryPopularity() {
     return popularity;
 }
 
-double calculateCustomerLifetimeValue(int customerId) {
-    double totalSpent = 0;
-    for (int i = 0; i < orderHeapSize; i++) {
-        if (orderHeap[i].customerId == customerId) {
-            totalSpent += orderHeap[i].totalAmount;
-        }
+// =============================================================
+// PER-CUSTOMER ORDER AGGREGATES (maintained incrementally)
+// =============================================================
+
+struct CustomerAggregate {
+    int orderCount;
+    double totalSpent;
+    time_t firstOrderTime;
+    time_t lastOrderTime;
+};
+
+unordered_map<int, CustomerAggregate> customerAggregates;
+
+// AGGREGATE UPDATE FUNCTIONS: Keep per-customer totals in step with the order heap
+// HOW IT WORKS:
+// - Created: count +1, spend +amount, widen first/last order time
+// - Cancelled: count -1, spend -amount (cancelled orders no longer count)
+// - Modified: spend adjusted by (new total - old total)
+// NOTE: first/last order times are not narrowed on cancellation; they record
+// when the customer last placed an order, cancelled or not.
+// TIME COMPLEXITY: O(1) average per event
+void aggregateOrderCreated(int customerId, double amount, time_t orderTime) {
+    auto it = customerAggregates.find(customerId);
+    if (it == customerAggregates.end()) {
+        customerAggregates[customerId] = {1, amount, orderTime, orderTime};
+        spendLeaderboard.update(customerId, amount);
+        return;
     }
-    return totalSpent;
+    CustomerAggregate& a = it->second;
+    a.orderCount++;
+    a.totalSpent += amount;
+    a.firstOrderTime = min(a.firstOrderTime, orderTime);
+    a.lastOrderTime = max(a.lastOrderTime, orderTime);
+    spendLeaderboard.update(customerId, a.totalSpent);
+}
+
+void aggregateOrderCancelled(int customerId, double amount) {
+    auto it = customerAggregates.find(customerId);
+    if (it == customerAggregates.end()) return;
+    it->second.orderCount--;
+    it->second.totalSpent -= amount;
+    spendLeaderboard.update(customerId, it->second.totalSpent);
+}
+
+void aggregateOrderModified(int customerId, double oldAmount, double newAmount) {
+    auto it = customerAggregates.find(customerId);
+    if (it == customerAggregates.end()) return;
+    it->second.totalSpent += newAmount - oldAmount;
+    spendLeaderboard.update(customerId, it->second.totalSpent);
+}
+
+const CustomerAggregate* getCustomerAggregate(int customerId) {
+    auto it = customerAggregates.find(customerId);
+    return it == customerAggregates.end() ? nullptr : &it->second;
+}
+
+// TIME COMPLEXITY: O(1) - served from the maintained aggregate
+double calculateCustomerLifetimeValue(int customerId) {
+    const CustomerAggregate* a = getCustomerAggregate(customerId);
+    return a ? a->totalSpent : 0;
 }
 
 int getCustomerOrderCount(int customerId) {
-    int count = 0;
-    for (int i = 0; i < orderHeapSize; i++) {
-        if (orderHeap[i].customerId == customerId) count++;
-    }
-    return count;
+    const CustomerAggregate* a = getCustomerAggregate(customerId);
+    return a ? a->orderCount : 0;
 }
 
 // =============================================================
@@ -1922,6 +8080,26 @@ void recordTransaction(int orderId, const string& action, const string& details)
     Core::Logger::log(Core::LogLevel::INFO, "Transaction recorded: " + action);
 }
 
+// PLACE ORDER FUNCTION: Inserts an order into the priority heap and updates aggregates
+// HOW IT WORKS:
+// 1. Reject if the order heap is full
+// 2. Append to heap and sift up by priority
+// 3. Update customer aggregates and dish popularity
+// 4. Record a "Created" transaction for the audit trail
+// TIME COMPLEXITY: O(log n) heap insertion + O(items) bookkeeping
+bool placeOrder(const Domain::Order& order) {
+    if (orderHeapSize >= MAX_ORDERS) {
+        Core::Logger::log(Core::LogLevel::WARNING, "Order heap full");
+        return false;
+    }
+    orderHeap[orderHeapSize++] = order;
+    orderHeapifyUp(orderHeapSize - 1);
+    aggregateOrderCreated(order.customerId, order.totalAmount, order.orderTime);
+    for (int j = 0; j < order.itemCount; j++) recordDishSale(order.items[j]);
+    recordTransaction(order.orderId, "Created", "Order total $" + to_string(order.totalAmount));
+    return true;
+}
+
 // MODIFY ORDER FUNCTION: Updates items and amount for CREATED orders only
 // HOW IT WORKS:
 // 1. Find order by orderId in the heap
@@ -1947,6 +8125,7 @@ bool modifyOrder(int orderId, const vector<string>& newItems, double newTotal) {
             for (int j = 0; j < (int)newItems.size(); j++) {
                 orderHeap[i].items[j] = newItems[j];
             }
+            aggregateOrderModified(orderHeap[i].customerId, orderHeap[i].totalAmount, newTotal);
             orderHeap[i].totalAmount = newTotal;
             recordTransaction(orderId, "Modified", "Order items and amount updated");
             return true;
@@ -1976,7 +8155,12 @@ bool cancelOrder(int orderId, double& refundAmount) {
                 Core::Logger::log(Core::LogLevel::WARNING, "Cannot cancel completed order");
                 return false;
             }
+            if (orderHeap[i].status == Domain::OrderState::CANCELLED) {
+                Core::Logger::log(Core::LogLevel::WARNING, "Order already cancelled");
+                return false;
+            }
             refundAmount = orderHeap[i].totalAmount;
+            aggregateOrderCancelled(orderHeap[i].customerId, refundAmount);
             // Update status to CANCELLED
             orderHeap[i].status = Domain::OrderState::CANCELLED;
             recordTransaction(orderId, "Cancelled", "Full refund of $" + to_string(refundAmount));
@@ -2167,96 +8351,197 @@ vector<Domain::MenuItem> sortMenuByPrice(bool ascending = true) {
     return items;
 }
 
+// TIME COMPLEXITY: O(K log K) from the streaming spend leaderboard
 pair<int, double> getTopCustomer() {
-    int topCustomerId = -1;
-    double maxSpent = 0;
-    for (int i = 0; i < customerCount; i++) {
-        double spent = calculateCustomerLifetimeValue(customerRecords[i].id);
-        if (spent > maxSpent) {
-            maxSpent = spent;
-            topCustomerId = customerRecords[i].id;
-        }
+    auto best = spendLeaderboard.top(1);
+    if (best.empty() || best[0].second <= 0) return {-1, 0};
+    return best[0];
+}
+
+// LEADERBOARD QUERIES: Top-k customers/dishes without sorting every record
+// TIME COMPLEXITY: O(K log K) per query; maintained in O(log K) per event
+vector<pair<int, double>> getTopCustomersBySpend(int k) {
+    return spendLeaderboard.top(k);
+}
+
+vector<pair<int, int>> getTopCustomersByLoyalty(int k) {
+    return loyaltyLeaderboard.top(k);
+}
+
+vector<pair<string, int>> getTopDishes(int k) {
+    return dishLeaderboard.top(k);
+}
+
+void displayLeaderboards(int k = 5) {
+    cout << "\n=== LEADERBOARDS (Top " << k << ") ===\n";
+    cout << "By lifetime spend:\n";
+    for (const auto& e : getTopCustomersBySpend(k)) {
+        cout << "  Customer " << e.first << " - $" << fixed << setprecision(2) << e.second << "\n";
+    }
+    cout << "By loyalty points:\n";
+    for (const auto& e : getTopCustomersByLoyalty(k)) {
+        cout << "  Customer " << e.first << " - " << e.second << " pts\n";
+    }
+    cout << "Most ordered dishes:\n";
+    for (const auto& e : getTopDishes(k)) {
+        cout << "  " << e.first << " - " << e.second << " orders\n";
+    }
+    cout << "Heavy hitters (Space-Saving estimate):\n";
+    for (const auto& e : dishHeavyHitters.top(k)) {
+        cout << "  " << e.key << " - ~" << e.count << " (+/- " << e.error << ")\n";
     }
-    return {topCustomerId, maxSpent};
 }
 
 // =============================================================
 // CUSTOMER LOYALTY PROGRAM
 // =============================================================
 
-enum class MembershipTierLevel { BRONZE, SILVER, GOLD, PLATINUM };
-
 struct LoyaltyProgram {
     int customerId;
     int totalPoints;
     int pointsRedeemed;
-    MembershipTierLevel tier;
+    Domain::MembershipTierLevel tier;
     string tierStartDate;
     vector<string> rewards;
 };
 
 // UPGRADE MEMBERSHIP TIER FUNCTION: Promotes customer based on loyalty points
 // HOW IT WORKS:
-// 1. Find customer by ID
-// 2. Check current points and tier level:
-//    a. 5000+ points → Platinum tier (highest)
-//    b. 3000+ points + Silver tier → Gold tier
-//    c. 1000+ points + Bronze tier → Silver tier
-// 3. Update membership tier if points threshold met
-// 4. Log promotion action
-// ALGORITHM: Conditional tier assignment based on point brackets
-// TIME COMPLEXITY: O(n) where n is number of customers
+// 1. Find customer slot by ID
+// 2. Look up the highest tier whose TIER_TABLE threshold is met, so a
+//    Bronze member with 3000+ points moves straight to Gold
+// 3. Tiers never downgrade here; only promotions are applied and logged
+// ALGORITHM: Table-driven threshold count
+// TIME COMPLEXITY: O(1)
 // USE CASE: Automatic tier advancement as customers accumulate loyalty points
 void upgradeMembershipTier(int customerId) {
-    for (int i = 0; i < customerCount; i++) {
-        if (customerRecords[i].id == customerId) {
-            int points = customerRecords[i].loyaltyPoints;
-            if (points >= 5000 && customerRecords[i].membershipTier != "Platinum") {
-                customerRecords[i].membershipTier = "Platinum";
-            } else if (points >= 3000 && customerRecords[i].membershipTier == "Silver") {
-                customerRecords[i].membershipTier = "Gold";
-            } else if (points >= 1000 && customerRecords[i].membershipTier == "Bronze") {
-                customerRecords[i].membershipTier = "Silver";
-            }
-            Core::Logger::log(Core::LogLevel::INFO, "Customer " + to_string(customerId) + " upgraded to " + customerRecords[i].membershipTier);
-            return;
-        }
+    auto it = customerSlotById.find(customerId);
+    if (it == customerSlotById.end()) return;
+    Domain::Customer& c = customerRecords[it->second];
+    auto earned = static_cast<Domain::MembershipTierLevel>(Domain::tierIndexForPoints(c.loyaltyPoints));
+    if (earned > c.membershipTier) {
+        c.membershipTier = earned;
+        Core::Logger::log(Core::LogLevel::INFO, "Customer " + to_string(customerId) + " upgraded to " + Domain::tierToString(earned));
     }
 }
 
+// Copies the ledger balance onto the customer record and its rankings
+void syncLoyaltyBalance(Domain::Customer& c) {
+    c.loyaltyPoints = loyaltyLedger.balance(c.id);
+    customerNameTrie.updateScore(c.id, c.loyaltyPoints);
+    loyaltyLeaderboard.update(c.id, c.loyaltyPoints);
+}
+
 void addLoyaltyPoints(int customerId, int points) {
+    auto it = customerSlotById.find(customerId);
+    if (it == customerSlotById.end()) return;
+    loyaltyLedger.append(customerId, points >= 0 ? LoyaltyEventType::ACCRUAL : LoyaltyEventType::ADJUSTMENT, points);
+    syncLoyaltyBalance(customerRecords[it->second]);
+    upgradeMembershipTier(customerId);
+    Core::Logger::log(Core::LogLevel::INFO, "Added " + to_string(points) + " points to customer " + to_string(customerId));
+}
+
+// REDEEM LOYALTY POINTS FUNCTION: Spends points if the balance covers them
+// Redemptions and expiries lower the balance but never the earned tier.
+bool redeemLoyaltyPoints(int customerId, int points, const string& note = "") {
+    auto it = customerSlotById.find(customerId);
+    if (it == customerSlotById.end() || points <= 0) return false;
+    if (loyaltyLedger.balance(customerId) < points) {
+        Core::Logger::log(Core::LogLevel::WARNING, "Redemption of " + to_string(points) + " points refused for customer " + to_string(customerId));
+        return false;
+    }
+    loyaltyLedger.append(customerId, LoyaltyEventType::REDEMPTION, -points, 0, note);
+    syncLoyaltyBalance(customerRecords[it->second]);
+    Core::Logger::log(Core::LogLevel::INFO, "Customer " + to_string(customerId) + " redeemed " + to_string(points) + " points");
+    return true;
+}
+
+// EXPIRE LOYALTY POINTS FUNCTION: Removes up to `points`, never below zero
+int expireLoyaltyPoints(int customerId, int points) {
+    auto it = customerSlotById.find(customerId);
+    if (it == customerSlotById.end()) return 0;
+    int expired = min(points, loyaltyLedger.balance(customerId));
+    if (expired <= 0) return 0;
+    loyaltyLedger.append(customerId, LoyaltyEventType::EXPIRY, -expired, 0, "Points expired");
+    syncLoyaltyBalance(customerRecords[it->second]);
+    return expired;
+}
+
+static const int LOYALTY_EXPIRY_DAYS = 365;
+
+// EXPIRE OLD LOYALTY POINTS FUNCTION: Expires points left unspent for a year
+// HOW IT WORKS:
+// 1. The cutoff is LOYALTY_EXPIRY_DAYS before `now`
+// 2. Per customer, the ledger reports the points earned by the cutoff that
+//    later redemptions and expiries have not used up (oldest spent first)
+// 3. Those points get an EXPIRY event; a second run finds nothing new
+// TIME COMPLEXITY: O(C log E + E) for C customers and E ledger events
+// USE CASE: End-of-shift settlement (settlePendingBills)
+int expireOldLoyaltyPoints(time_t now) {
+    time_t cutoff = now - static_cast<time_t>(LOYALTY_EXPIRY_DAYS) * 24 * 3600;
+    int total = 0;
     for (int i = 0; i < customerCount; i++) {
-        if (customerRecords[i].id == customerId) {
-            customerRecords[i].loyaltyPoints += points;
-            upgradeMembershipTier(customerId);
-            Core::Logger::log(Core::LogLevel::INFO, "Added " + to_string(points) + " points to customer " + to_string(customerId));
-            return;
-        }
+        int id = customerRecords[i].id;
+        total += expireLoyaltyPoints(id, loyaltyLedger.unspentBefore(id, cutoff));
+    }
+    if (total > 0) Core::Logger::log(Core::LogLevel::INFO, "Expired " + to_string(total) + " loyalty points older than " + to_string(LOYALTY_EXPIRY_DAYS) + " days");
+    return total;
+}
+
+void displayLoyaltyStatement(int customerId) {
+    auto events = loyaltyLedger.history(customerId);
+    cout << "\n=== LOYALTY STATEMENT: Customer " << customerId << " ===\n";
+    if (events.empty()) {
+        cout << "No loyalty activity.\n";
+        return;
+    }
+    int running = 0;
+    for (const LoyaltyEvent& e : events) {
+        running += e.delta;
+        char when[20];
+        strftime(when, sizeof(when), "%Y-%m-%d %H:%M", localtime(&e.timestamp));
+        cout << "#" << e.sequence << " " << when << " " << setw(10) << left << loyaltyEventToString(e.type) << right
+             << setw(7) << e.delta << "  balance " << running;
+        if (e.billId) cout << "  (bill " << e.billId << ")";
+        if (!e.note.empty()) cout << "  " << e.note;
+        cout << "\n";
+    }
+    time_t monthAgo = time(nullptr) - 30 * 24 * 3600;
+    cout << "Balance 30 days ago: " << loyaltyLedger.balanceAt(customerId, monthAgo) << "\n";
+    cout << "Current balance: " << loyaltyLedger.balance(customerId) << "\n";
+}
+
+// BATCH TIER RECOMPUTE: Applies point deltas and re-evaluates tiers for n customers
+// HOW IT WORKS:
+// 1. points[i] += deltas[i]
+// 2. earned tier = number of thresholds met (sum of comparisons)
+// 3. tiers[i] = max(tiers[i], earned) so promotions stick
+// ALGORITHM: Straight-line loop over contiguous arrays with no branches or
+//            lookups, which the compiler can auto-vectorize
+// TIME COMPLEXITY: O(n)
+// USE CASE: End-of-day or campaign point grants for many customers at once
+void recomputeTiersBatch(int* points, const int* deltas, uint8_t* tiers, int n) {
+    for (int i = 0; i < n; i++) {
+        int p = points[i] + deltas[i];
+        points[i] = p;
+        uint8_t earned = Domain::tierIndexForPoints(p);
+        tiers[i] = tiers[i] > earned ? tiers[i] : earned;
     }
 }
 
 // CALCULATE DISCOUNT FUNCTION: Returns discount percentage based on membership tier
 // HOW IT WORKS:
-// 1. Find customer by ID
-// 2. Return discount based on tier:
-//    a. Platinum → 20% discount
-//    b. Gold → 15% discount
-//    c. Silver → 10% discount
-//    d. Bronze → 5% discount
+// 1. Find customer slot by ID
+// 2. Read the discount for the customer's tier from TIER_TABLE
+//    (Bronze 5%, Silver 10%, Gold 15%, Platinum 20%)
 // 3. Return 0 if customer not found
-// ALGORITHM: Tier-based discount lookup
-// TIME COMPLEXITY: O(n) where n is number of customers
+// ALGORITHM: Tier-indexed table lookup
+// TIME COMPLEXITY: O(1)
 // USE CASE: Apply automatic discounts at checkout based on loyalty status
 double calculateDiscount(int customerId) {
-    for (int i = 0; i < customerCount; i++) {
-        if (customerRecords[i].id == customerId) {
-            if (customerRecords[i].membershipTier == "Platinum") return 0.20; // 20% discount
-            if (customerRecords[i].membershipTier == "Gold") return 0.15;     // 15% discount
-            if (customerRecords[i].membershipTier == "Silver") return 0.10;   // 10% discount
-            return 0.05; // 5% for Bronze
-        }
-    }
-    return 0;
+    auto it = customerSlotById.find(customerId);
+    if (it == customerSlotById.end()) return 0;
+    return Domain::TIER_TABLE[static_cast<int>(customerRecords[it->second].membershipTier)].discount;
 }
 
 // =============================================================
@@ -2478,14 +8763,101 @@ void batchUpdateInventory(const vector<pair<string, int>>& updates) {
     cout << "Updated " << successCount << " inventory items\n";
 }
 
+// APPLY LOYALTY DELTAS: Gathers the affected customers into contiguous
+// point/delta/tier arrays, runs recomputeTiersBatch once, then scatters the
+// results back. Repeated ids in one batch are merged before the pass.
+// Callers append the matching ledger events first. Returns customers updated.
+int applyLoyaltyDeltas(const vector<pair<int, int>>& updates) {
+    unordered_map<int, int> laneBySlot;
+    vector<int> slots, points, deltas;
+    vector<uint8_t> tiers;
+    for (const auto& update : updates) {
+        auto it = customerSlotById.find(update.first);
+        if (it == customerSlotById.end()) continue;
+        auto lane = laneBySlot.find(it->second);
+        if (lane != laneBySlot.end()) {
+            deltas[lane->second] += update.second;
+            continue;
+        }
+        const Domain::Customer& c = customerRecords[it->second];
+        laneBySlot[it->second] = static_cast<int>(slots.size());
+        slots.push_back(it->second);
+        points.push_back(c.loyaltyPoints);
+        deltas.push_back(update.second);
+        tiers.push_back(static_cast<uint8_t>(c.membershipTier));
+    }
+
+    int n = static_cast<int>(slots.size());
+    recomputeTiersBatch(points.data(), deltas.data(), tiers.data(), n);
+
+    int upgrades = 0;
+    for (int i = 0; i < n; i++) {
+        Domain::Customer& c = customerRecords[slots[i]];
+        auto tier = static_cast<Domain::MembershipTierLevel>(tiers[i]);
+        if (tier != c.membershipTier) upgrades++;
+        c.membershipTier = tier;
+        syncLoyaltyBalance(c);
+    }
+    if (upgrades > 0) {
+        Core::Logger::log(Core::LogLevel::INFO, "Batch loyalty points: " + to_string(upgrades) + " tier upgrades");
+    }
+    return n;
+}
+
 void batchAddLoyaltyPoints(const vector<pair<int, int>>& updates) {
-    int successCount = 0;
     for (const auto& update : updates) {
-        addLoyaltyPoints(update.first, update.second);
-        successCount++;
+        if (customerSlotById.count(update.first)) {
+            loyaltyLedger.append(update.first, LoyaltyEventType::ACCRUAL, update.second, 0, "Batch grant");
+        }
+    }
+    int successCount = applyLoyaltyDeltas(updates);
+    Core::Logger::log(Core::LogLevel::INFO, "Batch loyalty points: " + to_string(successCount) + " customers updated");
+    cout << "Updated loyalty points for " << successCount << " customers\n";
+}
+
+static const int LOYALTY_SPEND_PER_POINT = 10; // 1 point per 10 spent
+
+PaymentMethod paymentMethodFromString(const string& method) {
+    if (method == "Credit Card") return PaymentMethod::CREDIT_CARD;
+    if (method == "Debit Card") return PaymentMethod::DEBIT_CARD;
+    if (method == "Wallet") return PaymentMethod::WALLET;
+    if (method == "Cheque") return PaymentMethod::CHEQUE;
+    return PaymentMethod::CASH;
+}
+
+// SETTLE PENDING BILLS FUNCTION: Drains the bill queue and accrues loyalty in one batch
+// HOW IT WORKS:
+// 1. Dequeue each pending bill and run it through processPayment
+// 2. For every approved bill append an ACCRUAL event (tagged with the bill id)
+//    to the loyalty ledger and collect (customer, points)
+// 3. Apply all collected accruals with a single applyLoyaltyDeltas pass, so
+//    customers with several bills are touched once
+// 4. Bills whose payment failed go back on the queue
+// 5. Points left unspent for LOYALTY_EXPIRY_DAYS expire (expireOldLoyaltyPoints)
+// TIME COMPLEXITY: O(B) for B pending bills, plus the expiry sweep
+// USE CASE: End-of-shift settlement
+int settlePendingBills() {
+    vector<pair<int, int>> accruals;
+    vector<Bill> failed;
+    int settled = 0;
+    while (!billIsEmpty()) {
+        Bill b = dequeueBill();
+        if (!processPayment(b.billId, b.finalAmount, paymentMethodFromString(b.paymentMethod))) {
+            failed.push_back(b);
+            continue;
+        }
+        settled++;
+        int points = static_cast<int>(b.finalAmount) / LOYALTY_SPEND_PER_POINT;
+        if (points > 0 && customerSlotById.count(b.customerId)) {
+            loyaltyLedger.append(b.customerId, LoyaltyEventType::ACCRUAL, points, b.billId, "Bill settled");
+            accruals.push_back({b.customerId, points});
+        }
     }
-    Core::Logger::log(Core::LogLevel::INFO, "Batch loyalty points: " + to_string(successCount) + " customers updated");
-    cout << "Updated loyalty points for " << successCount << " customers\n";
+    for (const Bill& b : failed) enqueueBill(b);
+    int customers = applyLoyaltyDeltas(accruals);
+    expireOldLoyaltyPoints(time(nullptr));
+    Core::Logger::log(Core::LogLevel::INFO, "Settled " + to_string(settled) + " bills; loyalty accrued for " + to_string(customers) + " customers");
+    return settled;
 }
 
 // =============================================================
@@ -2547,6 +8919,7 @@ struct WaitlistEntry {
     int partySize;
     string requestTime;
     string status;
+    string customerName; // as given by phone; empty for walk-ins
 };
 
 static const int MAX_WAITLIST = 100;
@@ -2577,7 +8950,8 @@ bool addToWaitlist(int customerId, int partySize) {
         customerId,
         partySize,
         Core::DateTimeUtil::getCurrentTime(),
-        "Waiting"
+        "Waiting",
+        ""
     };
     waitlistCount++;
     Core::Logger::log(Core::LogLevel::INFO, "Customer " + to_string(customerId) + " added to waitlist");
@@ -2585,6 +8959,41 @@ bool addToWaitlist(int customerId, int partySize) {
     return true;
 }
 
+// ADD TO WAITLIST BY NAME FUNCTION: Phone-in waitlist entry resolved by sound
+// HOW IT WORKS:
+// 1. Look up the spoken name in the phonetic index
+// 2. Use the best-ranked customer if any (0 = unknown caller)
+// 3. Add to waitlist, keeping the name as heard for the host stand
+// TIME COMPLEXITY: O(1) average lookup + O(1) insertion
+bool addToWaitlistByName(const string& callerName, int partySize) {
+    vector<int> slots = findCustomerSlotsBySound(callerName);
+    int customerId = slots.empty() ? 0 : customerRecords[slots[0]].id;
+    if (!addToWaitlist(customerId, partySize)) return false;
+    waitlist[waitlistCount - 1].customerName = callerName;
+    return true;
+}
+
+// BOOK PHONE RESERVATION FUNCTION: Records a phoned-in table reservation
+// HOW IT WORKS:
+// 1. Store the reservation with the caller's name as heard
+// 2. Link it to a customer record by sound (matchReservationToCustomer);
+//    unknown or ambiguous names stay at customer 0 for the host to confirm
+// TIME COMPLEXITY: O(1) average phonetic lookup per name token
+// Returns the reservation ID, or 0 if the reservation book is full
+int bookPhoneReservation(const string& callerName, int tableNumber, int guestCount, const string& date, const string& time) {
+    if (reservationCount >= MAX_RESERVATIONS) {
+        Core::Logger::log(Core::LogLevel::WARNING, "Reservation book full");
+        return 0;
+    }
+    TableReservation& reservation = reservations[reservationCount];
+    reservation = {reservationCount + 1, tableNumber, 0, callerName, date, time, guestCount, "Booked"};
+    reservationCount++;
+    matchReservationToCustomer(reservation);
+    Core::Logger::log(Core::LogLevel::INFO, "Reservation " + to_string(reservation.reservationId) + " booked for " + callerName +
+                      " (customer " + to_string(reservation.customerId) + ")");
+    return reservation.reservationId;
+}
+
 // FIND AVAILABLE TABLE FUNCTION: Searches for unoccupied table fitting party size
 // HOW IT WORKS:
 // 1. Iterate through all tables (MAX_TABLES)
@@ -2602,84 +9011,1566 @@ int findAvailableTable(int partySize) {
             return i;
         }
     }
-    return -1;
-}
+    return -1;
+}
+
+bool assignTableFromWaitlist() {
+    if (waitlistCount == 0) return false;
+    
+    WaitlistEntry entry = waitlist[0];
+    int tableNum = findAvailableTable(entry.partySize);
+    
+    if (tableNum != -1) {
+        tableOccupied[tableNum] = true;
+        entry.status = "Seated";
+        for (int i = 0; i < waitlistCount - 1; i++) {
+            waitlist[i] = waitlist[i + 1];
+        }
+        waitlistCount--;
+        Core::Logger::log(Core::LogLevel::INFO, "Customer from waitlist seated at table " + to_string(tableNum));
+        cout << "Customer seated at table " << tableNum << "\n";
+        return true;
+    }
+    return false;
+}
+
+// =============================================================
+// ADVANCED DELIVERY ROUTE OPTIMIZATION (TSP Approximation)
+// =============================================================
+
+static const int TOUR_NEIGHBOURS = 8;            // candidate list size per stop
+static const double TOUR_IMPROVE_BUDGET_MS = 250; // local search time cap per route
+
+// NEAREST NEIGHBOR TOUR: Greedy closed tour over the first n locations
+// HOW IT WORKS:
+// 1. Start at given location
+// 2. From current location, move to the nearest unvisited location
+// 3. Stop when all reachable locations are visited (unreachable ones are
+//    left out and reported)
+// TIME COMPLEXITY: O(n²)
+// Returns the visiting order without the closing return to start
+vector<int> nearestNeighbourTour(const DataStructures::DistanceMatrix& dist, int start, int n) {
+    vector<int> tour;
+    if (start < 0 || start >= n) return tour;
+    vector<bool> visited(n, false);
+    int current = start;
+    tour.push_back(current);
+    visited[current] = true;
+    for (int i = 1; i < n; i++) {
+        int nearest = -1;
+        int minDist = GRAPH_INF;
+        for (int j = 0; j < n; j++) {
+            if (!visited[j] && dist.get(current, j) < minDist) {
+                minDist = dist.get(current, j);
+                nearest = j;
+            }
+        }
+        if (nearest == -1) {
+            Core::Logger::log(Core::LogLevel::WARNING, to_string(n - i) + " locations unreachable from the tour");
+            break;
+        }
+        tour.push_back(nearest);
+        visited[nearest] = true;
+        current = nearest;
+    }
+    return tour;
+}
+
+// TOUR IMPROVER: 2-opt + Or-opt local search on a closed tour
+// HOW IT WORKS:
+// 1. The tour is an array plus a position index, so succ/pred of any stop
+//    are O(1) lookups
+// 2. Each stop keeps its TOUR_NEIGHBOURS nearest stops; moves are only
+//    tried towards those, and a scan stops once the new edge alone is
+//    longer than what the move could save (gain criterion)
+// 3. Don't-look bits: a queue holds stops worth examining; a stop whose
+//    scan finds nothing drops out until a move touches one of its edges
+// 4. 2-opt: drop edges (a,succ a) and (c,succ c), add (a,c) and
+//    (succ a,succ c) by reversing the stretch between them (the shorter
+//    side of the cycle); likewise on the predecessor side
+// 5. Or-opt: cut a run of 1-3 stops starting or ending at a and reinsert it,
+//    either way round, next to a neighbour c; done with two or three
+//    reversals over the shorter side
+// 6. Every applied move shortens the tour, so stopping at the time budget
+//    returns the best tour found so far
+// ALGORITHM: Neighbour-list local search (Bentley's 2-opt with don't-look bits)
+// TIME COMPLEXITY: O(n K log K) setup; each pass O(n K) evaluations, a
+//                  move costs O(length reversed) <= O(n/2)
+// USE CASE: Tightening nearest-neighbour delivery tours (typically 20-25%
+//           above optimal) to within a few percent
+class TourImprover {
+public:
+    struct Stats {
+        long long initialLength = 0;
+        long long finalLength = 0;
+        int twoOptMoves = 0;
+        int orOptMoves = 0;
+        bool outOfTime = false;
+    };
+
+private:
+    const DataStructures::DistanceMatrix& dist;
+    vector<int> tour;             // slot -> stop
+    vector<int> slotOf;           // stop -> slot
+    vector<vector<int>> nearest;  // stop -> nearest stops, closest first
+    vector<char> queued;
+    deque<int> active;
+    int n = 0;
+
+    long long d(int a, int b) const { return dist.get(a, b); }
+    int next(int slot) const { return slot + 1 == n ? 0 : slot + 1; }
+    int prev(int slot) const { return slot == 0 ? n - 1 : slot - 1; }
+    int succ(int stop) const { return tour[next(slotOf[stop])]; }
+    int pred(int stop) const { return tour[prev(slotOf[stop])]; }
+    int span(int from, int to) const { return (to - from + n) % n + 1; } // slots from..to inclusive
+
+    void wake(int stop) {
+        if (!queued[stop]) {
+            queued[stop] = 1;
+            active.push_back(stop);
+        }
+    }
+
+    // Reverses tour slots from..to (inclusive, wrapping)
+    void reverseSlots(int from, int to) {
+        for (int len = span(from, to); len > 1; len -= 2) {
+            swap(tour[from], tour[to]);
+            slotOf[tour[from]] = from;
+            slotOf[tour[to]] = to;
+            from = next(from);
+            to = prev(to);
+        }
+    }
+
+    // Replaces (a,b) and (c,e), where b = succ(a) and e = succ(c), with (a,c) and (b,e)
+    void applyTwoOpt(int a, int c) {
+        int from = next(slotOf[a]), to = slotOf[c];
+        if (2 * span(from, to) > n) reverseSlots(next(to), prev(from)); // mirror image, fewer swaps
+        else reverseSlots(from, to);
+    }
+
+    bool tryTwoOpt(int a) {
+        for (int side = 0; side < 2; side++) {
+            int b = side == 0 ? succ(a) : pred(a);
+            long long removed = d(a, b);
+            for (int c : nearest[a]) {
+                long long added = d(a, c);
+                if (added >= removed) break;
+                int e = side == 0 ? succ(c) : pred(c);
+                if (c == b || e == a) continue;
+                long long delta = added + d(b, e) - removed - d(c, e);
+                if (delta >= 0) continue;
+                if (side == 0) applyTwoOpt(a, c);
+                else applyTwoOpt(e, b); // mirror: (e,c) and (b,a) seen from the predecessor side
+                wake(a); wake(b); wake(c); wake(e);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Moves the run in slots lo..hi so it sits between x and y = succ(x);
+    // flipped puts x next to the run's last stop, otherwise next to its first
+    void applyOrOpt(int lo, int hi, int x, bool flipped) {
+        int runLength = span(lo, hi);
+        int xs = slotOf[x], ys = next(xs);
+        if (span(lo, xs) <= span(ys, hi)) {
+            // [run, q..x] -> [q..x, run reversed]
+            reverseSlots(lo, xs);
+            int gap = span(lo, xs) - runLength;
+            int runStart = (lo + gap) % n;
+            if (gap > 0) reverseSlots(lo, prev(runStart));
+            if (!flipped) reverseSlots(runStart, xs);
+        } else {
+            // [y..p, run] -> [run reversed, y..p]
+            reverseSlots(ys, hi);
+            int runEnd = (ys + runLength - 1) % n;
+            if (runEnd != hi) reverseSlots(next(runEnd), hi);
+            if (!flipped) reverseSlots(ys, runEnd);
+        }
+    }
+
+    bool tryOrOpt(int a) {
+        for (int runLength = 1; runLength <= 3 && runLength + 2 < n; runLength++) {
+            for (int anchor = 0; anchor < 2; anchor++) {
+                // anchor 0: a is the run's first stop, 1: its last
+                int lo = anchor == 0 ? slotOf[a] : (slotOf[a] - runLength + 1 + n) % n;
+                int hi = (lo + runLength - 1) % n;
+                int first = tour[lo], last = tour[hi];
+                int p = tour[prev(lo)], q = tour[next(hi)];
+                long long saved = d(p, first) + d(last, q) - d(p, q);
+                if (saved <= 0) continue;
+                for (int c : nearest[a]) {
+                    long long toC = d(a, c);
+                    if (toC >= saved) break;
+                    if (span(lo, slotOf[c]) <= runLength) continue; // c inside the run
+                    for (int edge = 0; edge < 2; edge++) {
+                        int x = edge == 0 ? c : pred(c);
+                        int y = edge == 0 ? succ(c) : c;
+                        if (span(lo, slotOf[x]) <= runLength || span(lo, slotOf[y]) <= runLength) continue;
+                        if (x == p && y == q) continue;
+                        long long keep = d(x, first) + d(last, y);
+                        long long flip = d(x, last) + d(first, y);
+                        bool flipped = flip < keep;
+                        long long delta = min(keep, flip) - d(x, y) - saved;
+                        if (delta >= 0) continue;
+                        applyOrOpt(lo, hi, x, flipped);
+                        wake(p); wake(q); wake(first); wake(last); wake(x); wake(y);
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    long long tourLength() const {
+        long long total = 0;
+        for (int i = 0; i < n; i++) total += d(tour[i], tour[next(i)]);
+        return total;
+    }
+
+public:
+    explicit TourImprover(const DataStructures::DistanceMatrix& distances) : dist(distances) {}
+
+    // Improves `route` (visiting order, no repeated start) in place within
+    // budgetMs and keeps route[0] first. Distances must be symmetric.
+    Stats improve(vector<int>& route, double budgetMs) {
+        Stats stats;
+        n = static_cast<int>(route.size());
+        tour = route;
+        stats.initialLength = stats.finalLength = n > 1 ? tourLength() : 0;
+        if (n < 5) return stats;
+
+        auto started = chrono::steady_clock::now();
+        int maxStop = *max_element(route.begin(), route.end()) + 1;
+        slotOf.assign(maxStop, -1);
+        nearest.assign(maxStop, {});
+        queued.assign(maxStop, 0);
+        active.clear();
+        for (int i = 0; i < n; i++) slotOf[tour[i]] = i;
+        // k nearest per stop: one row scan keeping a small sorted list
+        int k = min(TOUR_NEIGHBOURS, n - 1);
+        vector<pair<int, int>> best;
+        for (int a : route) {
+            best.clear();
+            for (int b : route) {
+                if (b == a) continue;
+                int dab = dist.get(a, b);
+                if (static_cast<int>(best.size()) == k && dab >= best.back().first) continue;
+                if (static_cast<int>(best.size()) == k) best.pop_back();
+                best.insert(upper_bound(best.begin(), best.end(), make_pair(dab, b)), {dab, b});
+            }
+            for (const auto& entry : best) {
+                // Moves reverse stretches of the tour, which is only free when
+                // d(a,b) == d(b,a); road networks here are two-way, check the
+                // pairs the search actually uses
+                if (dist.get(entry.second, a) != entry.first) {
+                    Core::Logger::log(Core::LogLevel::WARNING, "Tour improvement skipped: distances are not symmetric");
+                    return stats;
+                }
+                nearest[a].push_back(entry.second);
+            }
+        }
+        for (int a : route) wake(a);
+
+        int checks = 0;
+        while (!active.empty()) {
+            if (++checks % 256 == 0 &&
+                chrono::duration<double, milli>(chrono::steady_clock::now() - started).count() > budgetMs) {
+                stats.outOfTime = true;
+                break;
+            }
+            int a = active.front();
+            active.pop_front();
+            queued[a] = 0;
+            if (tryTwoOpt(a)) stats.twoOptMoves++;
+            else if (tryOrOpt(a)) stats.orOptMoves++;
+        }
+
+        stats.finalLength = tourLength();
+        rotate(tour.begin(), tour.begin() + slotOf[route[0]], tour.end());
+        route = tour;
+        return stats;
+    }
+};
+
+static const int HELD_KARP_MAX_STOPS = 20;      // 2^19 subsets x 20 lanes x 4 bytes = 40 MB
+static const int HELD_KARP_DISPATCH_LIMIT = 16; // tspApproximation solves exactly up to here
+static const int HELD_KARP_LANES = 20;          // fixed row width (>= max stops - 1) so the min loop vectorises
+
+// HELD-KARP EXACT TSP: Optimal tour over a small set of stops
+// HOW IT WORKS:
+// 1. Fix stops[0] as the start; the other m = n-1 stops are bits of a mask
+// 2. dp[mask][j] = shortest path that leaves the start, visits exactly the
+//    stops in mask and ends at j (j in mask)
+// 3. dp[mask][j] = min over k of dp[mask without j][k] + d(k, j). Rows are
+//    padded to HELD_KARP_LANES with "infinite" entries for stops outside the
+//    mask, so the min runs branch-free over a fixed width against a
+//    transposed distance row and compiles to SIMD
+// 4. All masks of one size depend only on the previous size, so each layer
+//    is split across worker threads
+// 5. Close the tour back to the start, then walk the table backwards to
+//    recover the order (no parent table, halving memory)
+// ALGORITHM: Bitmask dynamic programming (Held-Karp)
+// TIME COMPLEXITY: O(2^n * n^2 / threads); SPACE: O(2^n * n), capped by
+//                  HELD_KARP_MAX_STOPS
+// USE CASE: Exact routes for small delivery batches (8-20 stops)
+// Returns the visiting order starting at stops[0] (no closing return), or
+// an empty vector if there are too many stops
+vector<int> heldKarpTour(const DataStructures::DistanceMatrix& dist, const vector<int>& stops,
+                         long long* length = nullptr, int workers = 0) {
+    int n = static_cast<int>(stops.size());
+    if (n > HELD_KARP_MAX_STOPS) {
+        Core::Logger::log(Core::LogLevel::WARNING, "Held-Karp limited to " + to_string(HELD_KARP_MAX_STOPS) + " stops, got " + to_string(n));
+        return {};
+    }
+    if (n <= 2) {
+        if (length) {
+            *length = 0;
+            for (int i = 0; i < n; i++) *length += dist.get(stops[i], stops[(i + 1) % n]);
+        }
+        return stops;
+    }
+    int m = n - 1;
+    int start = stops[0];
+    // toStop[j][k] = d(stop k, stop j): the column dp[..][j] reads, stored contiguously
+    vector<int> toStop(static_cast<size_t>(m) * HELD_KARP_LANES, GRAPH_INF);
+    vector<int> fromStart(m), toStart(m);
+    for (int j = 0; j < m; j++) {
+        fromStart[j] = dist.get(start, stops[j + 1]);
+        toStart[j] = dist.get(stops[j + 1], start);
+        for (int k = 0; k < m; k++)
+            if (k != j) toStop[static_cast<size_t>(j) * HELD_KARP_LANES + k] = dist.get(stops[k + 1], stops[j + 1]);
+    }
+
+    size_t subsets = size_t(1) << m;
+    vector<int> dp(subsets * HELD_KARP_LANES, GRAPH_INF);
+    for (int j = 0; j < m; j++) dp[(size_t(1) << j) * HELD_KARP_LANES + j] = fromStart[j];
+
+    if (workers <= 0) workers = parallelWorkerCount(m);
+    vector<uint32_t> layer;
+    for (int size = 2; size <= m; size++) {
+        // Masks with `size` bits, in increasing order (Gosper's hack)
+        layer.clear();
+        for (uint32_t mask = (1u << size) - 1; mask < subsets;) {
+            layer.push_back(mask);
+            uint32_t low = mask & (~mask + 1), ripple = mask + low;
+            mask = (((ripple ^ mask) >> 2) / low) | ripple;
+        }
+        atomic<size_t> nextChunk(0);
+        const size_t chunk = 256;
+        runOnWorkers(min(workers, static_cast<int>((layer.size() + chunk - 1) / chunk)), [&](int) {
+            for (size_t begin = nextChunk.fetch_add(chunk); begin < layer.size(); begin = nextChunk.fetch_add(chunk)) {
+                size_t end = min(layer.size(), begin + chunk);
+                for (size_t i = begin; i < end; i++) {
+                    uint32_t mask = layer[i];
+                    int* row = dp.data() + mask * HELD_KARP_LANES;
+                    for (uint32_t bits = mask; bits; bits &= bits - 1) {
+                        int j = __builtin_ctz(bits);
+                        const int* prev = dp.data() + (mask ^ (1u << j)) * HELD_KARP_LANES;
+                        const int* column = toStop.data() + static_cast<size_t>(j) * HELD_KARP_LANES;
+                        int best = GRAPH_INF;
+                        for (int k = 0; k < HELD_KARP_LANES; k++) best = min(best, prev[k] + column[k]);
+                        row[j] = min(best, GRAPH_INF);
+                    }
+                }
+            }
+        });
+    }
+
+    uint32_t full = static_cast<uint32_t>(subsets - 1);
+    long long bestLength = numeric_limits<long long>::max();
+    int last = 0;
+    for (int j = 0; j < m; j++) {
+        long long total = static_cast<long long>(dp[full * HELD_KARP_LANES + j]) + toStart[j];
+        if (total < bestLength) {
+            bestLength = total;
+            last = j;
+        }
+    }
+    if (length) *length = bestLength;
+
+    vector<int> order;
+    uint32_t mask = full;
+    for (int j = last; j >= 0;) {
+        order.push_back(stops[j + 1]);
+        int here = dp[mask * HELD_KARP_LANES + j];
+        uint32_t prevMask = mask ^ (1u << j);
+        int from = -1;
+        for (uint32_t bits = prevMask; bits; bits &= bits - 1) {
+            int k = __builtin_ctz(bits);
+            if (dp[prevMask * HELD_KARP_LANES + k] + toStop[static_cast<size_t>(j) * HELD_KARP_LANES + k] == here) {
+                from = k;
+                break;
+            }
+        }
+        mask = prevMask;
+        j = from;
+    }
+    order.push_back(start);
+    reverse(order.begin(), order.end());
+    if (static_cast<int>(order.size()) != n) {
+        // Only possible when some legs are unreachable and the table saturated
+        Core::Logger::log(Core::LogLevel::WARNING, "Held-Karp could not close the tour; keeping the given order");
+        return stops;
+    }
+    return order;
+}
+
+// TSP APPROXIMATION FUNCTION: Finds a short delivery route visiting all locations
+// HOW IT WORKS:
+// 1. Take pairwise distances from the all-pairs table (shortest road
+//    distance, so the metric holds even between locations with no direct road)
+// 2. Build a first tour with the nearest neighbor heuristic (this also
+//    finds which stops are reachable)
+// 3. Up to HELD_KARP_DISPATCH_LIMIT stops: replace it with the exact
+//    Held-Karp tour
+// 4. Otherwise improve it with 2-opt / Or-opt local search (TourImprover)
+//    within TOUR_IMPROVE_BUDGET_MS
+// 5. Return to starting location (complete the tour)
+// ALGORITHM: Held-Karp DP for small batches, else Nearest Neighbor +
+//            neighbour-list local search
+// TIME COMPLEXITY: O(2^n n²) for n <= 16; O(n²) construction plus capped
+//                  local search above
+// OPTIMALITY: Optimal up to 16 stops; usually within a few percent above
+// USE CASE: Quick route planning for multi-stop deliveries
+vector<int> tspApproximation(int start, int n) {
+    vector<int> route;
+    const AllPairsDistances* table = deliveryDistanceTable();
+    if (!table) {
+        Core::Logger::log(Core::LogLevel::WARNING, "TSP approximation needs the all-pairs table (at most " + to_string(APSP_MAX_NODES) + " locations)");
+        return route;
+    }
+    route = nearestNeighbourTour(table->table(), start, min(n, table->size()));
+    if (route.empty()) return route;
+    if (static_cast<int>(route.size()) <= HELD_KARP_DISPATCH_LIMIT) {
+        long long length = 0;
+        route = heldKarpTour(table->table(), route, &length);
+        route.push_back(start);
+        Core::Logger::log(Core::LogLevel::INFO, "TSP route computed exactly (Held-Karp): length " + to_string(length));
+        return route;
+    }
+    TourImprover improver(table->table());
+    TourImprover::Stats stats = improver.improve(route, TOUR_IMPROVE_BUDGET_MS);
+    route.push_back(start); // Return to start
+    
+    Core::Logger::log(Core::LogLevel::INFO, "TSP route computed: length " + to_string(stats.initialLength) + " -> " +
+                      to_string(stats.finalLength) + " (" + to_string(stats.twoOptMoves) + " 2-opt, " +
+                      to_string(stats.orOptMoves) + " Or-opt moves)");
+    return route;
+}
+
+void displayTSPRoute(const vector<int>& route) {
+    cout << "\nOptimal Delivery Route (TSP Approximation):\n";
+    const AllPairsDistances* table = deliveryDistanceTable();
+    if (route.empty() || !table) {
+        cout << "No route (graph too large for the all-pairs table).\n";
+        return;
+    }
+    long long totalDistance = 0;
+    for (int i = 0; i < (int)route.size() - 1; i++) {
+        int dist = table->distance(route[i], route[i + 1]);
+        if (i < DELIVERY_PRINT_LIMIT) {
+            cout << route[i] << " -> " << route[i + 1];
+            if (dist == GRAPH_INF) cout << " (unreachable)\n";
+            else cout << " (Distance: " << dist << ")\n";
+        } else if (i == DELIVERY_PRINT_LIMIT) {
+            cout << "... " << route.size() - 1 - DELIVERY_PRINT_LIMIT << " more legs\n";
+        }
+        if (dist != GRAPH_INF) totalDistance += dist;
+    }
+    cout << "Total Route Distance: " << totalDistance << " units\n";
+}
+
+// =============================================================
+// RIDER ROUTING (Capacitated VRP with Time Windows)
+// =============================================================
+
+static const int RESTAURANT_LOCATION = 0;       // depot: riders leave from and return here
+static const int RIDER_COUNT = 5;
+static const int RIDER_BAG_CAPACITY = 12;       // items per delivery bag
+static const int RIDER_SERVICE_MINUTES = 2;     // hand-over time at each stop
+static const double VRP_SOLVE_BUDGET_MS = 500;  // full re-plan
+static const double VRP_REOPTIMIZE_BUDGET_MS = 20; // per new order
+
+int deliveryClock = 0; // dispatch clock: minutes since delivery service opened
+
+// FLEET ROUTE PLANNER: Assigns online orders to riders and orders each rider's stops
+// HOW IT WORKS:
+// 1. Travel times between stops come from a callback (the delivery
+//    network's shortest distances, one unit = one minute) and are cached
+//    in a stop x stop table
+// 2. A route is feasible when its items fit one bag and every stop is
+//    reached by its promised window end (arriving early means waiting)
+// 3. Construction: Clarke-Wright savings. Every order starts on its own
+//    route; route pairs are merged in decreasing order of the distance
+//    saved, d(i,0) + d(0,j) - d(i,j), whenever i ends one route, j starts
+//    the other and the merged route is still feasible. Beyond the number of
+//    riders, the smallest routes are dissolved and their stops re-inserted
+//    at the cheapest feasible position.
+// 4. Local search between route pairs until no move helps or time is up:
+//    - relocate: move one stop to another position or rider
+//    - exchange: swap two stops between riders
+//    - 2-opt*: swap the tails of two riders' routes
+//    Routes are re-examined only after they change (dirty flags), so a
+//    new order costs a cheapest insertion plus a search around the routes
+//    it touched instead of a full re-plan
+// 5. Orders no rider can serve in time stay unassigned and are retried
+//    after every change
+// ALGORITHM: Savings construction + relocate / exchange / 2-opt* descent
+// TIME COMPLEXITY: O(n² log n) construction; a local search pass over two
+//                  routes of length L costs O(L³); both capped by the budget
+// USE CASE: Dispatching online delivery orders across the rider fleet
+class FleetRoutePlanner {
+public:
+    struct Stop {
+        int orderId;
+        int node;
+        int demand;       // items, against the bag capacity
+        int windowStart;  // minutes on the dispatch clock
+        int windowEnd;
+    };
+
+    struct Visit {
+        int orderId;
+        int node;
+        int arrival; // minutes on the dispatch clock, after any waiting
+    };
+
+private:
+    function<int(int, int)> travelTime;
+    int riders = 0;
+    int capacity = 0;
+    int departure = 0;           // clock minute riders leave the depot
+    vector<Stop> stops;          // index 0 is the depot
+    vector<vector<int>> travel;  // travel[i][j] between stop indices
+    vector<vector<int>> routes;  // one per rider, stop indices without the depot
+    vector<int> unassigned;
+    vector<char> dirty;
+    chrono::steady_clock::time_point deadline;
+    vector<int> candidateA, candidateB;
+
+    bool outOfTime() const { return chrono::steady_clock::now() > deadline; }
+
+    // Distance of depot -> route -> depot, or -1 if the route overfills the
+    // bag or misses a promised window
+    long long routeCost(const vector<int>& route) const {
+        int load = 0, at = 0;
+        long long distance = 0, clock = departure;
+        for (int s : route) {
+            load += stops[s].demand;
+            if (load > capacity) return -1;
+            distance += travel[at][s];
+            clock = max<long long>(clock + travel[at][s], stops[s].windowStart);
+            if (clock > stops[s].windowEnd) return -1;
+            clock += RIDER_SERVICE_MINUTES;
+            at = s;
+        }
+        return distance + travel[at][0];
+    }
+
+    int registerStop(const Stop& stop) {
+        int index = static_cast<int>(stops.size());
+        stops.push_back(stop);
+        travel.push_back(vector<int>(index + 1, 0));
+        for (int i = 0; i < index; i++) {
+            travel[i].push_back(travelTime(stops[i].node, stop.node));
+            travel[index][i] = travelTime(stop.node, stops[i].node);
+        }
+        return index;
+    }
+
+    // Cheapest feasible position for stop s over all riders
+    bool insertCheapest(int s) {
+        long long bestDelta = numeric_limits<long long>::max();
+        int bestRoute = -1, bestPos = 0;
+        for (int r = 0; r < riders; r++) {
+            long long before = routeCost(routes[r]);
+            for (int pos = 0; pos <= static_cast<int>(routes[r].size()); pos++) {
+                candidateA = routes[r];
+                candidateA.insert(candidateA.begin() + pos, s);
+                long long after = routeCost(candidateA);
+                if (after >= 0 && after - before < bestDelta) {
+                    bestDelta = after - before;
+                    bestRoute = r;
+                    bestPos = pos;
+                }
+            }
+        }
+        if (bestRoute < 0) return false;
+        routes[bestRoute].insert(routes[bestRoute].begin() + bestPos, s);
+        dirty[bestRoute] = 1;
+        return true;
+    }
+
+    void retryUnassigned() {
+        vector<int> waiting;
+        waiting.swap(unassigned);
+        for (int s : waiting)
+            if (!insertCheapest(s)) unassigned.push_back(s);
+    }
+
+    // Accepts the candidate pair if it is feasible and shorter than before
+    bool acceptIfBetter(int a, int b, long long before) {
+        long long costA = routeCost(candidateA);
+        if (costA < 0) return false;
+        long long costB = a == b ? 0 : routeCost(candidateB);
+        if (costB < 0 || costA + costB >= before) return false;
+        routes[a] = candidateA;
+        if (a != b) routes[b] = candidateB;
+        return true;
+    }
+
+    bool tryRelocate(int a, int b) {
+        long long before = routeCost(routes[a]) + (a == b ? 0 : routeCost(routes[b]));
+        const vector<int>& from = routes[a];
+        for (int i = 0; i < static_cast<int>(from.size()); i++) {
+            int limit = a == b ? static_cast<int>(from.size()) - 1 : static_cast<int>(routes[b].size());
+            for (int pos = 0; pos <= limit; pos++) {
+                if (a == b && pos == i) continue;
+                candidateA = routes[a];
+                int s = candidateA[i];
+                candidateA.erase(candidateA.begin() + i);
+                if (a == b) {
+                    candidateA.insert(candidateA.begin() + pos, s);
+                } else {
+                    candidateB = routes[b];
+                    candidateB.insert(candidateB.begin() + pos, s);
+                }
+                if (acceptIfBetter(a, b, before)) return true;
+            }
+        }
+        return false;
+    }
+
+    bool tryExchange(int a, int b) {
+        long long before = routeCost(routes[a]) + routeCost(routes[b]);
+        for (int i = 0; i < static_cast<int>(routes[a].size()); i++) {
+            for (int j = 0; j < static_cast<int>(routes[b].size()); j++) {
+                candidateA = routes[a];
+                candidateB = routes[b];
+                swap(candidateA[i], candidateB[j]);
+                if (acceptIfBetter(a, b, before)) return true;
+            }
+        }
+        return false;
+    }
+
+    // a keeps its first i stops then takes b's tail from j, and vice versa
+    bool tryTwoOptStar(int a, int b) {
+        long long before = routeCost(routes[a]) + routeCost(routes[b]);
+        int lengthA = static_cast<int>(routes[a].size()), lengthB = static_cast<int>(routes[b].size());
+        for (int i = 0; i <= lengthA; i++) {
+            for (int j = 0; j <= lengthB; j++) {
+                if ((i == 0 && j == 0) || (i == lengthA && j == lengthB)) continue; // same two routes
+                candidateA.assign(routes[a].begin(), routes[a].begin() + i);
+                candidateA.insert(candidateA.end(), routes[b].begin() + j, routes[b].end());
+                candidateB.assign(routes[b].begin(), routes[b].begin() + j);
+                candidateB.insert(candidateB.end(), routes[a].begin() + i, routes[a].end());
+                if (acceptIfBetter(a, b, before)) return true;
+            }
+        }
+        return false;
+    }
+
+    void localSearch() {
+        retryUnassigned();
+        while (!outOfTime()) {
+            int a = static_cast<int>(find(dirty.begin(), dirty.end(), 1) - dirty.begin());
+            if (a == riders) break;
+            dirty[a] = 0;
+            for (int b = 0; b < riders && !outOfTime(); b++) {
+                bool moved = tryRelocate(a, b) || (b != a && (tryRelocate(b, a) || tryExchange(a, b) || tryTwoOptStar(a, b)));
+                if (moved) {
+                    dirty[a] = dirty[b] = 1;
+                    break;
+                }
+            }
+        }
+        retryUnassigned();
+    }
+
+public:
+    void reset(int depotNode, int riderCount, int bagCapacity, function<int(int, int)> travelFn) {
+        travelTime = move(travelFn);
+        riders = riderCount;
+        capacity = bagCapacity;
+        stops.clear();
+        travel.clear();
+        routes.assign(riders, {});
+        dirty.assign(riders, 0);
+        unassigned.clear();
+        departure = 0;
+        registerStop({0, depotNode, 0, 0, numeric_limits<int>::max()});
+    }
+
+    // Clock minute the planned routes start from (windows are on the same clock)
+    void setDeparture(int minute) { departure = minute; }
+
+    void addStop(const Stop& stop) {
+        unassigned.push_back(registerStop(stop));
+    }
+
+    // Full re-plan of every registered stop within budgetMs
+    void solve(double budgetMs) {
+        deadline = chrono::steady_clock::now() + chrono::microseconds(static_cast<long long>(budgetMs * 1000));
+        int n = static_cast<int>(stops.size());
+        routes.assign(riders, {});
+        unassigned.clear();
+
+        // Savings construction
+        vector<vector<int>> built;
+        vector<int> routeOf(n, -1);
+        for (int s = 1; s < n; s++) {
+            if (routeCost({s}) < 0) {
+                unassigned.push_back(s); // cannot be served in time even alone
+                continue;
+            }
+            routeOf[s] = static_cast<int>(built.size());
+            built.push_back({s});
+        }
+        vector<tuple<long long, int, int>> savings;
+        for (int i = 1; i < n; i++) {
+            if (routeOf[i] < 0) continue;
+            for (int j = 1; j < n; j++) {
+                if (i == j || routeOf[j] < 0) continue;
+                long long saved = static_cast<long long>(travel[i][0]) + travel[0][j] - travel[i][j];
+                if (saved > 0) savings.emplace_back(saved, i, j);
+            }
+        }
+        sort(savings.begin(), savings.end(), greater<tuple<long long, int, int>>());
+        for (const auto& [saved, i, j] : savings) {
+            int ri = routeOf[i], rj = routeOf[j];
+            if (ri == rj || built[ri].back() != i || built[rj].front() != j) continue;
+            candidateA = built[ri];
+            candidateA.insert(candidateA.end(), built[rj].begin(), built[rj].end());
+            if (routeCost(candidateA) < 0) continue;
+            for (int s : built[rj]) routeOf[s] = ri;
+            built[ri] = candidateA;
+            built[rj].clear();
+        }
+
+        // One route per rider, biggest loads first; the rest are re-inserted
+        vector<pair<int, int>> bySize;
+        for (int r = 0; r < static_cast<int>(built.size()); r++) {
+            if (built[r].empty()) continue;
+            int load = 0;
+            for (int s : built[r]) load += stops[s].demand;
+            bySize.push_back({load, r});
+        }
+        sort(bySize.begin(), bySize.end(), greater<pair<int, int>>());
+        for (int k = 0; k < static_cast<int>(bySize.size()); k++) {
+            const vector<int>& route = built[bySize[k].second];
+            if (k < riders) routes[k] = route;
+            else unassigned.insert(unassigned.end(), route.begin(), route.end());
+        }
+        dirty.assign(riders, 1);
+        localSearch();
+    }
+
+    // Adds one order to the current plan: cheapest insertion, then local
+    // search around the routes that changed. Returns false if no rider can
+    // take it (it stays queued and is retried after later changes).
+    bool insertOrder(const Stop& stop, double budgetMs) {
+        deadline = chrono::steady_clock::now() + chrono::microseconds(static_cast<long long>(budgetMs * 1000));
+        int s = registerStop(stop);
+        bool placed = insertCheapest(s);
+        if (!placed) unassigned.push_back(s);
+        localSearch();
+        return placed || find(unassigned.begin(), unassigned.end(), s) == unassigned.end();
+    }
+
+    int riderCount() const { return riders; }
+    int stopCount() const { return static_cast<int>(stops.size()) - 1; }
+
+    long long totalDistance() const {
+        long long total = 0;
+        for (const auto& route : routes) total += route.empty() ? 0 : routeCost(route);
+        return total;
+    }
+
+    int ridersUsed() const {
+        int used = 0;
+        for (const auto& route : routes) used += !route.empty();
+        return used;
+    }
+
+    vector<int> unassignedOrders() const {
+        vector<int> ids;
+        for (int s : unassigned) ids.push_back(stops[s].orderId);
+        return ids;
+    }
+
+    // Stops of one rider with arrival times
+    vector<Visit> schedule(int rider) const {
+        vector<Visit> visits;
+        long long clock = departure;
+        int at = 0;
+        for (int s : routes[rider]) {
+            clock = max<long long>(clock + travel[at][s], stops[s].windowStart);
+            visits.push_back({stops[s].orderId, stops[s].node, static_cast<int>(clock)});
+            clock += RIDER_SERVICE_MINUTES;
+            at = s;
+        }
+        return visits;
+    }
+};
+
+FleetRoutePlanner riderPlanner;
+int riderPlannerVersion = -1; // deliveryGraphVersion the planner's travel times came from
+
+bool onlineOrderRoutable(const OnlineOrder& order) {
+    return (order.status == "Placed" || order.status == "Confirmed") && order.assignedRider < 0 && order.deliveryNode >= 0 &&
+           order.deliveryNode < deliveryCSR().nodeCount();
+}
+
+FleetRoutePlanner::Stop riderStopFor(const OnlineOrder& order) {
+    return {order.orderId, order.deliveryNode, max(1, order.itemCount), order.windowStart, order.windowEnd};
+}
+
+// Copies the planned arrival times into the orders' delivery estimates
+void publishRiderETAs() {
+    for (int r = 0; r < riderPlanner.riderCount(); r++) {
+        for (const auto& visit : riderPlanner.schedule(r)) {
+            for (int i = 0; i < onlineOrderCount; i++)
+                if (onlineOrders[i].orderId == visit.orderId) onlineOrders[i].deliveryTime = visit.arrival;
+        }
+    }
+}
+
+// PLAN RIDER ROUTES FUNCTION: Full re-plan over every open online order
+// TIME COMPLEXITY: O(n² log n) + local search within budgetMs
+void planRiderRoutes(double budgetMs = VRP_SOLVE_BUDGET_MS) {
+    deliveryCSR();
+    riderPlanner.reset(RESTAURANT_LOCATION, RIDER_COUNT, RIDER_BAG_CAPACITY, deliveryDistance);
+    riderPlanner.setDeparture(deliveryClock);
+    riderPlannerVersion = deliveryGraphVersion;
+    for (int i = 0; i < onlineOrderCount; i++)
+        if (onlineOrderRoutable(onlineOrders[i])) riderPlanner.addStop(riderStopFor(onlineOrders[i]));
+    riderPlanner.solve(budgetMs);
+    publishRiderETAs();
+    Core::Logger::log(Core::LogLevel::INFO, "Rider routes planned: " + to_string(riderPlanner.stopCount()) + " orders, " +
+                      to_string(riderPlanner.ridersUsed()) + " riders, distance " + to_string(riderPlanner.totalDistance()));
+}
+
+int dispatchDeliveryWaves(bool timerTick); // delivery waves, below
+
+// PLACE ONLINE ORDER FUNCTION: Records an online order and slots it into the rider plan
+// HOW IT WORKS:
+// 0. Reject locations outside the delivery zone (one band lookup)
+// 1. Append the order with status "Placed"; the window is given in minutes
+//    from now and stored on the dispatch clock
+// 2. If the current plan was built on the same road network, insert the
+//    order incrementally within VRP_REOPTIMIZE_BUDGET_MS; otherwise re-plan
+// 3. Send out any delivery wave the order filled up
+// TIME COMPLEXITY: O(riders * L²) insertion + bounded local search
+bool placeOnlineOrder(int customerId, const string& address, const vector<string>& items, double total,
+                      int node, int windowStart, int windowEnd) {
+    if (onlineOrderCount >= MAX_ONLINE_ORDERS) {
+        Core::Logger::log(Core::LogLevel::WARNING, "Online order list full");
+        return false;
+    }
+    if (node >= 0 && node < deliveryCSR().nodeCount() && !withinDeliveryZone(node)) {
+        Core::Logger::log(Core::LogLevel::WARNING, "Online order rejected: location " + to_string(node) + " is outside the " +
+                          to_string(deliveryZoneBands.back()) + "-minute delivery zone");
+        return false;
+    }
+    OnlineOrder& order = onlineOrders[onlineOrderCount];
+    order.orderId = onlineOrderCount + 1;
+    order.customerId = customerId;
+    order.deliveryAddress = address;
+    order.itemCount = min(static_cast<int>(items.size()), 20);
+    for (int i = 0; i < order.itemCount; i++) order.items[i] = items[i];
+    order.totalAmount = total;
+    order.status = "Placed";
+    order.deliveryTime = -1;
+    order.deliveryNode = node;
+    order.windowStart = deliveryClock + windowStart;
+    order.windowEnd = deliveryClock + windowEnd;
+    order.assignedRider = -1;
+    order.placedAt = deliveryClock;
+    onlineOrderCount++;
+    Core::Logger::log(Core::LogLevel::INFO, "Online order " + to_string(order.orderId) + " placed");
+
+    if (order.deliveryNode >= 0 && !deliveryReachable(RESTAURANT_LOCATION, order.deliveryNode)) {
+        Core::Logger::log(Core::LogLevel::WARNING, "Online order " + to_string(order.orderId) + ": location " +
+                          to_string(order.deliveryNode) + " cannot be reached from the restaurant");
+        order.deliveryNode = -1;
+    }
+    if (!onlineOrderRoutable(order)) return true;
+    deliveryCSR();
+    if (riderPlannerVersion != deliveryGraphVersion) {
+        planRiderRoutes();
+    } else {
+        if (!riderPlanner.insertOrder(riderStopFor(order), VRP_REOPTIMIZE_BUDGET_MS))
+            Core::Logger::log(Core::LogLevel::WARNING, "No rider can take order " + to_string(order.orderId) + " yet (bag capacity or delivery window)");
+        publishRiderETAs();
+    }
+    dispatchDeliveryWaves(false);
+    return true;
+}
+
+void displayRiderRoutes() {
+    cout << "\nRider Routes (from location " << RESTAURANT_LOCATION << ", bag capacity " << RIDER_BAG_CAPACITY << " items):\n";
+    for (int r = 0; r < riderPlanner.riderCount(); r++) {
+        vector<FleetRoutePlanner::Visit> visits = riderPlanner.schedule(r);
+        if (visits.empty()) continue;
+        cout << "Rider " << r + 1 << ": ";
+        for (const auto& v : visits) cout << "#" << v.orderId << "@" << v.node << " (" << v.arrival << " min) -> ";
+        cout << "back\n";
+    }
+    vector<int> waiting = riderPlanner.unassignedOrders();
+    if (!waiting.empty()) {
+        cout << "Unassigned orders:";
+        for (int id : waiting) cout << " #" << id;
+        cout << "\n";
+    }
+    cout << "Total riding distance: " << riderPlanner.totalDistance() << " units\n";
+}
+
+// =============================================================
+// RIDER ASSIGNMENT (Hungarian / Jonker-Volgenant)
+// =============================================================
+
+static const long long ASSIGNMENT_LATE_PENALTY = 5; // cost units per minute past the promised window
+
+// ASSIGNMENT SOLVER: Minimum-cost matching of rows (riders) to columns (orders)
+// HOW IT WORKS:
+// 1. Keep dual prices u (rows) and v (columns) with c[i][j] - u[i] - v[j] >= 0
+//    everywhere and == 0 on matched pairs; such a matching is optimal
+// 2. Add unmatched rows one at a time: a Dijkstra-like scan over reduced
+//    costs grows an alternating tree from the row until it reaches a free
+//    column, adjusting prices by the smallest slack each step, then flips
+//    the path (shortest augmenting path, as in Jonker-Volgenant)
+// 3. Rectangular input is transposed so rows <= columns; extra columns
+//    stay unmatched with price 0
+// 4. Warm start: prices and matches from the previous call are looked up
+//    by row/column id. Rows get u = min over j of (c - v) and old matches
+//    that are still tight are kept, so only rows whose costs moved need an
+//    augmenting path. (Rectangular problems also reset free columns' prices
+//    to 0, which can cascade and keeps fewer matches.)
+// ALGORITHM: Hungarian method with potentials (shortest augmenting paths)
+// TIME COMPLEXITY: O(n² m) cold for n <= m; O(k n m) warm with k rows to augment
+// USE CASE: Assigning riders who come back together to waiting orders
+class AssignmentSolver {
+public:
+    struct Result {
+        vector<int> colOfRow;  // -1 when the row is left unmatched (more rows than columns)
+        long long totalCost = 0;
+        int augmented = 0;     // rows that needed an augmenting path
+    };
+
+private:
+    unordered_map<int, long long> priceOf; // column id -> dual price from the last solve
+    unordered_map<int, int> lastMatch;     // row id -> column id
+    bool lastTransposed = false;
+
+public:
+    void forget() {
+        priceOf.clear();
+        lastMatch.clear();
+    }
+
+    // cost is rows x cols (non-negative); ids identify rows and columns
+    // across calls for the warm start
+    Result solve(const vector<vector<long long>>& cost, const vector<int>& rowIds, const vector<int>& colIds, bool warm = true) {
+        int rows = static_cast<int>(cost.size());
+        int cols = rows ? static_cast<int>(cost[0].size()) : 0;
+        Result result;
+        result.colOfRow.assign(rows, -1);
+        if (rows == 0 || cols == 0) return result;
+
+        bool transposed = rows > cols;
+        int n = transposed ? cols : rows, m = transposed ? rows : cols;
+        const vector<int>& nIds = transposed ? colIds : rowIds;
+        const vector<int>& mIds = transposed ? rowIds : colIds;
+        vector<vector<long long>> c(n + 1, vector<long long>(m + 1, 0)); // 1-based
+        for (int i = 1; i <= n; i++)
+            for (int j = 1; j <= m; j++) c[i][j] = transposed ? cost[j - 1][i - 1] : cost[i - 1][j - 1];
+
+        const long long INF = numeric_limits<long long>::max() / 4;
+        vector<long long> u(n + 1, 0), v(m + 1, 0);
+        vector<int> p(m + 1, 0), way(m + 1, 0); // p[j] = row matched to column j
+        if (warm && transposed == lastTransposed) {
+            unordered_map<int, int> column;
+            for (int j = 1; j <= m; j++) {
+                column[mIds[j - 1]] = j;
+                auto price = priceOf.find(mIds[j - 1]);
+                if (price != priceOf.end()) v[j] = min(0LL, price->second);
+            }
+            for (int i = 1; i <= n; i++) {
+                auto match = lastMatch.find(nIds[i - 1]);
+                if (match == lastMatch.end()) continue;
+                auto j = column.find(match->second);
+                if (j != column.end() && p[j->second] == 0) p[j->second] = i;
+            }
+        }
+        for (bool changed = true; changed;) {
+            changed = false;
+            // Columns left over in a rectangular problem must end with price
+            // 0; square problems match every column, so old prices can stay
+            if (n < m)
+                for (int j = 1; j <= m; j++)
+                    if (p[j] == 0) v[j] = 0;
+            for (int i = 1; i <= n; i++) {
+                u[i] = INF;
+                for (int j = 1; j <= m; j++) u[i] = min(u[i], c[i][j] - v[j]);
+            }
+            for (int j = 1; j <= m; j++) {
+                if (p[j] != 0 && c[p[j]][j] - v[j] != u[p[j]]) {
+                    p[j] = 0; // no longer tight under the new costs
+                    changed = true;
+                }
+            }
+        }
+
+        vector<char> matched(n + 1, 0), used(m + 1);
+        vector<long long> minv(m + 1);
+        for (int j = 1; j <= m; j++) matched[p[j]] = 1;
+        for (int i = 1; i <= n; i++) {
+            if (matched[i]) continue;
+            result.augmented++;
+            p[0] = i;
+            int j0 = 0;
+            fill(minv.begin(), minv.end(), INF);
+            fill(used.begin(), used.end(), 0);
+            do {
+                used[j0] = 1;
+                int i0 = p[j0], j1 = 0;
+                long long delta = INF;
+                const long long* row = c[i0].data();
+                for (int j = 1; j <= m; j++) {
+                    if (used[j]) continue;
+                    long long reduced = row[j] - u[i0] - v[j];
+                    if (reduced < minv[j]) {
+                        minv[j] = reduced;
+                        way[j] = j0;
+                    }
+                    if (minv[j] < delta) {
+                        delta = minv[j];
+                        j1 = j;
+                    }
+                }
+                for (int j = 0; j <= m; j++) {
+                    if (used[j]) {
+                        u[p[j]] += delta;
+                        v[j] -= delta;
+                    } else {
+                        minv[j] -= delta;
+                    }
+                }
+                j0 = j1;
+            } while (p[j0] != 0);
+            do {
+                int j1 = way[j0];
+                p[j0] = p[j1];
+                j0 = j1;
+            } while (j0);
+        }
+
+        lastTransposed = transposed;
+        priceOf.clear();
+        lastMatch.clear();
+        for (int j = 1; j <= m; j++) {
+            priceOf[mIds[j - 1]] = v[j];
+            if (p[j] == 0) continue;
+            lastMatch[nIds[p[j] - 1]] = mIds[j - 1];
+            int row = transposed ? j - 1 : p[j] - 1, col = transposed ? p[j] - 1 : j - 1;
+            result.colOfRow[row] = col;
+            result.totalCost += cost[row][col];
+        }
+        return result;
+    }
+};
 
-bool assignTableFromWaitlist() {
-    if (waitlistCount == 0) return false;
-    
-    WaitlistEntry entry = waitlist[0];
-    int tableNum = findAvailableTable(entry.partySize);
-    
-    if (tableNum != -1) {
-        tableOccupied[tableNum] = true;
-        entry.status = "Seated";
-        for (int i = 0; i < waitlistCount - 1; i++) {
-            waitlist[i] = waitlist[i + 1];
+struct RiderPosition {
+    int riderId;
+    int node; // where the rider is now
+};
+
+AssignmentSolver riderAssigner;
+
+// ASSIGN RETURNING RIDERS FUNCTION: Matches free riders to waiting online orders
+// HOW IT WORKS:
+// 1. Cost of rider r taking order o = d(r, restaurant) + d(restaurant, o)
+//    plus ASSIGNMENT_LATE_PENALTY per minute the arrival misses o's window
+// 2. Solve the (possibly rectangular) assignment, warm-started from the
+//    previous dispatch
+// 3. Matched orders are confirmed with the rider and an ETA and leave the
+//    fleet route plan, which is re-planned if it had stops
+// TIME COMPLEXITY: O(R·O) cost matrix (table lookups) + O(min² · max) solve
+// Returns (riderId, orderId) pairs
+vector<pair<int, int>> assignReturningRiders(const vector<RiderPosition>& riders) {
+    vector<pair<int, int>> assignment;
+    vector<int> waiting;
+    for (int i = 0; i < onlineOrderCount; i++)
+        if (onlineOrderRoutable(onlineOrders[i])) waiting.push_back(i);
+    if (riders.empty() || waiting.empty()) return assignment;
+
+    vector<vector<long long>> cost(riders.size(), vector<long long>(waiting.size()));
+    vector<vector<int>> eta(riders.size(), vector<int>(waiting.size()));
+    vector<int> riderIds, orderIds;
+    for (const auto& rider : riders) riderIds.push_back(rider.riderId);
+    for (int o : waiting) orderIds.push_back(onlineOrders[o].orderId);
+    for (size_t r = 0; r < riders.size(); r++) {
+        int pickup = deliveryDistance(riders[r].node, RESTAURANT_LOCATION);
+        for (size_t k = 0; k < waiting.size(); k++) {
+            const OnlineOrder& order = onlineOrders[waiting[k]];
+            int drop = deliveryDistance(RESTAURANT_LOCATION, order.deliveryNode);
+            if (pickup == GRAPH_INF || drop == GRAPH_INF) {
+                cost[r][k] = GRAPH_INF;
+                eta[r][k] = -1;
+                continue;
+            }
+            int arrival = max(deliveryClock + pickup + drop, order.windowStart);
+            eta[r][k] = arrival;
+            cost[r][k] = pickup + drop + ASSIGNMENT_LATE_PENALTY * max(0, arrival - order.windowEnd);
         }
-        waitlistCount--;
-        Core::Logger::log(Core::LogLevel::INFO, "Customer from waitlist seated at table " + to_string(tableNum));
-        cout << "Customer seated at table " << tableNum << "\n";
-        return true;
     }
-    return false;
+
+    AssignmentSolver::Result result = riderAssigner.solve(cost, riderIds, orderIds);
+    for (size_t r = 0; r < riders.size(); r++) {
+        int k = result.colOfRow[r];
+        if (k < 0 || cost[r][k] >= GRAPH_INF) continue;
+        OnlineOrder& order = onlineOrders[waiting[k]];
+        order.assignedRider = riders[r].riderId;
+        order.status = "Confirmed";
+        order.deliveryTime = eta[r][k];
+        assignment.push_back({riders[r].riderId, order.orderId});
+    }
+    Core::Logger::log(Core::LogLevel::INFO, "Assigned " + to_string(assignment.size()) + " returning riders (cost " +
+                      to_string(result.totalCost) + ", " + to_string(result.augmented) + " augmentations)");
+    if (!assignment.empty() && riderPlanner.stopCount() > 0) planRiderRoutes();
+    return assignment;
 }
 
 // =============================================================
-// ADVANCED DELIVERY ROUTE OPTIMIZATION (TSP Approximation)
+// DELIVERY WAVES (Capacity-Constrained K-Medoids Batching)
 // =============================================================
 
-// TSP APPROXIMATION FUNCTION: Finds reasonable delivery route visiting all locations
+static const int WAVE_TICK_MINUTES = 5;      // dispatch timer period
+static const int WAVE_MAX_HOLD_MINUTES = 15; // longest an order waits for its wave to fill
+static const int WAVE_FULL_PERCENT = 80;     // bag share at which a wave leaves without waiting
+static const int WAVE_KMEDOIDS_ROUNDS = 12;
+static const int WAVE_CANDIDATE_MEDOIDS = 8; // nearest medoids tried per order before a full scan
+static const int WAVE_LOG_LIMIT = 100;       // dispatched waves kept for display
+
+// WAVE BATCHER: Groups pending delivery orders into rider trips ("waves")
 // HOW IT WORKS:
-// 1. Use Nearest Neighbor Heuristic:
-//    a. Start at given location
-//    b. From current location, find nearest unvisited location
-//    c. Move to that location and mark as visited
-//    d. Repeat until all locations visited
-// 2. Return to starting location (complete the tour)
-// 3. Result: Reasonable (not optimal) delivery route
-// ALGORITHM: Nearest Neighbor - greedy TSP approximation
-// TIME COMPLEXITY: O(n²) where n is number of locations
-// OPTIMALITY: Approximation within 2x optimal, but not always optimal
-// USE CASE: Quick route planning for multi-stop deliveries
-vector<int> tspApproximation(int start, int n) {
-    vector<int> route;
-    vector<bool> visited(n, false);
-    int current = start;
-    route.push_back(current);
-    visited[current] = true;
-    
-    // Nearest neighbor heuristic
-    for (int i = 1; i < n; i++) {
-        int nearest = -1;
-        int minDist = 1e9;
-        for (int j = 0; j < n; j++) {
-            if (!visited[j] && deliveryGraph[current][j] < minDist) {
-                minDist = deliveryGraph[current][j];
-                nearest = j;
+// 1. Dissimilarity of two orders = road distance there and back plus the
+//    gap between their promised window ends, so a wave holds orders that
+//    are close both on the map and on the clock
+// 2. Capacity-constrained k-medoids: k starts at ceil(items / bag size),
+//    seeded with the order farthest from the restaurant and then, one at a
+//    time, the order farthest from every seed so far. Each round hands
+//    (order, medoid) pairs out in increasing dissimilarity while the
+//    medoid's bag has room (an order that fits nowhere opens a new
+//    cluster), then moves each medoid to the member with the smallest total
+//    dissimilarity to its cluster; stops once the medoids settle
+// 3. Each cluster becomes a trip ridden in the exact Held-Karp order
+//    (either direction) or earliest-deadline-first, whichever is on time
+//    and shorter. If none is on time, the stop that is latest is dropped
+//    and all dropped stops are clustered again in the next pass
+// 4. A wave is due as soon as its bag is WAVE_FULL_PERCENT full, or on a
+//    timer tick when waiting another tick could miss a window or its
+//    oldest order has been held WAVE_MAX_HOLD_MINUTES
+// ALGORITHM: Capacity-constrained k-medoids (Voronoi iteration) + Held-Karp
+// TIME COMPLEXITY: O(n²) dissimilarities, O(n k + n log n) per k-medoids
+//                  round, O(2^s s²) to order a wave of s <= 16 stops
+// USE CASE: Sending riders out with full bags instead of one order per trip
+class WaveBatcher {
+public:
+    struct Order {
+        int orderId;
+        int node;
+        int items;
+        int windowStart; // dispatch clock minutes
+        int windowEnd;
+        int readySince;  // clock minute the order started waiting
+    };
+
+    struct Wave {
+        vector<int> orderIds; // in riding order
+        vector<int> nodes;
+        vector<int> arrivals; // clock minutes when leaving at the planning time
+        int load = 0;
+        long long distance = 0;  // restaurant -> stops -> restaurant
+        int latestDeparture = 0; // leaving later misses a window (ignores waiting, so conservative)
+        int oldestSince = 0;
+        bool onTime = true;
+    };
+
+    struct Stats {
+        int orders = 0;
+        int skipped = 0;  // unreachable from the restaurant
+        int clusters = 0;
+        int rounds = 0;
+        int split = 0;    // stops dropped from a wave to keep it on time
+        double matrixMs = 0;
+        double clusterMs = 0;
+        double routeMs = 0;
+    };
+
+private:
+    function<int(int, int)> travelTime;
+    int depotNode = 0;
+    int capacity = 0;
+    vector<Order> orders;
+    vector<vector<int>> travel; // between order indices; index orders.size() is the depot
+    vector<vector<int>> gap;    // dissimilarity used for clustering
+    Stats stats;
+
+    int depot() const { return static_cast<int>(orders.size()); }
+
+    // One k-medoids assignment pass; returns the clusters, medoid first
+    vector<vector<int>> assign(const vector<int>& members, const vector<int>& medoids) {
+        int k = static_cast<int>(medoids.size());
+        vector<vector<int>> clusters(k);
+        vector<int> load(k), clusterOf(orders.size(), -1);
+        for (int c = 0; c < k; c++) {
+            clusters[c].push_back(medoids[c]);
+            load[c] = orders[medoids[c]].items;
+            clusterOf[medoids[c]] = c;
+        }
+        vector<tuple<int, int, int>> pairs;
+        vector<pair<int, int>> near(k);
+        int candidates = min(k, WAVE_CANDIDATE_MEDOIDS);
+        for (int i : members) {
+            if (clusterOf[i] >= 0) continue;
+            for (int c = 0; c < k; c++) near[c] = {gap[i][medoids[c]], c};
+            nth_element(near.begin(), near.begin() + (candidates - 1), near.end());
+            for (int c = 0; c < candidates; c++) pairs.emplace_back(near[c].first, i, near[c].second);
+        }
+        sort(pairs.begin(), pairs.end());
+        for (const auto& [d, i, c] : pairs) {
+            if (clusterOf[i] >= 0 || load[c] + orders[i].items > capacity) continue;
+            clusterOf[i] = c;
+            load[c] += orders[i].items;
+            clusters[c].push_back(i);
+        }
+        for (int i : members) {
+            if (clusterOf[i] >= 0) continue;
+            int best = -1;
+            for (int c = 0; c < static_cast<int>(clusters.size()); c++)
+                if (load[c] + orders[i].items <= capacity && (best < 0 || gap[i][clusters[c][0]] < gap[i][clusters[best][0]])) best = c;
+            if (best < 0) {
+                best = static_cast<int>(clusters.size());
+                clusters.push_back({});
+                load.push_back(0);
+            }
+            clusterOf[i] = best;
+            load[best] += orders[i].items;
+            clusters[best].push_back(i);
+        }
+        return clusters;
+    }
+
+    vector<vector<int>> cluster(const vector<int>& members) {
+        int total = 0;
+        for (int i : members) total += orders[i].items;
+        int k = max(1, min(static_cast<int>(members.size()), (total + capacity - 1) / capacity));
+
+        // Farthest-point seeding, starting from the order farthest out
+        vector<int> medoids;
+        vector<int> nearest(members.size(), numeric_limits<int>::max());
+        int first = 0;
+        for (int m = 1; m < static_cast<int>(members.size()); m++)
+            if (travel[depot()][members[m]] > travel[depot()][members[first]]) first = m;
+        for (int seed = first; static_cast<int>(medoids.size()) < k;) {
+            medoids.push_back(members[seed]);
+            nearest[seed] = -1;
+            seed = -1;
+            for (int m = 0; m < static_cast<int>(members.size()); m++) {
+                if (nearest[m] < 0) continue;
+                nearest[m] = min(nearest[m], gap[members[m]][medoids.back()]);
+                if (seed < 0 || nearest[m] > nearest[seed]) seed = m;
+            }
+            if (seed < 0) break;
+        }
+
+        vector<vector<int>> clusters;
+        for (int round = 0; round < WAVE_KMEDOIDS_ROUNDS; round++) {
+            stats.rounds++;
+            clusters = assign(members, medoids);
+            bool moved = clusters.size() != medoids.size();
+            medoids.resize(clusters.size());
+            for (size_t c = 0; c < clusters.size(); c++) {
+                long long bestSum = numeric_limits<long long>::max();
+                int best = clusters[c][0];
+                for (int x : clusters[c]) {
+                    long long sum = 0;
+                    for (int y : clusters[c]) sum += gap[x][y];
+                    if (sum < bestSum) {
+                        bestSum = sum;
+                        best = x;
+                    }
+                }
+                if (best != medoids[c]) moved = true;
+                medoids[c] = best;
+            }
+            if (!moved) break;
+        }
+        return clusters;
+    }
+
+    // Schedules `sequence` (order indices) leaving the restaurant at `now`;
+    // lateness gets the total minutes past windows, worst the latest stop
+    Wave evaluate(const vector<int>& sequence, int now, long long& lateness, int& worst) const {
+        Wave wave;
+        wave.latestDeparture = numeric_limits<int>::max();
+        wave.oldestSince = now;
+        lateness = 0;
+        worst = -1;
+        int at = depot(), worstLate = 0;
+        long long clock = now;
+        for (int s : sequence) {
+            const Order& order = orders[s];
+            wave.distance += travel[at][s];
+            clock = max<long long>(clock + travel[at][s], order.windowStart);
+            int slack = static_cast<int>(order.windowEnd - clock);
+            wave.latestDeparture = min(wave.latestDeparture, now + slack);
+            if (slack < 0) {
+                lateness -= slack;
+                if (worst < 0 || -slack > worstLate) {
+                    worst = s;
+                    worstLate = -slack;
+                }
             }
+            wave.orderIds.push_back(order.orderId);
+            wave.nodes.push_back(order.node);
+            wave.arrivals.push_back(static_cast<int>(clock));
+            wave.load += order.items;
+            wave.oldestSince = min(wave.oldestSince, order.readySince);
+            clock += RIDER_SERVICE_MINUTES;
+            at = s;
+        }
+        wave.distance += travel[at][depot()];
+        wave.onTime = lateness == 0;
+        return wave;
+    }
+
+    // Best riding order for one cluster; worst is set to the stop to drop
+    // when no order is on time
+    Wave buildWave(const vector<int>& members, int now, int& worst) const {
+        int m = static_cast<int>(members.size());
+        DataStructures::DistanceMatrix local;
+        local.reset(m + 1, GRAPH_INF);
+        vector<int> index = {depot()};
+        index.insert(index.end(), members.begin(), members.end());
+        for (int i = 0; i <= m; i++)
+            for (int j = 0; j <= m; j++) local.set(i, j, travel[index[i]][index[j]]);
+
+        vector<int> tour;
+        if (m + 1 <= HELD_KARP_DISPATCH_LIMIT) {
+            vector<int> all(m + 1);
+            iota(all.begin(), all.end(), 0);
+            tour = heldKarpTour(local, all, nullptr, 1);
+        } else {
+            tour = nearestNeighbourTour(local, 0, m + 1);
+            TourImprover(local).improve(tour, 5);
         }
-        if (nearest != -1) {
-            route.push_back(nearest);
-            visited[nearest] = true;
-            current = nearest;
+        vector<vector<int>> sequences(3);
+        for (size_t p = 1; p < tour.size(); p++) sequences[0].push_back(index[tour[p]]);
+        sequences[1].assign(sequences[0].rbegin(), sequences[0].rend());
+        sequences[2] = members;
+        sort(sequences[2].begin(), sequences[2].end(), [this](int a, int b) { return orders[a].windowEnd < orders[b].windowEnd; });
+
+        Wave best;
+        long long bestLateness = numeric_limits<long long>::max();
+        for (const auto& sequence : sequences) {
+            long long lateness;
+            int latest;
+            Wave wave = evaluate(sequence, now, lateness, latest);
+            if (lateness < bestLateness || (lateness == bestLateness && wave.distance < best.distance)) {
+                best = wave;
+                bestLateness = lateness;
+                worst = static_cast<int>(find(members.begin(), members.end(), latest) - members.begin());
+            }
         }
+        return best;
     }
-    route.push_back(start); // Return to start
-    
-    Core::Logger::log(Core::LogLevel::INFO, "TSP route computed");
-    return route;
+
+public:
+    void reset(int depotLocation, int bagCapacity, function<int(int, int)> travelFn) {
+        depotNode = depotLocation;
+        capacity = bagCapacity;
+        travelTime = move(travelFn);
+    }
+
+    // Splits `pending` into waves leaving at clock minute `now`
+    vector<Wave> plan(const vector<Order>& pending, int now) {
+        stats = Stats();
+        auto start = chrono::steady_clock::now();
+        orders.clear();
+        for (const Order& order : pending) {
+            if (travelTime(depotNode, order.node) >= GRAPH_INF || travelTime(order.node, depotNode) >= GRAPH_INF) {
+                stats.skipped++;
+                continue;
+            }
+            orders.push_back(order);
+        }
+        int n = static_cast<int>(orders.size());
+        stats.orders = n;
+        travel.assign(n + 1, vector<int>(n + 1, 0));
+        gap.assign(n, vector<int>(n, 0));
+        for (int i = 0; i <= n; i++) {
+            int from = i == n ? depotNode : orders[i].node;
+            for (int j = 0; j <= n; j++)
+                if (i != j) travel[i][j] = travelTime(from, j == n ? depotNode : orders[j].node);
+        }
+        for (int i = 0; i < n; i++)
+            for (int j = i + 1; j < n; j++)
+                gap[i][j] = gap[j][i] = travel[i][j] + travel[j][i] + abs(orders[i].windowEnd - orders[j].windowEnd);
+        stats.matrixMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        vector<Wave> waves;
+        vector<int> todo(n);
+        iota(todo.begin(), todo.end(), 0);
+        while (!todo.empty()) {
+            auto phase = chrono::steady_clock::now();
+            vector<vector<int>> clusters = cluster(todo);
+            stats.clusters += static_cast<int>(clusters.size());
+            auto routed = chrono::steady_clock::now();
+            stats.clusterMs += chrono::duration<double, milli>(routed - phase).count();
+            // Every cluster keeps at least one stop, so each pass shrinks todo
+            vector<int> spill;
+            for (auto& members : clusters) {
+                while (true) {
+                    int worst = -1;
+                    Wave wave = buildWave(members, now, worst);
+                    if (wave.onTime || members.size() == 1) {
+                        waves.push_back(wave);
+                        break;
+                    }
+                    spill.push_back(members[worst]);
+                    members.erase(members.begin() + worst);
+                    stats.split++;
+                }
+            }
+            stats.routeMs += chrono::duration<double, milli>(chrono::steady_clock::now() - routed).count();
+            todo.swap(spill);
+        }
+        return waves;
+    }
+
+    // Full bags always leave; on a timer tick, so do waves that cannot wait
+    bool due(const Wave& wave, int now, bool timerTick) const {
+        if (wave.load * 100 >= capacity * WAVE_FULL_PERCENT) return true;
+        if (!timerTick) return false;
+        return !wave.onTime || wave.latestDeparture < now + WAVE_TICK_MINUTES || now - wave.oldestSince >= WAVE_MAX_HOLD_MINUTES;
+    }
+
+    const Stats& lastStats() const { return stats; }
+};
+
+struct WaveReport {
+    int runs = 0;
+    int waves = 0;
+    int orders = 0;
+    int late = 0;
+    long long distance = 0;
+    long long soloDistance = 0; // the same orders as one trip each
+    double clusterMs = 0;
+    double worstClusterMs = 0;
+};
+
+WaveBatcher waveBatcher;
+WaveReport waveReport;
+deque<WaveBatcher::Wave> dispatchedWaves;
+
+// DISPATCH DELIVERY WAVES FUNCTION: Batches open online orders and sends out the waves that are due
+// HOW IT WORKS:
+// 1. Re-cluster every open routable order at the current clock minute
+// 2. Waves that are due (see WaveBatcher::due) go out: their orders move to
+//    "Out for Delivery" with the wave's arrival times as ETAs
+// 3. The rider route plan drops them on the next re-plan
+// TIME COMPLEXITY: O(n²) lookups + clustering (see WaveBatcher)
+// Returns the number of waves sent
+int dispatchDeliveryWaves(bool timerTick) {
+    if (deliveryCSR().nodeCount() == 0) return 0;
+    vector<WaveBatcher::Order> pending;
+    unordered_map<int, int> slotOf;
+    for (int i = 0; i < onlineOrderCount; i++) {
+        const OnlineOrder& order = onlineOrders[i];
+        if (!onlineOrderRoutable(order)) continue;
+        pending.push_back({order.orderId, order.deliveryNode, max(1, order.itemCount), order.windowStart, order.windowEnd, order.placedAt});
+        slotOf[order.orderId] = i;
+    }
+    if (pending.empty()) return 0;
+
+    waveBatcher.reset(RESTAURANT_LOCATION, RIDER_BAG_CAPACITY, deliveryDistance);
+    vector<WaveBatcher::Wave> waves = waveBatcher.plan(pending, deliveryClock);
+    const WaveBatcher::Stats& stats = waveBatcher.lastStats();
+    double ms = stats.matrixMs + stats.clusterMs + stats.routeMs;
+    waveReport.runs++;
+    waveReport.clusterMs += ms;
+    waveReport.worstClusterMs = max(waveReport.worstClusterMs, ms);
+
+    int sent = 0;
+    for (const auto& wave : waves) {
+        if (!waveBatcher.due(wave, deliveryClock, timerTick)) continue;
+        for (size_t k = 0; k < wave.orderIds.size(); k++) {
+            OnlineOrder& order = onlineOrders[slotOf[wave.orderIds[k]]];
+            order.status = "Out for Delivery";
+            order.deliveryTime = wave.arrivals[k];
+            waveReport.soloDistance += static_cast<long long>(deliveryDistance(RESTAURANT_LOCATION, order.deliveryNode)) +
+                                       deliveryDistance(order.deliveryNode, RESTAURANT_LOCATION);
+            if (wave.arrivals[k] > order.windowEnd) waveReport.late++;
+        }
+        waveReport.waves++;
+        waveReport.orders += static_cast<int>(wave.orderIds.size());
+        waveReport.distance += wave.distance;
+        dispatchedWaves.push_back(wave);
+        if (dispatchedWaves.size() > static_cast<size_t>(WAVE_LOG_LIMIT)) dispatchedWaves.pop_front();
+        sent++;
+    }
+    if (sent > 0) {
+        Core::Logger::log(Core::LogLevel::INFO, "Dispatched " + to_string(sent) + " delivery waves at minute " + to_string(deliveryClock) +
+                          " (" + to_string(waves.size() - sent) + " still filling)");
+        if (riderPlanner.stopCount() > 0) planRiderRoutes();
+    }
+    return sent;
+}
+
+// ADVANCE DELIVERY CLOCK FUNCTION: Runs the wave timer forward
+// Every WAVE_TICK_MINUTES: orders whose ETA has passed are marked
+// "Delivered", then due waves are dispatched. Returns the waves sent.
+int advanceDeliveryClock(int minutes) {
+    int sent = 0;
+    for (int elapsed = 0; elapsed < minutes; elapsed += WAVE_TICK_MINUTES) {
+        deliveryClock += min(WAVE_TICK_MINUTES, minutes - elapsed);
+        for (int i = 0; i < onlineOrderCount; i++) {
+            OnlineOrder& order = onlineOrders[i];
+            if (order.status == "Out for Delivery" && order.deliveryTime <= deliveryClock) order.status = "Delivered";
+        }
+        sent += dispatchDeliveryWaves(true);
+    }
+    return sent;
 }
 
-void displayTSPRoute(const vector<int>& route) {
-    cout << "\nOptimal Delivery Route (TSP Approximation):\n";
-    int totalDistance = 0;
-    for (int i = 0; i < (int)route.size() - 1; i++) {
-        int dist = deliveryGraph[route[i]][route[i + 1]];
-        cout << route[i] << " -> " << route[i + 1] << " (Distance: " << dist << ")\n";
-        totalDistance += dist;
+void displayDeliveryWaves() {
+    cout << "\nDelivery Waves (clock: minute " << deliveryClock << ", bag capacity " << RIDER_BAG_CAPACITY << " items):\n";
+    size_t first = dispatchedWaves.size() > 10 ? dispatchedWaves.size() - 10 : 0;
+    for (size_t w = first; w < dispatchedWaves.size(); w++) {
+        const WaveBatcher::Wave& wave = dispatchedWaves[w];
+        cout << "Wave (" << wave.load << " items, distance " << wave.distance << "): ";
+        for (size_t k = 0; k < wave.orderIds.size(); k++)
+            cout << "#" << wave.orderIds[k] << "@" << wave.nodes[k] << " (" << wave.arrivals[k] << " min) -> ";
+        cout << "back\n";
     }
-    cout << "Total Route Distance: " << totalDistance << " units\n";
+    if (waveReport.waves == 0) {
+        cout << "No waves dispatched yet.\n";
+        return;
+    }
+    cout << fixed << setprecision(2);
+    cout << "Waves: " << waveReport.waves << ", orders: " << waveReport.orders << ", stops per trip: "
+         << static_cast<double>(waveReport.orders) / waveReport.waves << "\n";
+    cout << "Distance per order: " << static_cast<double>(waveReport.distance) / waveReport.orders << " units (one trip each: "
+         << static_cast<double>(waveReport.soloDistance) / waveReport.orders << ")\n";
+    cout << "Late deliveries: " << waveReport.late << "\n";
+    cout << "Clustering runtime: " << waveReport.clusterMs / waveReport.runs << " ms avg, " << waveReport.worstClusterMs
+         << " ms worst over " << waveReport.runs << " runs\n";
 }
 
 // =============================================================
@@ -2833,6 +10724,7 @@ public:
         return count;
     }
     
+    // O(C) using maintained per-customer order counts (no order heap scan)
     static double calculateCustomerRetentionRate() {
         if (customerCount == 0) return 0;
         int repeatCustomers = 0;
@@ -2914,8 +10806,12 @@ struct CustomerInsights {
 CustomerInsights generateCustomerInsights(int customerId) {
     CustomerInsights insights = {customerId, 0, 0, 0, "", "", 0, "Low"};
     
-    insights.totalOrders = getCustomerOrderCount(customerId);
-    insights.totalSpent = calculateCustomerLifetimeValue(customerId);
+    const CustomerAggregate* aggregate = getCustomerAggregate(customerId);
+    if (aggregate) {
+        insights.totalOrders = aggregate->orderCount;
+        insights.totalSpent = aggregate->totalSpent;
+        insights.daysSinceLastOrder = static_cast<int>(difftime(time(nullptr), aggregate->lastOrderTime) / 86400);
+    }
     if (insights.totalOrders > 0) {
         insights.averageOrderValue = insights.totalSpent / insights.totalOrders;
     }
@@ -2937,6 +10833,7 @@ void displayCustomerInsights(int customerId) {
     cout << "Total Orders: " << insights.totalOrders << "\n";
     cout << "Total Spent: $" << fixed << setprecision(2) << insights.totalSpent << "\n";
     cout << "Average Order Value: $" << insights.averageOrderValue << "\n";
+    cout << "Days Since Last Order: " << insights.daysSinceLastOrder << "\n";
     cout << "Churn Risk: " << insights.riskOfChurn << "\n";
 }
 
@@ -3145,6 +11042,240 @@ void displayAuditTrail(int limit = 20) {
     }
 }
 
+// =============================================================
+// FULL-TEXT SEARCH SERVICE (FM-Index over free-text fields)
+// =============================================================
+
+enum class TextSource { CUSTOMER_NAME, MENU_ITEM_NAME, FEEDBACK_COMMENT, AUDIT_DETAIL };
+
+inline string textSourceToString(TextSource source) {
+    switch (source) {
+        case TextSource::CUSTOMER_NAME: return "Customer";
+        case TextSource::MENU_ITEM_NAME: return "Menu";
+        case TextSource::FEEDBACK_COMMENT: return "Feedback";
+        case TextSource::AUDIT_DETAIL: return "Audit";
+        default: return "Unknown";
+    }
+}
+
+struct FullTextHit {
+    TextSource source;
+    int recordIndex; // slot in the source array
+    int offset;      // character offset inside the field
+};
+
+// Index segments are immutable once built. New records go into a small
+// delta segment rebuilt synchronously; once the delta grows past a
+// threshold, a merged main segment is built on a background thread and
+// swapped in when ready, so queries never wait for a full rebuild.
+class FullTextSearchService {
+private:
+    struct DocRef {
+        TextSource source;
+        int recordIndex;
+    };
+    struct Segment {
+        DataStructures::FMIndex fm;
+        vector<int> docStarts;   // text offset of each document
+        vector<DocRef> docs;
+    };
+    static const int SOURCE_COUNT = 4;
+    static const int DELTA_MERGE_THRESHOLD = 1024;
+
+    shared_ptr<const Segment> mainSegment;
+    shared_ptr<const Segment> deltaSegment;
+    vector<DocRef> allDocs;          // every indexed document, in order
+    vector<string> allTexts;
+    size_t mainDocCount = 0;         // prefix of allDocs covered by mainSegment
+    int indexedCount[SOURCE_COUNT] = {0, 0, 0, 0};
+
+    thread builder;
+    mutex swapMutex;
+    shared_ptr<const Segment> pendingMain; // finished background build
+    size_t pendingDocCount = 0;
+    atomic<bool> building{false};
+    atomic<int> rebuilds{0};
+
+    static string normalize(const string& s) {
+        string out;
+        out.reserve(s.size());
+        for (char c : s) {
+            if (c == '\0' || c == '\x01') continue;
+            out += static_cast<char>(tolower(static_cast<unsigned char>(c)));
+        }
+        return out;
+    }
+
+    static shared_ptr<const Segment> buildSegment(const vector<DocRef>& docs, const vector<string>& texts,
+                                                  size_t from, size_t to) {
+        auto seg = make_shared<Segment>();
+        string corpus;
+        for (size_t i = from; i < to; i++) {
+            seg->docStarts.push_back(static_cast<int>(corpus.size()));
+            seg->docs.push_back(docs[i]);
+            corpus += texts[i];
+            corpus += '\x01'; // document separator keeps matches inside one field
+        }
+        seg->fm.build(corpus);
+        return seg;
+    }
+
+    static void collectHits(const Segment* seg, const string& pattern, int limit, vector<FullTextHit>& out) {
+        if (!seg) return;
+        for (int pos : seg->fm.locate(pattern, limit)) {
+            size_t d = upper_bound(seg->docStarts.begin(), seg->docStarts.end(), pos) - seg->docStarts.begin() - 1;
+            out.push_back({seg->docs[d].source, seg->docs[d].recordIndex, pos - seg->docStarts[d]});
+        }
+    }
+
+    void appendSource(TextSource source, int total, const function<string(int)>& field) {
+        int& done = indexedCount[static_cast<int>(source)];
+        for (; done < total; done++) {
+            allDocs.push_back({source, done});
+            allTexts.push_back(normalize(field(done)));
+        }
+    }
+
+    void startBackgroundMerge() {
+        if (builder.joinable()) builder.join();
+        building = true;
+        size_t count = allDocs.size();
+        builder = thread([this, docs = allDocs, texts = allTexts, count]() {
+            auto seg = buildSegment(docs, texts, 0, count);
+            lock_guard<mutex> lock(swapMutex);
+            pendingMain = seg;
+            pendingDocCount = count;
+            building = false;
+            rebuilds++;
+        });
+    }
+
+public:
+    ~FullTextSearchService() {
+        if (builder.joinable()) builder.join();
+    }
+
+    // Forces a full re-index on next refresh (e.g. after restoring customers from backup)
+    void invalidate() {
+        if (builder.joinable()) builder.join();
+        mainSegment.reset();
+        deltaSegment.reset();
+        pendingMain.reset();
+        allDocs.clear();
+        allTexts.clear();
+        mainDocCount = 0;
+        for (int& c : indexedCount) c = 0;
+    }
+
+    // REFRESH FUNCTION: Brings the index up to date with the live record arrays
+    // HOW IT WORKS:
+    // 1. Adopt a finished background build as the new main segment
+    // 2. Append records added since the last refresh (sources are append-only)
+    // 3. Rebuild the small delta segment over documents not in main
+    // 4. If the delta is large, merge everything on a background thread
+    // TIME COMPLEXITY: O(delta log delta) on the caller; full merges off-thread
+    void refresh(int customers, const function<string(int)>& customerName,
+                 int menuCount, const function<string(int)>& menuName,
+                 int feedbackTotal, const function<string(int)>& feedbackComment,
+                 int auditTotal, const function<string(int)>& auditDetail) {
+        bool changed = false;
+        {
+            lock_guard<mutex> lock(swapMutex);
+            if (pendingMain) {
+                mainSegment = pendingMain;
+                mainDocCount = pendingDocCount;
+                pendingMain.reset();
+                changed = true;
+            }
+        }
+        size_t before = allDocs.size();
+        appendSource(TextSource::CUSTOMER_NAME, customers, customerName);
+        appendSource(TextSource::MENU_ITEM_NAME, menuCount, menuName);
+        appendSource(TextSource::FEEDBACK_COMMENT, feedbackTotal, feedbackComment);
+        appendSource(TextSource::AUDIT_DETAIL, auditTotal, auditDetail);
+        changed = changed || allDocs.size() != before;
+        if (!changed) return;
+
+        size_t deltaDocs = allDocs.size() - mainDocCount;
+        deltaSegment = deltaDocs ? buildSegment(allDocs, allTexts, mainDocCount, allDocs.size()) : nullptr;
+        if (deltaDocs > DELTA_MERGE_THRESHOLD && !building) startBackgroundMerge();
+    }
+
+    // Waits for any in-flight background merge (used by benchmarks and shutdown)
+    void waitForMerge() {
+        if (builder.joinable()) builder.join();
+    }
+
+    // COUNT FUNCTION: Total substring occurrences across all indexed fields
+    // TIME COMPLEXITY: O(m) per segment
+    int count(const string& pattern) const {
+        string p = normalize(pattern);
+        if (p.empty()) return 0;
+        int total = mainSegment ? mainSegment->fm.count(p) : 0;
+        if (deltaSegment) total += deltaSegment->fm.count(p);
+        return total;
+    }
+
+    // SEARCH FUNCTION: Field-level locations of up to limit occurrences
+    vector<FullTextHit> search(const string& pattern, int limit) const {
+        vector<FullTextHit> hits;
+        string p = normalize(pattern);
+        if (p.empty()) return hits;
+        collectHits(mainSegment.get(), p, limit, hits);
+        if (static_cast<int>(hits.size()) < limit) {
+            collectHits(deltaSegment.get(), p, limit - static_cast<int>(hits.size()), hits);
+        }
+        return hits;
+    }
+
+    int documentCount() const { return static_cast<int>(allDocs.size()); }
+    int backgroundRebuilds() const { return rebuilds; }
+    bool mergeInProgress() const { return building; }
+};
+
+FullTextSearchService fullTextIndex;
+
+void refreshFullTextIndex() {
+    static int indexedEpoch = 0;
+    if (indexedEpoch != customerDataEpoch) {
+        fullTextIndex.invalidate();
+        indexedEpoch = customerDataEpoch;
+    }
+    fullTextIndex.refresh(
+        customerCount, [](int i) { return customerRecords[i].name; },
+        menuItemCount, [](int i) { return menuItems[i].name; },
+        feedbackCount, [](int i) { return feedbackRecords[i].comments; },
+        auditCount, [](int i) { return auditTrail[i].details; });
+}
+
+// FULL-TEXT SEARCH FUNCTION: Finds a substring anywhere in names, comments and audit details
+// ALGORITHM: FM-index backward search (replaces ad-hoc KMP/Rabin-Karp scans)
+// TIME COMPLEXITY: O(m + occurrences) after an incremental refresh
+vector<FullTextHit> fullTextSearch(const string& pattern, int limit = 50) {
+    refreshFullTextIndex();
+    return fullTextIndex.search(pattern, limit);
+}
+
+int fullTextCount(const string& pattern) {
+    refreshFullTextIndex();
+    return fullTextIndex.count(pattern);
+}
+
+void displayFullTextSearch(const string& pattern) {
+    auto hits = fullTextSearch(pattern);
+    cout << "\n=== FULL-TEXT SEARCH: \"" << pattern << "\" (" << fullTextCount(pattern) << " occurrences) ===\n";
+    for (const auto& h : hits) {
+        cout << textSourceToString(h.source) << " #" << h.recordIndex << " @" << h.offset << ": ";
+        switch (h.source) {
+            case TextSource::CUSTOMER_NAME: cout << customerRecords[h.recordIndex].name; break;
+            case TextSource::MENU_ITEM_NAME: cout << menuItems[h.recordIndex].name; break;
+            case TextSource::FEEDBACK_COMMENT: cout << feedbackRecords[h.recordIndex].comments; break;
+            case TextSource::AUDIT_DETAIL: cout << auditTrail[h.recordIndex].details; break;
+        }
+        cout << "\n";
+    }
+}
+
 // =============================================================
 // MENU RECOMMENDATION ENGINE
 // =============================================================
@@ -3216,9 +11347,10 @@ void mainMenu() {
         cout << "12. Algorithm Demos\n";
         cout << "13. Run System Demo (Auto)\n";
         cout << "14. View Complete System Data\n";
+        cout << "15. Performance Benchmarks\n";
         cout << "0. Exit\n";
 
-        int choice = readInt("Select an option: ", 0, 14);
+        int choice = readInt("Select an option: ", 0, 15);
         switch (choice) {
             case 1: customerMenu(); break;
             case 2: menuManagementMenu(); break;
@@ -3234,6 +11366,7 @@ void mainMenu() {
             case 12: algorithmDemoMenu(); break;
             case 13: runSystemDemo(); break;
             case 14: displayCompleteSystemData(); break;
+            case 15: benchmarkMenu(); break;
             case 0:
                 cout << "Exiting system. Goodbye!\n";
                 return;
@@ -3247,8 +11380,13 @@ void customerMenu() {
         cout << "1. Add Customer\n";
         cout << "2. Search Customer by ID\n";
         cout << "3. List Customers (Inorder)\n";
+        cout << "4. Autocomplete by Name\n";
+        cout << "5. Fuzzy Search (name/email)\n";
+        cout << "6. Sounds-like Search\n";
+        cout << "7. Loyalty Statement\n";
+        cout << "8. Redeem Loyalty Points\n";
         cout << "0. Back\n";
-        int ch = readInt("Choose: ", 0, 3);
+        int ch = readInt("Choose: ", 0, 8);
         if (ch == 0) return;
         if (ch == 1) {
             string name = readLine("Name: ");
@@ -3262,8 +11400,9 @@ void customerMenu() {
                 cout << "Customer storage full.\n"; continue;
             }
             int id = customerCount + 1;
-            customerRecords[customerCount++] = {id, name, phone, email, 0, "Bronze"};
+            customerRecords[customerCount++] = {id, name, phone, email, 0, Domain::MembershipTierLevel::BRONZE};
             customerBST = insertAVL(customerBST, id, name);
+            indexCustomer(customerCount - 1);
             cout << "Added customer with ID: " << id << "\n";
         } else if (ch == 2) {
             int id = readInt("Enter Customer ID: ", 1, 1000000);
@@ -3273,6 +11412,28 @@ void customerMenu() {
         } else if (ch == 3) {
             cout << "Customers (Inorder): ";
             inorderBST(customerBST); cout << "\n";
+        } else if (ch == 4) {
+            string prefix = readLine("Name prefix: ");
+            auto hits = autocompleteCustomers(prefix, 5);
+            if (hits.empty()) cout << "No matches.\n";
+            for (auto& c : hits) cout << c.id << ": " << c.name << " (" << c.loyaltyPoints << " pts)\n";
+        } else if (ch == 5) {
+            string type = readLine("Search by (name/email): ");
+            string query = readLine("Query: ");
+            auto hits = searchCustomers(query, type == "email" ? "email" : "name");
+            if (hits.empty()) cout << "No matches.\n";
+            for (auto& c : hits) cout << c.id << ": " << c.name << " <" << c.email << ">\n";
+        } else if (ch == 6) {
+            auto hits = searchCustomersBySound(readLine("Name as heard: "));
+            if (hits.empty()) cout << "No matches.\n";
+            for (auto& c : hits) cout << c.id << ": " << c.name << "\n";
+        } else if (ch == 7) {
+            displayLoyaltyStatement(readInt("Enter Customer ID: ", 1, 1000000));
+        } else if (ch == 8) {
+            int id = readInt("Enter Customer ID: ", 1, 1000000);
+            int points = readInt("Points to redeem: ", 1, 1000000);
+            if (redeemLoyaltyPoints(id, points, "Redeemed at counter")) cout << "Redeemed " << points << " points.\n";
+            else cout << "Redemption failed (unknown customer or insufficient balance).\n";
         }
     }
 }
@@ -3283,8 +11444,9 @@ void menuManagementMenu() {
         cout << "1. Add Menu Item\n";
         cout << "2. List Menu Items\n";
         cout << "3. Toggle Item Availability\n";
+        cout << "4. Autocomplete Item Name\n";
         cout << "0. Back\n";
-        int ch = readInt("Choose: ", 0, 3);
+        int ch = readInt("Choose: ", 0, 4);
         if (ch == 0) return;
         if (ch == 1) {
             if (menuItemCount >= MAX_MENU_ITEMS) { cout << "Menu full.\n"; continue; }
@@ -3297,6 +11459,7 @@ void menuManagementMenu() {
                 cout << "Invalid menu item details.\n"; continue;
             }
             menuItems[menuItemCount++] = {id, name, category, price, prep, true};
+            indexMenuItem(menuItemCount - 1);
             cout << "Added item with ID: " << id << "\n";
         } else if (ch == 2) {
             cout << left << setw(5) << "ID" << setw(22) << "Name" << setw(14) << "Category"
@@ -3315,6 +11478,11 @@ void menuManagementMenu() {
                 break;
             }
             if (!found) cout << "Item not found.\n";
+        } else if (ch == 4) {
+            string prefix = readLine("Item prefix: ");
+            auto hits = autocompleteMenuItems(prefix, 5);
+            if (hits.empty()) cout << "No matches.\n";
+            for (auto& m : hits) cout << m.id << ": " << m.name << " (ordered " << menuPopularity[m.name] << "x)\n";
         }
     }
 }
@@ -3368,8 +11536,10 @@ void tableReservationMenu() {
         cout << "2. Show Occupancy\n";
         cout << "3. Add to Waitlist\n";
         cout << "4. Assign From Waitlist\n";
+        cout << "5. Add to Waitlist by Name (phone-in)\n";
+        cout << "6. Book Reservation by Name (phone-in)\n";
         cout << "0. Back\n";
-        int ch = readInt("Choose: ", 0, 4);
+        int ch = readInt("Choose: ", 0, 6);
         if (ch == 0) return;
         if (ch == 1) { initializeTables(); cout << "Tables initialized.\n"; }
         else if (ch == 2) {
@@ -3381,6 +11551,24 @@ void tableReservationMenu() {
             addToWaitlist(cid, party);
         } else if (ch == 4) {
             if (!assignTableFromWaitlist()) cout << "No table available.\n";
+        } else if (ch == 5) {
+            string name = readLine("Caller name: ");
+            int party = readInt("Party size: ", 1, 10);
+            addToWaitlistByName(name, party);
+        } else if (ch == 6) {
+            string name = readLine("Caller name: ");
+            int table = readInt("Table number: ", 0, MAX_TABLES - 1);
+            int guests = readInt("Guests: ", 1, 10);
+            string date = readLine("Date (YYYY-MM-DD): ");
+            string time = readLine("Time (HH:MM): ");
+            if (!ValidationEngine::validateReservationData(table, guests, date)) {
+                cout << "Invalid reservation details.\n";
+                continue;
+            }
+            int id = bookPhoneReservation(name, table, guests, date, time);
+            if (id == 0) cout << "Reservation book is full.\n";
+            else if (reservations[id - 1].customerId == 0) cout << "Reservation " << id << " booked; no unique customer matches \"" << name << "\".\n";
+            else cout << "Reservation " << id << " booked for customer " << reservations[id - 1].customerId << ".\n";
         }
     }
 }
@@ -3389,10 +11577,12 @@ void billingMenu() {
     while (true) {
         cout << "\n--- BILLING ---\n";
         cout << "1. Show Bills Pending\n";
+        cout << "2. Settle Pending Bills\n";
         cout << "0. Back\n";
-        int ch = readInt("Choose: ", 0, 1);
+        int ch = readInt("Choose: ", 0, 2);
         if (ch == 0) return;
         if (ch == 1) cout << "Bills in queue: " << billSize << "\n";
+        else if (ch == 2) cout << "Settled " << settlePendingBills() << " bills.\n";
     }
 }
 
@@ -3401,11 +11591,13 @@ void salesAnalysisMenu() {
         cout << "\n--- SALES ANALYSIS ---\n";
         cout << "1. Daily Report\n";
         cout << "2. Metrics Summary\n";
+        cout << "3. Leaderboards\n";
         cout << "0. Back\n";
-        int ch = readInt("Choose: ", 0, 2);
+        int ch = readInt("Choose: ", 0, 3);
         if (ch == 0) return;
         if (ch == 1) { auto r = generateDailyReport(); displayAnalyticsReport(r); }
         else if (ch == 2) { MetricsEngine::displayMetricsSummary(); }
+        else if (ch == 3) { displayLeaderboards(); }
     }
 }
 
@@ -3431,10 +11623,67 @@ void inventoryMenu() {
 void onlineOrderMenu() {
     while (true) {
         cout << "\n--- ONLINE ORDER MANAGEMENT ---\n";
-        cout << "(Placeholder) Features coming soon.\n";
+        cout << "1. Place Online Order\n";
+        cout << "2. View Online Orders\n";
+        cout << "3. Re-plan Rider Routes\n";
+        cout << "4. View Rider Routes\n";
+        cout << "5. Assign Returning Riders\n";
+        cout << "6. Advance Dispatch Clock (wave timer)\n";
+        cout << "7. View Delivery Waves\n";
         cout << "0. Back\n";
-        int ch = readInt("Choose: ", 0, 0);
+        int ch = readInt("Choose: ", 0, 7);
         if (ch == 0) return;
+        if (ch == 1) {
+            int cid = readInt("Customer ID: ", 1, 1000000);
+            string address = readLine("Delivery address: ");
+            int count = readInt("Number of items (1-20): ", 1, 20);
+            vector<string> items;
+            for (int i = 0; i < count; i++) items.push_back(readLine("Item " + to_string(i + 1) + ": "));
+            double total = readFloat("Total amount: ", 0, 1000000);
+            int node = -1;
+            int locations = deliveryCSR().nodeCount();
+            if (locations > 0) node = readInt("Delivery location (0-" + to_string(locations - 1) + "): ", 0, locations - 1);
+            else cout << "No delivery network loaded; order will not be routed.\n";
+            int earliest = readInt("Deliver no earlier than (minutes from now): ", 0, 1440);
+            int latest = readInt("Promised by (minutes from now): ", earliest, 1440);
+            if (placeOnlineOrder(cid, address, items, total, node, earliest, latest)) cout << "Order placed.\n";
+            else cout << "Order not placed: list full or location outside the delivery zone (see log).\n";
+        } else if (ch == 2) {
+            cout << "\nID | Customer | Location | Window | ETA | Status | Total\n";
+            for (int i = 0; i < onlineOrderCount; i++) {
+                const OnlineOrder& o = onlineOrders[i];
+                cout << o.orderId << " | " << o.customerId << " | " << o.deliveryNode << " | " << o.windowStart << "-" << o.windowEnd
+                     << " | " << (o.deliveryTime >= 0 ? to_string(o.deliveryTime) + " min" : string("-")) << " | " << o.status
+                     << " | $" << fixed << setprecision(2) << o.totalAmount << "\n";
+            }
+        } else if (ch == 3) {
+            planRiderRoutes();
+            displayRiderRoutes();
+        } else if (ch == 4) {
+            displayRiderRoutes();
+        } else if (ch == 5) {
+            int locations = deliveryCSR().nodeCount();
+            if (locations == 0) {
+                cout << "No delivery network loaded.\n";
+                continue;
+            }
+            int count = readInt("Riders back at once: ", 1, 100);
+            vector<RiderPosition> riders;
+            for (int i = 0; i < count; i++) {
+                int id = readInt("Rider ID: ", 1, 1000000);
+                int node = readInt("Rider location: ", 0, locations - 1);
+                riders.push_back({id, node});
+            }
+            auto assignment = assignReturningRiders(riders);
+            if (assignment.empty()) cout << "No waiting orders to assign.\n";
+            for (const auto& a : assignment) cout << "Rider " << a.first << " -> order #" << a.second << "\n";
+        } else if (ch == 6) {
+            int minutes = readInt("Minutes to advance: ", 1, 1440);
+            int sent = advanceDeliveryClock(minutes);
+            cout << "Clock at minute " << deliveryClock << "; " << sent << " waves dispatched.\n";
+        } else if (ch == 7) {
+            displayDeliveryWaves();
+        }
     }
 }
 
@@ -3453,8 +11702,9 @@ void feedbackMenu() {
         cout << "\n--- FEEDBACK ---\n";
         cout << "1. Add Feedback\n";
         cout << "2. Analytics\n";
+        cout << "3. Full-Text Search (names, comments, audit)\n";
         cout << "0. Back\n";
-        int ch = readInt("Choose: ", 0, 2);
+        int ch = readInt("Choose: ", 0, 3);
         if (ch == 0) return;
         if (ch == 1) {
             if (feedbackCount >= MAX_FEEDBACK) { cout << "Feedback full.\n"; continue; }
@@ -3469,6 +11719,8 @@ void feedbackMenu() {
             cout << "Feedback recorded.\n";
         } else if (ch == 2) {
             displayFeedbackAnalytics();
+        } else if (ch == 3) {
+            System::displayFullTextSearch(readLine("Search text: "));
         }
     }
 }
@@ -3483,8 +11735,25 @@ void algorithmDemoMenu() {
         cout << "5. Dijkstra (optimized) from 0\n";
         cout << "6. Prim's MST (optimized)\n";
         cout << "7. TSP Approx Route from 0\n";
+        cout << "8. Generate Large Road Network (CSR)\n";
+        cout << "9. Shortest Route Between Two Locations\n";
+        cout << "10. Delivery ETA Distance (ALT A*)\n";
+        cout << "11. Delivery ETA Distance (Contraction Hierarchy)\n";
+        cout << "12. All-Pairs Distance Table\n";
+        cout << "13. Load Road Network File (DIMACS .gr / edge list)\n";
+        cout << "14. Update Road Travel Time (traffic)\n";
+        cout << "15. Connected Components / Reachability\n";
+        cout << "16. Kruskal's MST (union-find)\n";
+        cout << "17. Boruvka's MST (parallel)\n";
+        cout << "18. Route Cache Statistics\n";
+        cout << "19. Nearest Locations & Riders (coordinates)\n";
+        cout << "20. Rider Location Update\n";
+        cout << "21. Load Coordinates File (DIMACS .co)\n";
+        cout << "22. Delivery Zones (isochrones)\n";
+        cout << "23. Set Delivery Radius\n";
+        cout << "24. Rebuild Contraction Hierarchy\n";
         cout << "0. Back\n";
-        int ch = readInt("Choose: ", 0, 7);
+        int ch = readInt("Choose: ", 0, 24);
         if (ch == 0) return;
         if (ch == 1) {
             initDeliveryGraph(6);
@@ -3507,6 +11776,153 @@ void algorithmDemoMenu() {
         } else if (ch == 7) {
             auto route = tspApproximation(0, locationCount);
             displayTSPRoute(route);
+        } else if (ch == 8) {
+            int nodes = readInt("Number of locations (e.g. 1000000): ", 2, 10000000);
+            installDeliveryNetwork(generateRoadNetwork(nodes, 42));
+            const DataStructures::CSRGraph& g = deliveryCSR();
+            cout << "Road network ready: " << g.nodeCount() << " locations, " << g.arcCount() / 2 << " roads.\n";
+        } else if (ch == 9) {
+            int last = max(0, deliveryCSR().nodeCount() - 1);
+            int src = readInt("From location: ", 0, last);
+            int dst = readInt("To location: ", 0, last);
+            int distance = GRAPH_INF;
+            auto route = shortestDeliveryRoute(src, dst, &distance);
+            if (route.empty()) {
+                cout << "No route between " << src << " and " << dst << ".\n";
+            } else {
+                cout << "Distance: " << distance << " units over " << route.size() - 1 << " roads\n";
+                for (size_t i = 0; i < route.size() && i < static_cast<size_t>(DELIVERY_PRINT_LIMIT); i++) cout << route[i] << (i + 1 < route.size() ? " -> " : "\n");
+                if (route.size() > static_cast<size_t>(DELIVERY_PRINT_LIMIT)) cout << "... -> " << dst << "\n";
+                cout << "Locations settled: " << deliveryRoutingEngine().settled() << "\n";
+            }
+        } else if (ch == 10) {
+            int last = max(0, deliveryCSR().nodeCount() - 1);
+            int src = readInt("Restaurant location: ", 0, last);
+            int dst = readInt("Customer location: ", 0, last);
+            int distance = deliveryDistanceALT(src, dst);
+            if (distance == GRAPH_INF) cout << "Customer location is unreachable.\n";
+            else cout << "ETA distance: " << distance << " units (" << deliveryLandmarkRouter().settled()
+                      << " locations settled, " << deliveryLandmarkRouter().landmarkNodes().size() << " landmarks)\n";
+        } else if (ch == 11) {
+            int last = max(0, deliveryCSR().nodeCount() - 1);
+            int src = readInt("Restaurant location: ", 0, last);
+            int dst = readInt("Customer location: ", 0, last);
+            vector<int> route;
+            int distance = deliveryDistanceCH(src, dst, &route);
+            if (distance == GRAPH_INF) cout << "Customer location is unreachable.\n";
+            else if (ContractionHierarchy* current = currentDeliveryHierarchy())
+                cout << "ETA distance: " << distance << " units over " << route.size() - 1 << " roads ("
+                     << current->settled() << " hierarchy nodes settled)\n";
+            else cout << "ETA distance: " << distance << " units over " << route.size() - 1 << " roads (ALT fallback, "
+                      << deliveryLandmarkRouter().settled() << " locations settled; hierarchy out of date, see option 24)\n";
+        } else if (ch == 12) {
+            const AllPairsDistances* table = deliveryDistanceTable();
+            if (!table) {
+                cout << "Network too large for the all-pairs table (limit " << APSP_MAX_NODES << " locations).\n";
+                continue;
+            }
+            const DataStructures::DistanceMatrix& m = table->table();
+            cout << "All-pairs table: " << m.size() << " locations via " << table->method() << ", "
+                 << (m.isNarrow() ? 16 : 32) << "-bit cells, " << m.bytes() / 1024 << " KB\n";
+            if (m.size() <= MAX_LOCATIONS) {
+                for (int i = 0; i < m.size(); i++) {
+                    for (int j = 0; j < m.size(); j++) {
+                        if (m.get(i, j) == GRAPH_INF) cout << setw(6) << "-" << " ";
+                        else cout << setw(6) << m.get(i, j) << " ";
+                    }
+                    cout << "\n";
+                }
+            } else {
+                int src = readInt("From location: ", 0, m.size() - 1);
+                int dst = readInt("To location: ", 0, m.size() - 1);
+                int distance = table->distance(src, dst);
+                if (distance == GRAPH_INF) cout << "No route between " << src << " and " << dst << ".\n";
+                else cout << "Distance: " << distance << " units\n";
+            }
+        } else if (ch == 13) {
+            string path = readLine("Road file path: ");
+            RoadLoadStats stats;
+            if (!loadRoadNetwork(path, RoadFileFormat::AUTO, true, &stats)) {
+                cout << "Could not load " << path << " (see log).\n";
+                continue;
+            }
+            cout << "Road network ready: " << stats.nodes << " locations, " << stats.arcs << " arcs";
+            if (stats.fromCache) cout << " (from cache in " << stats.cacheMs << " ms)\n";
+            else cout << " (" << (stats.format == RoadFileFormat::DIMACS ? "DIMACS" : "edge list") << ", parsed in "
+                      << stats.parseMs << " ms, built in " << stats.buildMs << " ms)\n";
+            if (stats.badRecords > 0) cout << stats.badRecords << " malformed lines skipped.\n";
+        } else if (ch == 14) {
+            int last = max(0, deliveryCSR().nodeCount() - 1);
+            int u = readInt("Road from location: ", 0, last);
+            int v = readInt("Road to location: ", 0, last);
+            int w = readInt("New travel cost: ", 0, 1000000);
+            if (!updateDeliveryEdgeWeight(u, v, w)) {
+                cout << "No road between " << u << " and " << v << ".\n";
+                continue;
+            }
+            const DynamicShortestPaths& tree = kitchenDistanceTree();
+            cout << "Road updated; " << tree.touchedLastUpdate() << " locations re-settled. Distance from kitchen to " << v << ": ";
+            if (tree.distance(v) == GRAPH_INF) cout << "unreachable\n";
+            else cout << tree.distance(v) << " units\n";
+        } else if (ch == 15) {
+            displayDeliveryComponents();
+            int last = max(0, deliveryCSR().nodeCount() - 1);
+            int u = readInt("From location: ", 0, last);
+            int v = readInt("To location: ", 0, last);
+            cout << "Location " << v << (deliveryReachable(u, v) ? " can" : " cannot") << " be reached from location " << u << ".\n";
+        } else if (ch == 16) {
+            kruskalMST(false);
+        } else if (ch == 17) {
+            kruskalMST(true);
+        } else if (ch == 18) {
+            displayRouteCacheStats();
+        } else if (ch == 19) {
+            if (deliveryCSR().nodeCount() == 0) {
+                cout << "No delivery network loaded.\n";
+                continue;
+            }
+            DataStructures::GeoPoint at;
+            at.x = readInt("X: ", -2000000000, 2000000000);
+            at.y = readInt("Y: ", -2000000000, 2000000000);
+            cout << "Nearest locations:\n";
+            for (const auto& hit : nearestDeliveryLocations(at, 3))
+                cout << "  Location " << hit.first << " at distance " << fixed << setprecision(2) << hit.second << "\n";
+            auto riders = nearestRiders(at, 3);
+            if (riders.empty()) cout << "No rider positions reported yet.\n";
+            for (const auto& hit : riders)
+                cout << "  Rider " << hit.first << " at distance " << fixed << setprecision(2) << hit.second << "\n";
+        } else if (ch == 20) {
+            int id = readInt("Rider ID: ", 1, 1000000);
+            DataStructures::GeoPoint at;
+            at.x = readInt("X: ", -2000000000, 2000000000);
+            at.y = readInt("Y: ", -2000000000, 2000000000);
+            updateRiderLocations({{id, at}});
+            cout << "Rider " << id << " is nearest to location " << nearestDeliveryLocation(at) << ".\n";
+        } else if (ch == 21) {
+            string path = readLine("Coordinate file path: ");
+            if (!loadRoadCoordinates(path)) cout << "Could not load " << path << " (see log).\n";
+            else cout << "Coordinates ready for " << deliveryCSR().nodeCount() << " locations.\n";
+        } else if (ch == 22) {
+            if (deliveryCSR().nodeCount() == 0) {
+                cout << "No delivery network loaded.\n";
+                continue;
+            }
+            displayDeliveryZones();
+            int v = readInt("Check location: ", 0, deliveryCSR().nodeCount() - 1);
+            const IsochroneService& zones = deliveryZoneService();
+            if (!zones.deliverable(v)) cout << "Location " << v << " is outside the delivery zone.\n";
+            else cout << "Location " << v << " is " << zones.minutesTo(v) << " min from the nearest kitchen (within "
+                      << zones.bandLimits()[zones.bandOf(v)] << " min zone).\n";
+        } else if (ch == 23) {
+            setDeliveryRadius(readInt("Delivery radius (minutes): ", 3, 1000000));
+            cout << "Delivery radius set to " << deliveryZoneBands.back() << " minutes.\n";
+        } else if (ch == 24) {
+            auto start = chrono::steady_clock::now();
+            bool built = rebuildDeliveryHierarchy(deliveryHierarchyFile);
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            if (!built) cout << "No hierarchy for this network (it has one-way roads); ETA quotes use ALT.\n";
+            else cout << "Hierarchy ready in " << fixed << setprecision(1) << ms << " ms: " << deliveryCH.shortcutCount()
+                      << " shortcuts" << (deliveryHierarchyFile.empty() ? "" : ", cached in " + deliveryHierarchyFile) << "\n";
         }
     }
 }
@@ -3546,9 +11962,10 @@ void demoCustomerManagement() {
             "99988877" + to_string(randInt(10,99)),
             "demo" + to_string(id) + "@mail.com",
             randInt(100, 2000),
-            "Bronze"
+            Domain::MembershipTierLevel::BRONZE
         };
         customerBST = insertAVL(customerBST, id, customerRecords[customerCount-1].name);
+        indexCustomer(customerCount - 1);
     }
     cout << "✔ Added 3 customers to AVL tree\n";
 }
@@ -3564,6 +11981,7 @@ void demoMenuManagement() {
             randInt(5, 15),
             true
         };
+        indexMenuItem(menuItemCount - 1);
     }
     cout << "✔ Added 4 menu items\n";
 }
@@ -3581,8 +11999,7 @@ void demoOrderManagement() {
         o.status = Domain::OrderState::CREATED;
         o.orderTime = time(nullptr);
 
-        orderHeap[orderHeapSize++] = o;
-        orderHeapifyUp(orderHeapSize - 1);
+        placeOrder(o);
 
         enqueueKitchen(o.orderId, o.items[0], o.tableNumber, 10);
     }
@@ -3692,6 +12109,1342 @@ void runSystemDemo() {
     cin.get();
 }
 
+// =============================================================
+// PERFORMANCE BENCHMARKS (synthetic data, fixed seeds)
+// =============================================================
+
+using BenchClock = chrono::steady_clock;
+
+double elapsedMs(BenchClock::time_point start) {
+    return chrono::duration<double, milli>(BenchClock::now() - start).count();
+}
+
+// Builds pronounceable synthetic names like "Karo Tenvila" for index benchmarks
+string syntheticName(mt19937& gen) {
+    static const char* syllables[] = {"ka", "ro", "ten", "vi", "la", "mar", "jo", "an", "sa", "rah",
+                                      "li", "no", "be", "th", "dan", "el", "mi", "ra", "su", "zo"};
+    uniform_int_distribution<int> syl(0, 19), len(2, 4);
+    string name;
+    for (int part = 0; part < 2; part++) {
+        string word;
+        int n = len(gen);
+        for (int i = 0; i < n; i++) word += syllables[syl(gen)];
+        word[0] = static_cast<char>(toupper(word[0]));
+        name += (part ? " " : "") + word;
+    }
+    return name;
+}
+
+// AUTOCOMPLETE BENCHMARK: Radix trie build and top-k query latency at scale
+void benchmarkAutocomplete(int n) {
+    mt19937 gen(42);
+    vector<string> names(n);
+    for (int i = 0; i < n; i++) names[i] = syntheticName(gen);
+
+    DataStructures::RadixTrie trie;
+    uniform_int_distribution<int> points(0, 10000);
+    auto start = BenchClock::now();
+    for (int i = 0; i < n; i++) trie.insert(names[i], i + 1, points(gen));
+    double buildMs = elapsedMs(start);
+
+    const int queries = 10000;
+    uniform_int_distribution<int> pick(0, n - 1), plen(1, 4);
+    double worstUs = 0;
+    long long returned = 0;
+    start = BenchClock::now();
+    for (int q = 0; q < queries; q++) {
+        const string& name = names[pick(gen)];
+        auto t0 = BenchClock::now();
+        returned += trie.topK(name.substr(0, plen(gen)), 10, AUTOCOMPLETE_NODE_BUDGET).size();
+        worstUs = max(worstUs, elapsedMs(t0) * 1000);
+    }
+    double queryMs = elapsedMs(start);
+
+    cout << "\n=== AUTOCOMPLETE BENCHMARK (" << n << " names) ===\n";
+    cout << fixed << setprecision(2);
+    cout << "Build: " << buildMs << " ms (" << (buildMs * 1000 / n) << " us/insert)\n";
+    cout << "Top-10 query: " << (queryMs * 1000 / queries) << " us avg, " << worstUs << " us worst\n";
+    cout << "Avg results/query: " << (double)returned / queries << "\n";
+}
+
+// FUZZY SEARCH BENCHMARK: SymSpell index build and k<=2 typo query latency
+void benchmarkFuzzySearch(int n) {
+    mt19937 gen(7);
+    vector<string> names(n);
+    for (int i = 0; i < n; i++) names[i] = syntheticName(gen);
+
+    FuzzyTermIndex index(FUZZY_MAX_DISTANCE, 12);
+    auto start = BenchClock::now();
+    for (int i = 0; i < n; i++) {
+        for (const string& token : tokenizeName(names[i])) index.addTerm(token, i);
+    }
+    double buildMs = elapsedMs(start);
+
+    // Queries: a real token with 1-2 random substitutions/transpositions
+    const int queries = 2000;
+    uniform_int_distribution<int> pick(0, n - 1), edits(1, 2), letter(0, 25);
+    long long found = 0;
+    double worstUs = 0;
+    start = BenchClock::now();
+    for (int q = 0; q < queries; q++) {
+        string token = tokenizeName(names[pick(gen)])[0];
+        int e = edits(gen);
+        for (int i = 0; i < e; i++) {
+            uniform_int_distribution<int> at(0, static_cast<int>(token.size()) - 2);
+            int p = at(gen);
+            if (i % 2) swap(token[p], token[p + 1]);
+            else token[p] = static_cast<char>('a' + letter(gen));
+        }
+        auto t0 = BenchClock::now();
+        found += index.search(token, e).size();
+        worstUs = max(worstUs, elapsedMs(t0) * 1000);
+    }
+    double queryMs = elapsedMs(start);
+
+    cout << "\n=== FUZZY SEARCH BENCHMARK (" << n << " names, " << index.termCount() << " distinct tokens) ===\n";
+    cout << fixed << setprecision(2);
+    cout << "Build: " << buildMs << " ms\n";
+    cout << "k<=2 query: " << (queryMs * 1000 / queries) << " us avg, " << worstUs << " us worst\n";
+    cout << "Avg matching records/query: " << (double)found / queries << "\n";
+}
+
+// FULL-TEXT BENCHMARK: FM-index count latency vs. a KMP scan of the same corpus
+void benchmarkFullTextSearch(int n) {
+    mt19937 gen(11);
+    static const char* phrases[] = {"great food", "slow service", "loved the paneer", "table was noisy",
+                                    "will come again", "cold soup", "friendly staff", "too spicy"};
+    uniform_int_distribution<int> phrase(0, 7);
+    string corpus;
+    for (int i = 0; i < n; i++) {
+        corpus += syntheticName(gen) + " " + phrases[phrase(gen)];
+        corpus += '\x01';
+    }
+    for (char& c : corpus) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+
+    DataStructures::FMIndex fm;
+    auto start = BenchClock::now();
+    fm.build(corpus);
+    double buildMs = elapsedMs(start);
+
+    const char* patterns[] = {"paneer", "slow", "karo", "friendly staff", "zzq"};
+    cout << "\n=== FULL-TEXT BENCHMARK (" << n << " documents, " << corpus.size() << " bytes) ===\n";
+    cout << fixed << setprecision(2);
+    cout << "FM-index build: " << buildMs << " ms, " << fm.memoryBytes() / (1024.0 * 1024.0) << " MB\n";
+    for (const char* pat : patterns) {
+        start = BenchClock::now();
+        int fmCount = 0;
+        for (int r = 0; r < 1000; r++) fmCount = fm.count(pat);
+        double fmUs = elapsedMs(start);
+        start = BenchClock::now();
+        int kmpCount = static_cast<int>(Algorithms::kmpSearch(corpus, pat).size());
+        double kmpMs = elapsedMs(start);
+        cout << "\"" << pat << "\": " << fmCount << " hits | FM count " << fmUs << " us | KMP scan "
+             << kmpMs << " ms" << (fmCount == kmpCount ? "" : " [MISMATCH]") << "\n";
+    }
+}
+
+// LEADERBOARD BENCHMARK: Streaming top-K update cost vs. full sort per refresh
+void benchmarkLeaderboards(int n) {
+    mt19937 gen(5);
+    const int customers = max(1, n / 10);
+    uniform_int_distribution<int> who(1, customers), pts(1, 50);
+    DataStructures::TopKTracker<int, int> board(LEADERBOARD_K);
+    DataStructures::SpaceSavingSketch<int> sketch(HEAVY_HITTER_COUNTERS);
+    vector<int> points(customers + 1, 0);
+
+    // Skew toward low ids so a few customers dominate the stream
+    auto start = BenchClock::now();
+    for (int i = 0; i < n; i++) {
+        int a = who(gen), b = who(gen);
+        int c = max(1, min(a, b) / 16);
+        points[c] += pts(gen);
+        board.update(c, points[c]);
+        sketch.offer(c);
+    }
+    double streamMs = elapsedMs(start);
+
+    // Redemptions and expiries: one event in five halves a balance, and the
+    // board is read every 100 events
+    uniform_int_distribution<int> roll(0, 4);
+    long long drops = 0, reads = 0;
+    double readMs = 0;
+    start = BenchClock::now();
+    for (int i = 0; i < n; i++) {
+        int a = who(gen), b = who(gen);
+        int c = max(1, min(a, b) / 16);
+        if (roll(gen) == 0) {
+            points[c] /= 2;
+            drops++;
+        } else {
+            points[c] += pts(gen);
+        }
+        board.update(c, points[c]);
+        if (i % 100 == 0) {
+            auto readStart = BenchClock::now();
+            board.top(LEADERBOARD_K);
+            readMs += elapsedMs(readStart);
+            reads++;
+        }
+    }
+    double mixedMs = elapsedMs(start);
+
+    start = BenchClock::now();
+    vector<int> ids(customers);
+    for (int i = 0; i < customers; i++) ids[i] = i + 1;
+    sort(ids.begin(), ids.end(), [&](int a, int b) { return points[a] > points[b]; });
+    double sortMs = elapsedMs(start);
+
+    auto top = board.top(LEADERBOARD_K);
+    bool exact = true;
+    for (int i = 0; i < static_cast<int>(top.size()); i++) exact = exact && points[ids[i]] == top[i].second;
+
+    cout << "\n=== LEADERBOARD BENCHMARK (" << n << " events, " << customers << " customers) ===\n";
+    cout << fixed << setprecision(3);
+    cout << "Streaming top-" << LEADERBOARD_K << " + Space-Saving: " << (streamMs * 1e6 / n) << " ns/event\n";
+    cout << "With " << drops << " score drops: " << (mixedMs * 1e6 / n) << " ns/event, top() after drops: "
+         << (reads ? readMs * 1000.0 / reads : 0.0) << " us/call (" << reads << " calls, " << board.rebuilds() << " full rebuilds)\n";
+    cout << "One full sort of all customers: " << sortMs << " ms\n";
+    cout << "Top-K matches full sort: " << (exact ? "yes" : "NO") << "\n";
+    cout << "Heaviest hitter: customer " << sketch.top(1)[0].key << " (~" << sketch.top(1)[0].count << " events)\n";
+}
+
+// LOYALTY LEDGER BENCHMARK: Checkpointed point-in-time balance vs. full replay
+void benchmarkLoyaltyLedger(int n) {
+    mt19937 gen(11);
+    const int customers = max(1, n / 50);
+    uniform_int_distribution<int> who(1, customers), pts(1, 200), kind(0, 9);
+    LoyaltyLedger ledger;
+    time_t t0 = 1700000000;
+
+    auto start = BenchClock::now();
+    for (int i = 0; i < n; i++) {
+        int c = who(gen);
+        int k = kind(gen);
+        LoyaltyEventType type = k < 7 ? LoyaltyEventType::ACCRUAL : (k < 9 ? LoyaltyEventType::REDEMPTION : LoyaltyEventType::EXPIRY);
+        int delta = type == LoyaltyEventType::ACCRUAL ? pts(gen) : -min(pts(gen), max(0, ledger.balance(c)));
+        ledger.append(c, type, delta, 0, "", t0 + i);
+    }
+    double appendMs = elapsedMs(start);
+
+    const int queries = 1000;
+    vector<pair<int, time_t>> probes;
+    for (int q = 0; q < queries; q++) probes.push_back({who(gen), t0 + static_cast<time_t>(gen() % n)});
+    long long checksum = 0;
+    start = BenchClock::now();
+    for (const auto& p : probes) checksum += ledger.balanceAt(p.first, p.second);
+    double checkpointMs = elapsedMs(start);
+
+    const int replayQueries = min(queries, 50);
+    long long replaySum = 0, checkSum = 0;
+    start = BenchClock::now();
+    for (int q = 0; q < replayQueries; q++) replaySum += ledger.replayBalanceAt(probes[q].first, probes[q].second);
+    double replayMs = elapsedMs(start);
+    for (int q = 0; q < replayQueries; q++) checkSum += ledger.balanceAt(probes[q].first, probes[q].second);
+
+    cout << "\n=== LOYALTY LEDGER BENCHMARK (" << n << " events, " << customers << " accounts) ===\n";
+    cout << fixed << setprecision(3);
+    cout << "Append + materialize: " << (appendMs * 1e6 / n) << " ns/event\n";
+    cout << "balanceAt (checkpoints): " << (checkpointMs * 1000.0 / queries) << " us/query\n";
+    cout << "Full replay:             " << (replayMs * 1000.0 / replayQueries) << " us/query\n";
+    cout << "Results agree: " << (replaySum == checkSum ? "yes" : "NO") << " (checksum " << checksum << ")\n";
+}
+
+// DELIVERY GRAPH BENCHMARK: CSR kernels on a synthetic city vs. linked-list adjacency
+void benchmarkDeliveryGraph(int n) {
+    auto start = BenchClock::now();
+    DataStructures::CSRGraphBuilder builder = generateRoadNetwork(n, 42);
+    double generateMs = elapsedMs(start);
+    start = BenchClock::now();
+    DataStructures::CSRGraph g = builder.build();
+    double buildMs = elapsedMs(start);
+
+    start = BenchClock::now();
+    auto bfs = csrBfsOrder(g, 0);
+    double bfsMs = elapsedMs(start);
+    start = BenchClock::now();
+    auto dfs = csrDfsOrder(g, 0);
+    double dfsMs = elapsedMs(start);
+    start = BenchClock::now();
+    auto tree = csrDijkstra(g, 0);
+    double dijkstraMs = elapsedMs(start);
+    start = BenchClock::now();
+    auto forest = csrPrimMST(g);
+    double primMs = elapsedMs(start);
+
+    // Same arcs as per-edge heap nodes, allocated in shuffled (file-like) order
+    vector<pair<int, int>> arcOrder;
+    arcOrder.reserve(g.arcCount());
+    for (int u = 0; u < g.nodeCount(); u++) {
+        for (const auto* a = g.arcsBegin(u); a != g.arcsEnd(u); ++a) arcOrder.push_back({u, static_cast<int>(a - g.arcList().data())});
+    }
+    mt19937 gen(7);
+    shuffle(arcOrder.begin(), arcOrder.end(), gen);
+    vector<AdjNode*> heads(g.nodeCount(), nullptr);
+    for (const auto& e : arcOrder) {
+        const auto& arc = g.arcList()[e.second];
+        heads[e.first] = new AdjNode{arc.to, arc.weight, heads[e.first]};
+    }
+    start = BenchClock::now();
+    vector<char> seen(g.nodeCount(), 0);
+    vector<int> queue{0};
+    seen[0] = 1;
+    for (size_t head = 0; head < queue.size(); head++) {
+        for (AdjNode* cur = heads[queue[head]]; cur; cur = cur->next) {
+            if (!seen[cur->dest]) { seen[cur->dest] = 1; queue.push_back(cur->dest); }
+        }
+    }
+    double listBfsMs = elapsedMs(start);
+    for (AdjNode* h : heads) {
+        while (h) { AdjNode* next = h->next; delete h; h = next; }
+    }
+
+    cout << "\n=== DELIVERY GRAPH BENCHMARK (" << g.nodeCount() << " nodes, " << g.arcCount() << " arcs) ===\n";
+    cout << fixed << setprecision(2);
+    cout << "Generate edges: " << generateMs << " ms, CSR build (sort + dedupe): " << buildMs << " ms\n";
+    cout << "BFS  linked-list adjacency: " << listBfsMs << " ms\n";
+    cout << "BFS  CSR: " << bfsMs << " ms (" << bfs.size() << " reached, list BFS reached " << queue.size() << ")\n";
+    cout << "DFS  CSR (iterative): " << dfsMs << " ms (" << dfs.size() << " reached)\n";
+    cout << "Dijkstra CSR: " << dijkstraMs << " ms (" << count_if(tree.dist.begin(), tree.dist.end(), [](int d) { return d < GRAPH_INF; }) << " reached)\n";
+    cout << "Prim CSR: " << primMs << " ms (cost " << forest.totalCost << ", " << forest.components << " components)\n";
+}
+
+// SHORTEST PATH BENCHMARK: Heap variants and early exit on a road-like graph
+void benchmarkShortestPaths(int n) {
+    DataStructures::CSRGraph g = generateRoadNetwork(n, 42).build();
+    mt19937 gen(13);
+    uniform_int_distribution<int> node(0, g.nodeCount() - 1);
+    const int queries = 10;
+    vector<pair<int, int>> pairs;
+    for (int q = 0; q < queries; q++) pairs.push_back({node(gen), node(gen)});
+
+    cout << "\n=== SHORTEST PATH BENCHMARK (" << g.nodeCount() << " nodes, " << g.arcCount() << " arcs, " << queries << " queries) ===\n";
+    cout << fixed << setprecision(2);
+    ShortestPathEngine engine;
+    engine.bind(g);
+    vector<long long> reference;
+    for (HeapKind kind : {HeapKind::BINARY, HeapKind::DARY4, HeapKind::RADIX, HeapKind::DIAL}) {
+        engine.setHeap(kind);
+        long long checksum = 0;
+        auto start = BenchClock::now();
+        for (const auto& p : pairs) {
+            engine.run(p.first);
+            int d = engine.distanceTo(p.second);
+            checksum += d == GRAPH_INF ? 0 : d;
+        }
+        double fullMs = elapsedMs(start);
+
+        long long settled = 0, p2pChecksum = 0;
+        start = BenchClock::now();
+        for (const auto& p : pairs) {
+            int d = engine.run(p.first, p.second);
+            p2pChecksum += d == GRAPH_INF ? 0 : d;
+            settled += engine.settled();
+        }
+        double p2pMs = elapsedMs(start);
+        bool agrees = checksum == p2pChecksum && (reference.empty() || reference[0] == checksum);
+        reference.push_back(checksum);
+        cout << setw(13) << left << heapKindToString(kind) << right
+             << " full SSSP " << setw(9) << fullMs / queries << " ms/query"
+             << " | early exit " << setw(9) << p2pMs / queries << " ms/query ("
+             << settled / queries << " settled)"
+             << (agrees ? "" : "  MISMATCH") << "\n";
+    }
+}
+
+// ALT BENCHMARK: Bidirectional landmark A* vs. early-exit Dijkstra for s-t queries
+void benchmarkLandmarkRouting(int n) {
+    DataStructures::CSRGraph g = generateRoadNetwork(n, 42).build();
+    auto start = BenchClock::now();
+    LandmarkRouter router;
+    router.preprocess(g, DELIVERY_LANDMARKS);
+    double preprocessMs = elapsedMs(start);
+
+    ShortestPathEngine dijkstraEngine(HeapKind::BINARY);
+    dijkstraEngine.bind(g);
+    mt19937 gen(17);
+    uniform_int_distribution<int> node(0, g.nodeCount() - 1);
+    const int queries = 100;
+    vector<pair<int, int>> pairs;
+    for (int q = 0; q < queries; q++) pairs.push_back({node(gen), node(gen)});
+
+    long long dijkstraSettled = 0, altSettled = 0;
+    vector<int> expected;
+    start = BenchClock::now();
+    for (const auto& p : pairs) {
+        expected.push_back(dijkstraEngine.run(p.first, p.second));
+        dijkstraSettled += dijkstraEngine.settled();
+    }
+    double dijkstraMs = elapsedMs(start);
+    int mismatches = 0;
+    start = BenchClock::now();
+    for (int q = 0; q < queries; q++) {
+        if (router.query(pairs[q].first, pairs[q].second) != expected[q]) mismatches++;
+        altSettled += router.settled();
+    }
+    double altMs = elapsedMs(start);
+
+    cout << "\n=== ALT ROUTING BENCHMARK (" << g.nodeCount() << " nodes, " << queries << " random s-t queries) ===\n";
+    cout << fixed << setprecision(3);
+    cout << "Preprocessing (" << router.landmarkNodes().size() << " landmarks): " << preprocessMs << " ms\n";
+    cout << "Dijkstra (early exit): " << dijkstraMs / queries << " ms/query, " << dijkstraSettled / queries << " settled\n";
+    cout << "Bidirectional ALT A*:  " << altMs / queries << " ms/query, " << altSettled / queries << " settled\n";
+    cout << "Distance mismatches: " << mismatches << "\n";
+}
+
+// CONTRACTION HIERARCHY BENCHMARK: Preprocessing, persistence and query latency
+void benchmarkContractionHierarchy(int n) {
+    DataStructures::CSRGraph g = generateRoadNetwork(n, 42).build();
+    ContractionHierarchy ch;
+    auto start = BenchClock::now();
+    ch.build(g);
+    double buildMs = elapsedMs(start);
+    long long shortcuts = ch.shortcutCount(), upwardArcs = ch.upwardArcCount();
+
+    const string file = "benchmark_ch.bin";
+    ContractionHierarchy loaded;
+    double saveMs = 0, loadMs = 0;
+    try {
+        start = BenchClock::now();
+        ch.save(file);
+        saveMs = elapsedMs(start);
+        start = BenchClock::now();
+        loaded.load(file);
+        loadMs = elapsedMs(start);
+    } catch (const Core::CustomException& e) {
+        remove(file.c_str());
+        cout << "Hierarchy save/load failed: " << e.what() << "\n";
+        return;
+    }
+    remove(file.c_str());
+
+    ShortestPathEngine dijkstraEngine(HeapKind::DARY4);
+    dijkstraEngine.bind(g);
+    mt19937 gen(19);
+    uniform_int_distribution<int> node(0, g.nodeCount() - 1);
+    const int queries = 1000, dijkstraQueries = 20;
+    vector<pair<int, int>> pairs;
+    for (int q = 0; q < queries; q++) pairs.push_back({node(gen), node(gen)});
+
+    vector<int> expected;
+    start = BenchClock::now();
+    for (int q = 0; q < dijkstraQueries; q++) expected.push_back(dijkstraEngine.run(pairs[q].first, pairs[q].second));
+    double dijkstraMs = elapsedMs(start);
+
+    long long settled = 0, checksum = 0;
+    start = BenchClock::now();
+    for (const auto& p : pairs) {
+        checksum += loaded.query(p.first, p.second);
+        settled += loaded.settled();
+    }
+    double chMs = elapsedMs(start);
+    int mismatches = 0;
+    for (int q = 0; q < dijkstraQueries; q++) {
+        vector<int> route;
+        int d = loaded.query(pairs[q].first, pairs[q].second);
+        route = loaded.lastPath();
+        long long length = 0;
+        for (size_t i = 0; i + 1 < route.size(); i++) length += g.arcWeight(route[i], route[i + 1]);
+        if (d != expected[q] || (d != GRAPH_INF && length != d)) mismatches++;
+    }
+
+    // Traffic: reweigh some roads both ways, then re-customise in the old node
+    // order instead of a full rebuild
+    const int trafficUpdates = 200;
+    uniform_int_distribution<int> factor(50, 200);
+    for (int k = 0; k < trafficUpdates; k++) {
+        int u = node(gen);
+        if (g.arcsBegin(u) == g.arcsEnd(u)) continue;
+        int v = g.arcsBegin(u)->to, w = max(1, g.arcWeight(u, v) * factor(gen) / 100);
+        g.setArcWeight(u, v, w);
+        g.setArcWeight(v, u, w);
+    }
+    start = BenchClock::now();
+    ch.customize(g);
+    double customizeMs = elapsedMs(start);
+    dijkstraEngine.bind(g);
+    int trafficMismatches = 0;
+    for (int q = 0; q < dijkstraQueries; q++)
+        if (ch.query(pairs[q].first, pairs[q].second) != dijkstraEngine.run(pairs[q].first, pairs[q].second)) trafficMismatches++;
+
+    cout << "\n=== CONTRACTION HIERARCHY BENCHMARK (" << g.nodeCount() << " nodes, " << g.arcCount() << " arcs) ===\n";
+    cout << fixed << setprecision(3);
+    long long roads = g.arcCount() / 2;
+    cout << "Preprocessing: " << buildMs << " ms, shortcuts: " << shortcuts << ", upward arcs: " << upwardArcs << "\n";
+    cout << "Shortcut/road ratio: " << (roads ? static_cast<double>(shortcuts) / roads : 0.0) << " (" << roads << " roads)\n";
+    cout << "Save: " << saveMs << " ms, load: " << loadMs << " ms\n";
+    cout << "Dijkstra (early exit): " << dijkstraMs / dijkstraQueries << " ms/query\n";
+    cout << "CH query: " << chMs * 1000.0 / queries << " us/query, " << settled / queries << " settled (checksum " << checksum << ")\n";
+    cout << "Distance/route mismatches vs Dijkstra: " << mismatches << " of " << dijkstraQueries << "\n";
+    cout << "Re-customise after " << trafficUpdates << " traffic updates: " << customizeMs << " ms (full build " << buildMs
+         << " ms), mismatches: " << trafficMismatches << " of " << dijkstraQueries << "\n";
+}
+
+void benchmarkAllPairs(int n) {
+    n = min(n, APSP_MAX_NODES);
+    DataStructures::CSRGraph g = generateRoadNetwork(n, 42).build();
+    n = g.nodeCount();
+    int workers = parallelWorkerCount(n);
+
+    // Textbook triple loop over a flat matrix, for comparison
+    vector<int> naive(static_cast<size_t>(n) * n, GRAPH_INF);
+    for (int u = 0; u < n; u++) {
+        naive[static_cast<size_t>(u) * n + u] = 0;
+        for (const auto* a = g.arcsBegin(u); a != g.arcsEnd(u); ++a) naive[static_cast<size_t>(u) * n + a->to] = a->weight;
+    }
+    auto start = BenchClock::now();
+    for (int k = 0; k < n; k++)
+        for (int i = 0; i < n; i++) {
+            int dik = naive[static_cast<size_t>(i) * n + k];
+            if (dik == GRAPH_INF) continue;
+            for (int j = 0; j < n; j++)
+                naive[static_cast<size_t>(i) * n + j] = min(naive[static_cast<size_t>(i) * n + j], dik + naive[static_cast<size_t>(k) * n + j]);
+        }
+    double naiveMs = elapsedMs(start);
+
+    AllPairsDistances floyd, dijkstraSerial, dijkstraParallel;
+    start = BenchClock::now();
+    floyd.compute(g, workers, ApspMethod::FLOYD_WARSHALL);
+    double floydMs = elapsedMs(start);
+    start = BenchClock::now();
+    dijkstraSerial.compute(g, 1, ApspMethod::DIJKSTRA);
+    double serialMs = elapsedMs(start);
+    start = BenchClock::now();
+    dijkstraParallel.compute(g, workers, ApspMethod::DIJKSTRA);
+    double parallelMs = elapsedMs(start);
+
+    long long mismatches = 0;
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++) {
+            int d = naive[static_cast<size_t>(i) * n + j];
+            if (floyd.distance(i, j) != d || dijkstraParallel.distance(i, j) != d) mismatches++;
+        }
+
+    // One new road across the map: O(n^2) patch vs a full recompute
+    int u = 0, v = n - 1, w = 10;
+    start = BenchClock::now();
+    dijkstraParallel.arcImproved(u, v, w);
+    dijkstraParallel.arcImproved(v, u, w);
+    double patchMs = elapsedMs(start);
+    DataStructures::CSRGraphBuilder builder = generateRoadNetwork(n, 42);
+    builder.addEdge(u, v, w);
+    DataStructures::CSRGraph patched = builder.build();
+    AllPairsDistances reference;
+    start = BenchClock::now();
+    reference.compute(patched, workers);
+    double recomputeMs = elapsedMs(start);
+    long long patchMismatches = 0;
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            if (dijkstraParallel.distance(i, j) != reference.distance(i, j)) patchMismatches++;
+
+    // A road on a 400-stop path gets dear enough to push distances past the
+    // 16-bit cells; the parallel refresh must widen the table before filling
+    int pathNodes = 400, mid = pathNodes / 2;
+    DataStructures::CSRGraphBuilder pathBuilder(pathNodes);
+    for (int i = 0; i + 1 < pathNodes; i++) pathBuilder.addEdge(i, i + 1, 5);
+    DataStructures::CSRGraph path = pathBuilder.build();
+    AllPairsDistances pathTable, pathReference;
+    pathTable.compute(path, workers, ApspMethod::DIJKSTRA);
+    bool narrowBefore = pathTable.table().isNarrow();
+    path.setArcWeight(mid - 1, mid, 70000);
+    path.setArcWeight(mid, mid - 1, 70000);
+    pathTable.arcWorsened(mid - 1, mid, 5);
+    pathTable.arcWorsened(mid, mid - 1, 5);
+    int refreshed = pathTable.refresh(path, 8);
+    pathReference.compute(path, 1, ApspMethod::DIJKSTRA);
+    long long wideMismatches = 0;
+    for (int i = 0; i < pathNodes; i++)
+        for (int j = 0; j < pathNodes; j++)
+            if (pathTable.distance(i, j) != pathReference.distance(i, j)) wideMismatches++;
+
+    const DataStructures::DistanceMatrix& table = dijkstraParallel.table();
+    cout << "\n=== ALL-PAIRS DISTANCE BENCHMARK (" << n << " nodes, " << g.arcCount() << " arcs, " << workers << " threads) ===\n";
+    cout << fixed << setprecision(3);
+    cout << "Naive Floyd-Warshall: " << naiveMs << " ms\n";
+    cout << "Blocked Floyd-Warshall: " << floydMs << " ms\n";
+    cout << "Dijkstra per source, 1 thread: " << serialMs << " ms\n";
+    cout << "Dijkstra per source, " << workers << " threads: " << parallelMs << " ms\n";
+    cout << "Table: " << (table.isNarrow() ? 16 : 32) << "-bit cells, " << table.bytes() / 1024 << " KB (32-bit would be "
+         << static_cast<long long>(n) * n * 4 / 1024 << " KB)\n";
+    cout << "New road patch: " << patchMs << " ms vs full recompute " << recomputeMs << " ms\n";
+    cout << "Mismatches vs naive: " << mismatches << ", after patch: " << patchMismatches << "\n";
+    cout << "Refresh past the 16-bit limit: " << refreshed << " rows on 8 threads, " << (narrowBefore ? 16 : 32) << " -> "
+         << (pathTable.table().isNarrow() ? 16 : 32) << "-bit cells, " << wideMismatches << " mismatches\n";
+}
+
+void benchmarkTourImprovement(int n) {
+    vector<int> sizes = {50, 500};
+    if (n > 500) sizes.push_back(min(n, 5000));
+    cout << "\n=== TOUR IMPROVEMENT BENCHMARK (random stops on a 10000 x 10000 map) ===\n";
+    cout << fixed << setprecision(3);
+    for (int stops : sizes) {
+        mt19937 gen(stops);
+        uniform_int_distribution<int> coord(0, 9999);
+        vector<pair<int, int>> points(stops);
+        for (auto& p : points) p = {coord(gen), coord(gen)};
+        DataStructures::DistanceMatrix dist;
+        dist.reset(stops, GRAPH_INF);
+        for (int i = 0; i < stops; i++)
+            for (int j = 0; j < stops; j++)
+                dist.set(i, j, static_cast<int>(lround(hypot(points[i].first - points[j].first, points[i].second - points[j].second))));
+        dist.compact();
+
+        auto start = BenchClock::now();
+        vector<int> tour = nearestNeighbourTour(dist, 0, stops);
+        double nnMs = elapsedMs(start);
+        TourImprover improver(dist);
+        vector<int> budgeted = tour;
+        start = BenchClock::now();
+        TourImprover::Stats capped = improver.improve(budgeted, TOUR_IMPROVE_BUDGET_MS);
+        double cappedMs = elapsedMs(start);
+        start = BenchClock::now();
+        TourImprover::Stats full = improver.improve(tour, 60000);
+        double fullMs = elapsedMs(start);
+
+        cout << stops << " stops: nearest neighbour " << full.initialLength << " (" << nnMs << " ms)\n";
+        cout << "  2-opt/Or-opt, " << TOUR_IMPROVE_BUDGET_MS << " ms budget: " << capped.finalLength << " ("
+             << 100.0 * (capped.initialLength - capped.finalLength) / capped.initialLength << "% shorter, "
+             << cappedMs << " ms" << (capped.outOfTime ? ", budget hit" : "") << ")\n";
+        cout << "  2-opt/Or-opt to local optimum: " << full.finalLength << " ("
+             << 100.0 * (full.initialLength - full.finalLength) / full.initialLength << "% shorter, " << fullMs << " ms, "
+             << full.twoOptMoves << " 2-opt + " << full.orOptMoves << " Or-opt moves)\n";
+    }
+}
+
+void benchmarkHeldKarp(int n) {
+    int maxStops = max(8, min(n, HELD_KARP_MAX_STOPS));
+    int workers = parallelWorkerCount(HELD_KARP_MAX_STOPS);
+    cout << "\n=== EXACT TSP (HELD-KARP) BENCHMARK (random stops, " << workers << " threads) ===\n";
+    cout << fixed << setprecision(3);
+    for (int stops = 8; stops <= maxStops; stops += 4) {
+        mt19937 gen(stops);
+        uniform_int_distribution<int> coord(0, 9999);
+        vector<pair<int, int>> points(stops);
+        for (auto& p : points) p = {coord(gen), coord(gen)};
+        DataStructures::DistanceMatrix dist;
+        dist.reset(stops, GRAPH_INF);
+        for (int i = 0; i < stops; i++)
+            for (int j = 0; j < stops; j++)
+                dist.set(i, j, static_cast<int>(lround(hypot(points[i].first - points[j].first, points[i].second - points[j].second))));
+        dist.compact();
+
+        auto start = BenchClock::now();
+        vector<int> heuristic = nearestNeighbourTour(dist, 0, stops);
+        TourImprover::Stats local = TourImprover(dist).improve(heuristic, TOUR_IMPROVE_BUDGET_MS);
+        double heuristicMs = elapsedMs(start);
+        long long serialLength = 0, parallelLength = 0;
+        start = BenchClock::now();
+        heldKarpTour(dist, heuristic, &serialLength, 1);
+        double serialMs = elapsedMs(start);
+        start = BenchClock::now();
+        heldKarpTour(dist, heuristic, &parallelLength, workers);
+        double parallelMs = elapsedMs(start);
+
+        cout << stops << " stops: optimal " << parallelLength << " (1 thread " << serialMs << " ms, "
+             << workers << " threads " << parallelMs << " ms); NN + 2-opt/Or-opt " << local.finalLength << " (+"
+             << 100.0 * (local.finalLength - parallelLength) / parallelLength << "%, " << heuristicMs << " ms)"
+             << (serialLength != parallelLength ? " MISMATCH" : "") << "\n";
+    }
+}
+
+void benchmarkFleetRouting(int n) {
+    int orders = max(20, min(n, 1000));
+    DataStructures::CSRGraph g = generateRoadNetwork(2500, 42).build();
+    AllPairsDistances table;
+    table.compute(g);
+    // Grid weights are 10-100 per block; count 25 units as a minute of riding
+    auto travel = [&table](int a, int b) {
+        int d = table.distance(a, b);
+        return d == GRAPH_INF ? d : d / 25;
+    };
+    int riders = max(2, orders / 4); // ~2.5 items per order, 12 per bag
+
+    mt19937 gen(orders);
+    uniform_int_distribution<int> node(1, g.nodeCount() - 1), items(1, 4), opens(0, 120);
+    auto randomStop = [&](int id) {
+        int at = node(gen), earliest = opens(gen);
+        return FleetRoutePlanner::Stop{id, at, items(gen), earliest, max(earliest + 60, travel(0, at) + 20)};
+    };
+    vector<FleetRoutePlanner::Stop> batch, arrivals;
+    for (int i = 0; i < orders; i++) batch.push_back(randomStop(i + 1));
+    for (int i = 0; i < 50; i++) arrivals.push_back(randomStop(orders + i + 1));
+
+    FleetRoutePlanner planner;
+    planner.reset(0, riders, RIDER_BAG_CAPACITY, travel);
+    for (const auto& stop : batch) planner.addStop(stop);
+    auto start = BenchClock::now();
+    planner.solve(0);
+    double savingsMs = elapsedMs(start);
+    long long savingsDistance = planner.totalDistance();
+    size_t savingsUnassigned = planner.unassignedOrders().size();
+    start = BenchClock::now();
+    planner.solve(5000);
+    double solveMs = elapsedMs(start);
+    long long solvedDistance = planner.totalDistance();
+
+    double worstInsertMs = 0, totalInsertMs = 0;
+    for (const auto& stop : arrivals) {
+        start = BenchClock::now();
+        planner.insertOrder(stop, VRP_REOPTIMIZE_BUDGET_MS);
+        double ms = elapsedMs(start);
+        totalInsertMs += ms;
+        worstInsertMs = max(worstInsertMs, ms);
+    }
+    long long incrementalDistance = planner.totalDistance();
+    FleetRoutePlanner fresh;
+    fresh.reset(0, riders, RIDER_BAG_CAPACITY, travel);
+    for (const auto& stop : batch) fresh.addStop(stop);
+    for (const auto& stop : arrivals) fresh.addStop(stop);
+    start = BenchClock::now();
+    fresh.solve(5000);
+    double resolveMs = elapsedMs(start);
+
+    cout << "\n=== FLEET ROUTING (VRP-TW) BENCHMARK (" << orders << " orders, " << riders << " riders, "
+         << g.nodeCount() << "-node network) ===\n";
+    cout << fixed << setprecision(3);
+    cout << "Savings construction: distance " << savingsDistance << ", " << savingsUnassigned << " unassigned, " << savingsMs << " ms\n";
+    cout << "+ relocate/exchange/2-opt*: distance " << solvedDistance << " ("
+         << 100.0 * (savingsDistance - solvedDistance) / max(1LL, savingsDistance) << "% shorter), "
+         << planner.ridersUsed() << " riders used, " << solveMs << " ms\n";
+    cout << "50 new orders inserted incrementally: avg " << totalInsertMs / arrivals.size() << " ms, worst " << worstInsertMs
+         << " ms, distance " << incrementalDistance << ", " << planner.unassignedOrders().size() << " unassigned\n";
+    cout << "Full re-plan of the same orders: distance " << fresh.totalDistance() << ", " << fresh.unassignedOrders().size()
+         << " unassigned, " << resolveMs << " ms\n";
+}
+
+void benchmarkAssignment(int n) {
+    n = max(10, min(n, 2000));
+    mt19937 gen(n);
+    uniform_int_distribution<int> costOf(0, 9999);
+    auto randomMatrix = [&](int rows, int cols) {
+        vector<vector<long long>> cost(rows, vector<long long>(cols));
+        for (auto& row : cost)
+            for (auto& c : row) c = costOf(gen);
+        return cost;
+    };
+    vector<int> rowIds(n), colIds(n);
+    iota(rowIds.begin(), rowIds.end(), 0);
+    iota(colIds.begin(), colIds.end(), n);
+
+    const int instances = 5;
+    double coldMs = 0;
+    long long optimal = 0;
+    vector<vector<long long>> cost;
+    AssignmentSolver solver;
+    for (int t = 0; t < instances; t++) {
+        cost = randomMatrix(n, n);
+        auto start = BenchClock::now();
+        optimal = solver.solve(cost, rowIds, colIds, false).totalCost;
+        coldMs += elapsedMs(start);
+    }
+
+    // Greedy baseline: cheapest remaining pair per row
+    vector<char> taken(n, 0);
+    long long greedy = 0;
+    for (int i = 0; i < n; i++) {
+        int best = -1;
+        for (int j = 0; j < n; j++)
+            if (!taken[j] && (best < 0 || cost[i][j] < cost[i][best])) best = j;
+        taken[best] = 1;
+        greedy += cost[i][best];
+    }
+
+    // 5% of the riders move, then re-solve warm
+    for (int k = 0; k < max(1, n / 20); k++)
+        for (auto& c : cost[gen() % n]) c = costOf(gen);
+    auto start = BenchClock::now();
+    AssignmentSolver::Result warm = solver.solve(cost, rowIds, colIds, true);
+    double warmMs = elapsedMs(start);
+    start = BenchClock::now();
+    long long coldAfter = AssignmentSolver().solve(cost, rowIds, colIds, false).totalCost;
+    double coldAfterMs = elapsedMs(start);
+
+    int narrow = max(1, n * 3 / 5);
+    vector<vector<long long>> wide = randomMatrix(narrow, n), tall = randomMatrix(n, narrow);
+    vector<int> narrowIds(rowIds.begin(), rowIds.begin() + narrow), narrowColIds(colIds.begin(), colIds.begin() + narrow);
+    start = BenchClock::now();
+    AssignmentSolver().solve(wide, narrowIds, colIds, false);
+    double wideMs = elapsedMs(start);
+    start = BenchClock::now();
+    AssignmentSolver().solve(tall, rowIds, narrowColIds, false);
+    double tallMs = elapsedMs(start);
+
+    cout << "\n=== RIDER ASSIGNMENT (HUNGARIAN) BENCHMARK (" << n << " x " << n << ") ===\n";
+    cout << fixed << setprecision(3);
+    cout << "Cold solve: " << coldMs / instances << " ms avg (" << 1000.0 * instances / coldMs << " solves/s), optimal cost "
+         << optimal << " vs greedy " << greedy << "\n";
+    cout << "Warm re-solve after " << max(1, n / 20) << " rows changed: " << warmMs << " ms, " << warm.augmented
+         << " augmentations (cold " << coldAfterMs << " ms), costs " << warm.totalCost << " / " << coldAfter
+         << (warm.totalCost == coldAfter ? "" : " MISMATCH") << "\n";
+    cout << "Rectangular " << narrow << " x " << n << ": " << wideMs << " ms, " << n << " x " << narrow << ": " << tallMs << " ms\n";
+}
+
+void benchmarkWaveBatching(int n) {
+    int orders = max(20, min(n, 2000));
+    DataStructures::CSRGraph g = generateRoadNetwork(2500, 42).build();
+    AllPairsDistances table;
+    table.compute(g);
+    // Same scale as the fleet benchmark: 25 distance units per riding minute
+    auto travel = [&table](int a, int b) {
+        int d = table.distance(a, b);
+        return d == GRAPH_INF ? d : d / 25;
+    };
+    const int serviceMinutes = 180;
+    mt19937 gen(orders);
+    uniform_int_distribution<int> node(1, g.nodeCount() - 1), items(1, 4), placed(0, serviceMinutes - 1), promise(45, 75);
+    vector<WaveBatcher::Order> all;
+    for (int i = 0; i < orders; i++) {
+        int at = node(gen), when = placed(gen);
+        all.push_back({i + 1, at, items(gen), when, when + max(promise(gen), travel(0, at) + 15), when});
+    }
+    sort(all.begin(), all.end(), [](const WaveBatcher::Order& a, const WaveBatcher::Order& b) { return a.readySince < b.readySince; });
+
+    // Service simulation: orders arrive over three hours, the timer ticks
+    // every WAVE_TICK_MINUTES and due waves leave
+    WaveBatcher batcher;
+    batcher.reset(0, RIDER_BAG_CAPACITY, travel);
+    vector<WaveBatcher::Order> pending;
+    size_t next = 0;
+    int waves = 0, sent = 0, late = 0, runs = 0;
+    long long distance = 0, solo = 0;
+    double totalMs = 0, worstMs = 0;
+    for (int now = 0; sent < orders; now += WAVE_TICK_MINUTES) {
+        while (next < all.size() && all[next].readySince <= now) pending.push_back(all[next++]);
+        if (pending.empty()) continue;
+        auto start = BenchClock::now();
+        vector<WaveBatcher::Wave> planned = batcher.plan(pending, now);
+        double ms = elapsedMs(start);
+        totalMs += ms;
+        worstMs = max(worstMs, ms);
+        runs++;
+        unordered_set<int> gone;
+        for (const auto& wave : planned) {
+            if (!batcher.due(wave, now, true)) continue;
+            waves++;
+            distance += wave.distance;
+            for (size_t k = 0; k < wave.orderIds.size(); k++) gone.insert(wave.orderIds[k]);
+        }
+        for (const auto& order : pending) {
+            if (!gone.count(order.orderId)) continue;
+            sent++;
+            solo += travel(0, order.node) + travel(order.node, 0);
+        }
+        for (const auto& wave : planned)
+            if (batcher.due(wave, now, true))
+                for (size_t k = 0; k < wave.orderIds.size(); k++)
+                    for (const auto& order : pending)
+                        if (order.orderId == wave.orderIds[k] && wave.arrivals[k] > order.windowEnd) late++;
+        pending.erase(remove_if(pending.begin(), pending.end(), [&gone](const WaveBatcher::Order& o) { return gone.count(o.orderId) > 0; }),
+                      pending.end());
+    }
+
+    // One-shot clustering of every order at once (runtime at scale)
+    vector<WaveBatcher::Order> batch = all;
+    for (auto& order : batch) {
+        order.windowStart -= order.readySince;
+        order.windowEnd -= order.readySince;
+        order.readySince = 0;
+    }
+    auto start = BenchClock::now();
+    vector<WaveBatcher::Wave> oneShot = batcher.plan(batch, 0);
+    double oneShotMs = elapsedMs(start);
+    const WaveBatcher::Stats& stats = batcher.lastStats();
+    long long oneShotDistance = 0;
+    int oneShotLate = 0;
+    for (const auto& wave : oneShot) {
+        oneShotDistance += wave.distance;
+        oneShotLate += !wave.onTime;
+    }
+
+    cout << "\n=== DELIVERY WAVE BATCHING BENCHMARK (" << orders << " orders, " << g.nodeCount() << "-node network, bag "
+         << RIDER_BAG_CAPACITY << " items) ===\n";
+    cout << fixed << setprecision(3);
+    cout << "Service simulation (" << serviceMinutes << " min, " << WAVE_TICK_MINUTES << "-min timer): " << waves << " waves, "
+         << static_cast<double>(sent) / waves << " stops per trip, " << static_cast<double>(distance) / sent
+         << " riding min per order vs " << static_cast<double>(solo) / sent << " one trip each, " << late << " late\n";
+    cout << "Clustering per tick: " << totalMs / runs << " ms avg, " << worstMs << " ms worst over " << runs << " ticks\n";
+    cout << "All " << orders << " orders at once: " << oneShot.size() << " waves (" << static_cast<double>(orders) / oneShot.size()
+         << " stops per trip, " << static_cast<double>(oneShotDistance) / orders << " min per order, " << oneShotLate
+         << " waves late), " << oneShotMs << " ms: matrix " << stats.matrixMs << ", k-medoids " << stats.clusterMs << " ("
+         << stats.rounds << " rounds), routing " << stats.routeMs << " ms, " << stats.split << " stops split off\n";
+}
+
+void benchmarkRoadLoader(int n) {
+    // n = target number of roads; a street grid has about 1.85 per node
+    int nodes = max(100, static_cast<int>(n / 1.85));
+    DataStructures::CSRGraph original = generateRoadNetwork(nodes, 42).build();
+    filesystem::path dir = filesystem::temp_directory_path();
+    string edgeFile = (dir / "bench_roads.txt").string(), dimacsFile = (dir / "bench_roads.gr").string();
+    {
+        // Written with a plain buffer: the benchmark is about reading
+        string text, arcsText;
+        text.reserve(static_cast<size_t>(original.arcCount()) * 8);
+        arcsText.reserve(static_cast<size_t>(original.arcCount()) * 16);
+        text += "# synthetic street grid: u v weight\n";
+        arcsText += "c synthetic street grid\np sp " + to_string(nodes) + " " + to_string(original.arcCount()) + "\n";
+        for (int u = 0; u < nodes; u++)
+            for (const auto* a = original.arcsBegin(u); a != original.arcsEnd(u); ++a) {
+                string tail = to_string(a->weight) + "\n";
+                if (u < a->to) text += to_string(u) + " " + to_string(a->to) + " " + tail;
+                arcsText += "a " + to_string(u + 1) + " " + to_string(a->to + 1) + " " + tail;
+            }
+        ofstream(edgeFile, ios::binary).write(text.data(), text.size());
+        ofstream(dimacsFile, ios::binary).write(arcsText.data(), arcsText.size());
+    }
+    double edgeMB = filesystem::file_size(edgeFile) / 1048576.0, dimacsMB = filesystem::file_size(dimacsFile) / 1048576.0;
+
+    RoadLoadStats edgeStats, dimacsStats;
+    DataStructures::CSRGraph fromEdges = readRoadFile(edgeFile, RoadFileFormat::AUTO, edgeStats);
+    DataStructures::CSRGraph fromDimacs = readRoadFile(dimacsFile, RoadFileFormat::AUTO, dimacsStats);
+    string cacheFile = edgeFile + ".csr";
+    auto stamp = roadFileStamp(edgeFile);
+    auto start = BenchClock::now();
+    saveRoadCache(cacheFile, fromEdges, stamp);
+    double saveMs = elapsedMs(start);
+    DataStructures::CSRGraph cached;
+    start = BenchClock::now();
+    bool hit = loadRoadCache(cacheFile, stamp, cached);
+    double cacheMs = elapsedMs(start);
+
+    // Serial baseline: same records through CSRGraphBuilder
+    DataStructures::CSRGraphBuilder serial(nodes);
+    serial.reserve(static_cast<size_t>(original.arcCount()));
+    for (int u = 0; u < nodes; u++)
+        for (const auto* a = original.arcsBegin(u); a != original.arcsEnd(u); ++a)
+            if (u < a->to) serial.addEdge(u, a->to, a->weight);
+    start = BenchClock::now();
+    serial.build();
+    double serialBuildMs = elapsedMs(start);
+
+    uint64_t expected = original.fingerprint();
+    bool same = fromEdges.fingerprint() == expected && fromDimacs.fingerprint() == expected && hit && cached.fingerprint() == expected;
+    cout << "\n=== ROAD NETWORK LOADER BENCHMARK (" << nodes << " nodes, " << original.arcCount() / 2 << " roads, "
+         << edgeStats.workers << " workers) ===\n";
+    cout << fixed << setprecision(3);
+    cout << "Edge list (" << edgeMB << " MB): parse " << edgeStats.parseMs << " ms (" << edgeMB * 1000 / edgeStats.parseMs
+         << " MB/s), CSR build " << edgeStats.buildMs << " ms (serial builder " << serialBuildMs << " ms)\n";
+    cout << "DIMACS (" << dimacsMB << " MB): parse " << dimacsStats.parseMs << " ms (" << dimacsMB * 1000 / dimacsStats.parseMs
+         << " MB/s), CSR build " << dimacsStats.buildMs << " ms\n";
+    cout << "Binary cache (" << filesystem::file_size(cacheFile) / 1048576.0 << " MB): write " << saveMs << " ms, load "
+         << cacheMs << " ms\n";
+    cout << "Graphs identical to the generated network: " << (same ? "yes" : "NO") << "\n";
+    filesystem::remove(edgeFile);
+    filesystem::remove(dimacsFile);
+    filesystem::remove(cacheFile);
+}
+
+void benchmarkDynamicShortestPaths(int n) {
+    n = max(1000, n);
+    DataStructures::CSRGraph g = generateRoadNetwork(n, 42).build();
+    auto start = BenchClock::now();
+    DynamicShortestPaths tree;
+    tree.build(g, {0});
+    double buildMs = elapsedMs(start);
+
+    // Traffic: random roads get 1.5-3x slower or up to 50% faster
+    mt19937 gen(n);
+    const int updates = 2000;
+    double worseMs = 0, betterMs = 0;
+    long long worseTouched = 0, betterTouched = 0;
+    int worse = 0, better = 0;
+    for (int k = 0; k < updates; k++) {
+        int u = gen() % g.nodeCount();
+        if (g.degree(u) == 0) continue;
+        int v = g.arcsBegin(u)[gen() % g.degree(u)].to;
+        int old = g.arcWeight(u, v);
+        bool slower = gen() % 2 == 0;
+        int w = slower ? old * (3 + gen() % 4) / 2 : max(1, old * (50 + static_cast<int>(gen() % 50)) / 100);
+        g.setArcWeight(u, v, w);
+        g.setArcWeight(v, u, w);
+        start = BenchClock::now();
+        tree.arcChanged(g, u, v);
+        long long touched = tree.touchedLastUpdate();
+        tree.arcChanged(g, v, u);
+        touched += tree.touchedLastUpdate();
+        double ms = elapsedMs(start);
+        if (slower) { worse++; worseMs += ms; worseTouched += touched; }
+        else { better++; betterMs += ms; betterTouched += touched; }
+    }
+    DynamicShortestPaths fresh;
+    start = BenchClock::now();
+    fresh.build(g, {0});
+    double rebuildMs = elapsedMs(start);
+    int mismatches = 0;
+    for (int v = 0; v < g.nodeCount(); v++) mismatches += tree.distance(v) != fresh.distance(v);
+
+    cout << "\n=== DYNAMIC SHORTEST PATHS BENCHMARK (" << g.nodeCount() << " nodes, " << g.arcCount() / 2 << " roads, "
+         << updates << " traffic updates) ===\n";
+    cout << fixed << setprecision(4);
+    cout << "Full Dijkstra tree: " << buildMs << " ms\n";
+    cout << "Road slower: " << worseMs / max(1, worse) << " ms avg, " << static_cast<double>(worseTouched) / max(1, worse)
+         << " nodes re-settled\n";
+    cout << "Road faster: " << betterMs / max(1, better) << " ms avg, " << static_cast<double>(betterTouched) / max(1, better)
+         << " nodes re-settled\n";
+    cout << "Speedup vs recomputing per update: " << rebuildMs * updates / max(1e-9, worseMs + betterMs) << "x; "
+         << "distances after all updates " << (mismatches == 0 ? "match" : to_string(mismatches) + " MISMATCHES") << "\n";
+}
+
+void benchmarkTraversal(int n) {
+    n = max(1000, n);
+    DataStructures::CSRGraph road = generateRoadNetwork(n, 42).build();
+    // Low-diameter network (random shortcuts, average degree ~8) where bottom-up steps pay off
+    mt19937 gen(n);
+    DataStructures::CSRGraphBuilder sb(n);
+    sb.reserve(static_cast<size_t>(n) * 8);
+    for (int k = 0; k < n * 4; k++) sb.addEdge(gen() % n, gen() % n, 1);
+    DataStructures::CSRGraph smallWorld = sb.build();
+
+    cout << "\n=== TRAVERSAL BENCHMARK (" << n << " nodes, " << parallelWorkerCount(n) << " worker(s)) ===\n";
+    cout << fixed << setprecision(2);
+    for (int pass = 0; pass < 2; pass++) {
+        const DataStructures::CSRGraph& g = pass == 0 ? road : smallWorld;
+        cout << (pass == 0 ? "Road grid" : "Small world") << ": " << g.arcCount() << " arcs\n";
+        auto start = BenchClock::now();
+        size_t queueReached = csrBfsOrder(g, 0).size();
+        double queueMs = elapsedMs(start);
+
+        FrontierBFS bfs;
+        bfs.bind(g);
+        bfs.setDirectionOptimizing(false);
+        start = BenchClock::now();
+        bfs.run({0});
+        double topDownMs = elapsedMs(start);
+        long long topDownArcs = bfs.lastStats().arcsScanned;
+
+        vector<int> levels(g.nodeCount());
+        for (int v = 0; v < g.nodeCount(); v++) levels[v] = bfs.level(v);
+        bfs.reset();
+        bfs.setDirectionOptimizing(true);
+        start = BenchClock::now();
+        bfs.run({0});
+        double switchingMs = elapsedMs(start);
+        const FrontierBFS::Stats& s = bfs.lastStats();
+        int mismatches = 0;
+        for (int v = 0; v < g.nodeCount(); v++) mismatches += levels[v] != bfs.level(v);
+
+        start = BenchClock::now();
+        size_t dfsReached = csrDfsOrder(g, 0).size();
+        double dfsMs = elapsedMs(start);
+        start = BenchClock::now();
+        ComponentLabels comps = connectedComponents(g);
+        double compMs = elapsedMs(start);
+
+        cout << "  Queue BFS:            " << queueMs << " ms (" << queueReached << " reached)\n";
+        cout << "  Frontier BFS top-down: " << topDownMs << " ms, " << topDownArcs << " arcs scanned\n";
+        cout << "  Direction-optimizing: " << switchingMs << " ms, " << s.arcsScanned << " arcs scanned, " << s.levels
+             << " levels (" << s.topDownSteps << " top-down / " << s.bottomUpSteps << " bottom-up), levels "
+             << (mismatches == 0 ? "match" : to_string(mismatches) + " MISMATCHES") << "\n";
+        cout << "  Iterative DFS:        " << dfsMs << " ms (" << dfsReached << " reached)\n";
+        cout << "  Connected components: " << compMs << " ms, " << comps.size.size() << " component(s)\n";
+    }
+}
+
+void benchmarkSpanningTrees(int n) {
+    n = max(1000, n);
+    const int DENSE_PRIM_LIMIT = 5000; // O(V²) array Prim needs the full matrix
+    cout << "\n=== MINIMUM SPANNING TREE BENCHMARK (" << parallelWorkerCount(n) << " worker(s)) ===\n";
+    cout << fixed << setprecision(2);
+    for (int pass = 0; pass < 2; pass++) {
+        DataStructures::CSRGraph g;
+        if (pass == 0) {
+            g = generateRoadNetwork(n, 42).build();
+        } else {
+            // Dense: every pair of a smaller location set connected
+            int m = min(n, 2000);
+            mt19937 gen(m);
+            DataStructures::CSRGraphBuilder b(m);
+            b.reserve(static_cast<size_t>(m) * (m - 1));
+            for (int u = 0; u < m; u++)
+                for (int v = u + 1; v < m; v++) b.addEdge(u, v, 1 + gen() % 1000);
+            g = b.build();
+        }
+        int nodes = g.nodeCount();
+        cout << (pass == 0 ? "Sparse road network: " : "Dense network: ") << nodes << " nodes, " << g.arcCount() / 2 << " roads\n";
+
+        auto report = [&](const string& name, const SpanningForest& f, double ms) {
+            cout << "  " << left << setw(22) << name << right << setw(10) << ms << " ms   cost " << f.totalCost
+                 << ", " << f.components << " component(s)\n";
+        };
+        long long reference = -1;
+        bool agree = true;
+        auto check = [&](const SpanningForest& f) {
+            if (reference < 0) reference = f.totalCost;
+            agree = agree && f.totalCost == reference;
+        };
+
+        if (nodes <= DENSE_PRIM_LIMIT) {
+            vector<int> matrix(static_cast<size_t>(nodes) * nodes, 0);
+            for (int u = 0; u < nodes; u++)
+                for (const auto* a = g.arcsBegin(u); a != g.arcsEnd(u); ++a) matrix[static_cast<size_t>(u) * nodes + a->to] = a->weight;
+            auto start = BenchClock::now();
+            SpanningForest f = densePrimMST(matrix.data(), nodes, nodes);
+            report("Prim (array, O(V^2))", f, elapsedMs(start));
+            check(f);
+        } else {
+            cout << "  Prim (array, O(V^2))  skipped: " << nodes << " nodes would need a " << nodes << "x" << nodes << " matrix\n";
+        }
+        auto start = BenchClock::now();
+        SpanningForest prim = csrPrimMST(g);
+        report("Prim (binary heap)", prim, elapsedMs(start));
+        check(prim);
+        start = BenchClock::now();
+        SpanningForest kruskal = csrKruskalMST(g);
+        report("Kruskal (radix+DSU)", kruskal, elapsedMs(start));
+        check(kruskal);
+        start = BenchClock::now();
+        SpanningForest boruvka = csrBoruvkaMST(g);
+        report("Boruvka (parallel)", boruvka, elapsedMs(start));
+        check(boruvka);
+        cout << "  Tree costs " << (agree ? "agree" : "DISAGREE") << "\n";
+    }
+}
+
+void benchmarkRouteCache(int n) {
+    n = max(1000, n);
+    DataStructures::CSRGraph g = generateRoadNetwork(n, 42).build();
+    ShortestPathEngine engine;
+    engine.bind(g);
+    // ETA traffic: restaurant -> 100 delivery zones, a few zones far more popular
+    mt19937 gen(n);
+    const int zones = 100, queries = 20000;
+    vector<int> zoneNode(zones);
+    for (int& z : zoneNode) z = gen() % g.nodeCount();
+    uniform_real_distribution<double> unit(0.0, 1.0);
+    vector<int> stream(queries);
+    for (int& q : stream) q = zoneNode[static_cast<int>(zones * pow(unit(gen), 3.0)) % zones];
+
+    // Uncached run over the first `measured` queries of the stream (all of
+    // them on small maps; every query is a full search on large ones)
+    const int measured = min(queries, max(50, 20000000 / g.nodeCount()));
+    vector<int> expected(measured);
+    auto start = BenchClock::now();
+    for (int i = 0; i < measured; i++) expected[i] = engine.run(0, stream[i]);
+    double uncachedMs = elapsedMs(start);
+
+    RouteCache cache(ROUTE_CACHE_CAPACITY);
+    int version = 0, mismatches = 0;
+    vector<int> got(measured);
+    double cachedPrefixMs = 0;
+    start = BenchClock::now();
+    for (int i = 0; i < queries; i++) {
+        int d = cache.distance(0, stream[i], version, [&]() { return engine.run(0, stream[i]); });
+        if (i < measured) got[i] = d;
+        if (i == measured - 1) cachedPrefixMs = elapsedMs(start);
+    }
+    double cachedMs = elapsedMs(start);
+    for (int i = 0; i < measured; i++) mismatches += got[i] != expected[i];
+    RouteCache::Stats before = cache.lastStats();
+
+    // A road update bumps the version: old entries are refused one by one
+    version++;
+    for (int i = 0; i < queries / 20; i++)
+        cache.distance(0, stream[i], version, [&]() { return engine.run(0, stream[i]); });
+    RouteCache::Stats after = cache.lastStats();
+
+    cout << "\n=== ROUTE CACHE BENCHMARK (" << g.nodeCount() << " nodes, " << queries << " ETA queries over " << zones
+         << " zones) ===\n";
+    cout << fixed << setprecision(2);
+    cout << "First " << measured << " queries: uncached " << uncachedMs << " ms (" << uncachedMs / measured
+         << " ms per search), cached " << cachedPrefixMs << " ms\n";
+    cout << "All " << queries << " queries cached: " << cachedMs << " ms, hit rate " << 100.0 * before.hits / max(1LL, before.lookups)
+         << "%, searches saved " << before.hits << " (~" << cache.savedMs() << " ms)\n";
+    cout << "After a road update: " << after.stale - before.stale << " stale entries rejected in " << queries / 20 << " queries\n";
+    cout << "Cached distances " << (mismatches == 0 ? "match" : to_string(mismatches) + " MISMATCHES") << " (" << measured
+         << " checked against the uncached run)\n";
+}
+
+void benchmarkSpatialIndex(int n) {
+    n = max(1000, n);
+    mt19937 gen(n);
+    double side = sqrt(static_cast<double>(n));
+    uniform_real_distribution<double> coord(0.0, side);
+    vector<DataStructures::GeoPoint> points(n);
+    for (auto& p : points) p = {coord(gen), coord(gen)};
+    const int queries = 20000, k = 8, checked = 50;
+    vector<DataStructures::GeoPoint> probes(queries);
+    for (auto& q : probes) q = {coord(gen), coord(gen)};
+
+    cout << "\n=== SPATIAL INDEX BENCHMARK (" << n << " points, " << queries << " queries, k = " << k << ") ===\n";
+    cout << fixed << setprecision(3);
+    auto bruteForce = [&](const DataStructures::GeoPoint& q, const vector<DataStructures::GeoPoint>& pts) {
+        vector<double> d(pts.size());
+        for (size_t i = 0; i < pts.size(); i++) d[i] = squaredDistance(q, pts[i]);
+        nth_element(d.begin(), d.begin() + (k - 1), d.end());
+        return sqrt(d[k - 1]);
+    };
+
+    // Static k-d tree (road nodes)
+    DataStructures::KDTree tree;
+    auto start = BenchClock::now();
+    tree.build(points);
+    double buildMs = elapsedMs(start);
+    start = BenchClock::now();
+    long long found = 0;
+    for (const auto& q : probes) found += tree.nearest(q, k).size();
+    double knnUs = elapsedMs(start) * 1000.0 / queries;
+    start = BenchClock::now();
+    for (const auto& q : probes) found += tree.within(q, 2.0).size();
+    double radiusUs = elapsedMs(start) * 1000.0 / queries;
+    start = BenchClock::now();
+    int mismatches = 0;
+    for (int i = 0; i < checked; i++)
+        mismatches += fabs(tree.nearest(probes[i], k).back().second - bruteForce(probes[i], points)) > 1e-9;
+    double bruteUs = elapsedMs(start) * 1000.0 / checked;
+    cout << "k-d tree: build " << buildMs << " ms, kNN " << knnUs << " us, radius(2) " << radiusUs << " us, brute force "
+         << bruteUs << " us per query\n";
+
+    // Uniform grid (riders): full load, then a feed where everyone moves a little
+    DataStructures::UniformGrid grid;
+    grid.reset(0, 0, side, side, max(1.0, side / 1024));
+    vector<DataStructures::UniformGrid::Update> feed(n);
+    for (int i = 0; i < n; i++) feed[i] = {i, points[i]};
+    start = BenchClock::now();
+    grid.apply(feed);
+    double loadMs = elapsedMs(start);
+    normal_distribution<double> step(0.0, 0.05);
+    for (int i = 0; i < n; i++) {
+        points[i] = {min(side, max(0.0, points[i].x + step(gen))), min(side, max(0.0, points[i].y + step(gen)))};
+        feed[i] = {i, points[i]};
+    }
+    start = BenchClock::now();
+    grid.apply(feed);
+    double moveMs = elapsedMs(start);
+    start = BenchClock::now();
+    for (const auto& q : probes) found += grid.nearest(q, k).size();
+    double gridKnnUs = elapsedMs(start) * 1000.0 / queries;
+    start = BenchClock::now();
+    for (const auto& q : probes) found += grid.within(q, 2.0).size();
+    double gridRadiusUs = elapsedMs(start) * 1000.0 / queries;
+    for (int i = 0; i < checked; i++)
+        mismatches += fabs(grid.nearest(probes[i], k).back().second - bruteForce(probes[i], points)) > 1e-9;
+    cout << "Uniform grid: load " << loadMs << " ms, " << n << " position updates " << moveMs << " ms ("
+         << moveMs * 1e6 / n << " ns each), kNN " << gridKnnUs << " us, radius(2) " << gridRadiusUs << " us\n";
+    cout << "kNN results " << (mismatches == 0 ? "match" : to_string(mismatches) + " MISMATCHES") << " brute force ("
+         << found << " hits total)\n";
+}
+
+void benchmarkIsochrones(int n) {
+    n = max(1000, n);
+    DataStructures::CSRGraph g = generateRoadNetwork(n, 42).build();
+    int side = max(1, static_cast<int>(sqrt(static_cast<double>(g.nodeCount()))));
+    // Restaurant in the middle plus two satellite kitchens; roads cost 10-100,
+    // so the radius spans roughly a fifth of the map
+    vector<int> kitchens = {(side / 2) * side + side / 2, (side / 4) * side + side / 4, (3 * side / 4) * side + 3 * side / 4};
+    for (int& k : kitchens) k = min(k, g.nodeCount() - 1);
+    int radius = side * 5;
+    vector<int> bands = {radius / 3, 2 * radius / 3, radius};
+
+    auto start = BenchClock::now();
+    DynamicShortestPaths full;
+    full.build(g, kitchens);
+    double fullMs = elapsedMs(start);
+    start = BenchClock::now();
+    IsochroneService zones;
+    zones.build(g, kitchens, bands);
+    double boundedMs = elapsedMs(start);
+    int inside = 0;
+    for (size_t b = 0; b < bands.size(); b++) inside += zones.zoneCount(static_cast<int>(b));
+
+    // Intake checks: random locations, one band lookup each
+    mt19937 gen(n);
+    const int checks = 1000000;
+    vector<int> probes(checks);
+    for (int& p : probes) p = gen() % g.nodeCount();
+    start = BenchClock::now();
+    int accepted = 0;
+    for (int p : probes) accepted += zones.deliverable(p);
+    double checkNs = elapsedMs(start) * 1e6 / checks;
+
+    // Traffic: roads near the kitchens slow down or speed up
+    const int updates = 2000;
+    double repairMs = 0;
+    long long touched = 0;
+    for (int k = 0; k < updates; k++) {
+        int c = kitchens[gen() % kitchens.size()];
+        int u = min(g.nodeCount() - 1, max(0, c + static_cast<int>(gen() % (2 * side + 1)) - side + (static_cast<int>(gen() % 41) - 20) * side));
+        if (g.degree(u) == 0) continue;
+        int v = g.arcsBegin(u)[gen() % g.degree(u)].to;
+        int old = g.arcWeight(u, v);
+        int w = gen() % 2 ? old * (3 + gen() % 4) / 2 : max(1, old * (50 + static_cast<int>(gen() % 50)) / 100);
+        g.setArcWeight(u, v, w);
+        g.setArcWeight(v, u, w);
+        start = BenchClock::now();
+        zones.arcChanged(g, u, v);
+        touched += zones.touchedLastUpdate();
+        zones.arcChanged(g, v, u);
+        touched += zones.touchedLastUpdate();
+        repairMs += elapsedMs(start);
+    }
+    IsochroneService fresh;
+    fresh.build(g, kitchens, bands);
+    int mismatches = 0;
+    for (int v = 0; v < g.nodeCount(); v++) mismatches += zones.bandOf(v) != fresh.bandOf(v) || zones.minutesTo(v) != fresh.minutesTo(v);
+
+    cout << "\n=== ISOCHRONE BENCHMARK (" << g.nodeCount() << " locations, " << kitchens.size() << " kitchens, radius " << radius
+         << ") ===\n";
+    cout << fixed << setprecision(3);
+    cout << "Full multi-source Dijkstra: " << fullMs << " ms; bounded to the radius: " << boundedMs << " ms (" << inside
+         << " locations inside)\n";
+    cout << "Intake check: " << checkNs << " ns per order (" << accepted << " of " << checks << " accepted)\n";
+    cout << "Traffic repair: " << repairMs / updates << " ms per road, " << static_cast<double>(touched) / updates
+         << " locations re-settled; zones after " << updates << " updates "
+         << (mismatches == 0 ? "match" : to_string(mismatches) + " MISMATCHES") << " a rebuild\n";
+}
+
+void benchmarkMenu() {
+    while (true) {
+        cout << "\n--- PERFORMANCE BENCHMARKS ---\n";
+        cout << "1. Autocomplete Trie\n";
+        cout << "2. Fuzzy Customer Search\n";
+        cout << "3. Full-Text Search (FM-Index)\n";
+        cout << "4. Streaming Leaderboards\n";
+        cout << "5. Loyalty Ledger Point-in-Time\n";
+        cout << "6. Delivery Graph (CSR)\n";
+        cout << "7. Shortest Paths (heap variants)\n";
+        cout << "8. Point-to-Point Routing (ALT A*)\n";
+        cout << "9. Contraction Hierarchies\n";
+        cout << "10. All-Pairs Distance Table\n";
+        cout << "11. TSP Tour Improvement (2-opt / Or-opt)\n";
+        cout << "12. Exact TSP (Held-Karp)\n";
+        cout << "13. Fleet Routing (VRP with time windows)\n";
+        cout << "14. Rider Assignment (Hungarian)\n";
+        cout << "15. Delivery Wave Batching (k-medoids)\n";
+        cout << "16. Road Network Loader (edge list / DIMACS)\n";
+        cout << "17. Traffic Updates (dynamic shortest paths)\n";
+        cout << "18. Graph Traversal (direction-optimizing BFS, components)\n";
+        cout << "19. Minimum Spanning Trees (Prim / Kruskal / Boruvka)\n";
+        cout << "20. Route Query Cache\n";
+        cout << "21. Spatial Index (k-d tree / rider grid)\n";
+        cout << "22. Delivery Zones (bounded multi-source isochrones)\n";
+        cout << "0. Back\n";
+        int ch = readInt("Choose: ", 0, 22);
+        if (ch == 0) return;
+        int n = readInt("Data size (e.g. 1000000): ", 1, 10000000);
+        if (ch == 1) benchmarkAutocomplete(n);
+        else if (ch == 2) benchmarkFuzzySearch(n);
+        else if (ch == 3) benchmarkFullTextSearch(n);
+        else if (ch == 4) benchmarkLeaderboards(n);
+        else if (ch == 5) benchmarkLoyaltyLedger(n);
+        else if (ch == 6) benchmarkDeliveryGraph(n);
+        else if (ch == 7) benchmarkShortestPaths(n);
+        else if (ch == 8) benchmarkLandmarkRouting(n);
+        else if (ch == 9) benchmarkContractionHierarchy(n);
+        else if (ch == 10) benchmarkAllPairs(n);
+        else if (ch == 11) benchmarkTourImprovement(n);
+        else if (ch == 12) benchmarkHeldKarp(n);
+        else if (ch == 13) benchmarkFleetRouting(n);
+        else if (ch == 14) benchmarkAssignment(n);
+        else if (ch == 15) benchmarkWaveBatching(n);
+        else if (ch == 16) benchmarkRoadLoader(n);
+        else if (ch == 17) benchmarkDynamicShortestPaths(n);
+        else if (ch == 18) benchmarkTraversal(n);
+        else if (ch == 19) benchmarkSpanningTrees(n);
+        else if (ch == 20) benchmarkRouteCache(n);
+        else if (ch == 21) benchmarkSpatialIndex(n);
+        else if (ch == 22) benchmarkIsochrones(n);
+    }
+}
+
 // =============================================================
 // COMPLETE SYSTEM DATA VIEW (READ-ONLY)
 // =============================================================
@@ -3715,7 +13468,7 @@ void displayAllCustomers() {
              << " | Phone: " << c.phone
              << " | Email: " << c.email
              << " | Points: " << c.loyaltyPoints
-             << " | Tier: " << c.membershipTier << "\n";
+             << " | Tier: " << Domain::tierToString(c.membershipTier) << "\n";
     }
 }
 
@@ -3788,12 +13541,24 @@ void displayAllInventory() {
 
 void displayReservationsAndWaitlist() {
     printSectionHeader("TABLE RESERVATIONS & WAITLIST");
+    if (reservationCount == 0) {
+        cout << "No reservations.\n";
+    } else {
+        cout << "Reservations:\n";
+        for (int i = 0; i < reservationCount; i++) {
+            const TableReservation& r = reservations[i];
+            cout << "  #" << r.reservationId << " | Table " << r.tableNumber << " | " << r.date << " " << r.time
+                 << " | " << r.customerName << " (customer " << r.customerId << ")"
+                 << " | Guests: " << r.guestCount << " | Status: " << r.status << "\n";
+        }
+    }
     if (waitlistCount == 0) {
         cout << "Waitlist empty.\n";
     } else {
         cout << "Waitlist entries:\n";
         for (int i = 0; i < waitlistCount; i++) {
             cout << "  Customer ID: " << waitlist[i].customerId
+                 << (waitlist[i].customerName.empty() ? "" : " (" + waitlist[i].customerName + ")")
                  << " | Party: " << waitlist[i].partySize
                  << " | Status: " << waitlist[i].status << "\n";
         }